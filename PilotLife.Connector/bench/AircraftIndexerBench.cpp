@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include "AircraftIndexer.h"
+#include "SyntheticPackageTree.h"
+
+// 600 packages / 4800 variations, generated once for every benchmark in this file
+static const SyntheticPackageTree& scanTree() {
+    static const auto tree = [] {
+        SyntheticTreeOptions options;
+        options.packages = 600;
+        options.variationsPerPackage = 8;
+        options.cfgPaddingBytes = 16 * 1024;
+        options.liveryEvery = 10;
+        return std::make_unique<SyntheticPackageTree>(options);
+    }();
+    return *tree;
+}
+
+// Full scan without a cache, with Arg(0) worker threads
+static void BM_ColdScan(benchmark::State& state) {
+    const auto& tree = scanTree();
+    for (auto _ : state) {
+        AircraftIndexer indexer;
+        indexer.setScanWorkerCount(static_cast<size_t>(state.range(0)));
+        indexer.initialize({ tree.communityPath() }, "");
+        benchmark::DoNotOptimize(indexer.getIndexedCount());
+    }
+}
+BENCHMARK(BM_ColdScan)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Start with every package unchanged since the cache was written
+static void BM_WarmStart(benchmark::State& state) {
+    const auto& tree = scanTree();
+    {
+        AircraftIndexer cold;
+        cold.setScanWorkerCount(1);
+        cold.initialize({ tree.communityPath() }, tree.cacheDirectory());
+    }
+    for (auto _ : state) {
+        AircraftIndexer indexer;
+        indexer.setScanWorkerCount(1);
+        indexer.initialize({ tree.communityPath() }, tree.cacheDirectory());
+        benchmark::DoNotOptimize(indexer.getIndexedCount());
+    }
+    auto cacheFile = std::filesystem::path(tree.cacheDirectory()) / "aircraft_index.bin";
+    state.counters["cache_mb"] = static_cast<double>(std::filesystem::file_size(cacheFile)) / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_WarmStart)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Indexed once for the lookup benchmarks
+static AircraftIndexer& lookupIndexer() {
+    static const auto indexer = [] {
+        auto result = std::make_unique<AircraftIndexer>();
+        result->initialize({ scanTree().communityPath() }, "");
+        return result;
+    }();
+    return *indexer;
+}
+
+// Slowest single lookup of the current run, across threads
+static std::atomic<int64_t> worstLookupNs{0};
+
+static void lookupLoop(benchmark::State& state) {
+    const AircraftIndexer& indexer = lookupIndexer();
+    std::vector<std::string> titles = scanTree().titles();
+    size_t next = static_cast<size_t>(state.thread_index()) * 97;
+    int64_t worst = 0;
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(indexer.findByTitle(titles[next++ % titles.size()]));
+        worst = std::max<int64_t>(worst, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    int64_t seen = worstLookupNs.load();
+    while (worst > seen && !worstLookupNs.compare_exchange_weak(seen, worst)) {
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// findByTitle from Threads() readers with nothing else going on
+static void BM_Lookup(benchmark::State& state) {
+    lookupIndexer();
+    if (state.thread_index() == 0) {
+        worstLookupNs = 0;
+    }
+    lookupLoop(state);
+    if (state.thread_index() == 0) {
+        state.counters["worst_us"] = static_cast<double>(worstLookupNs.load()) / 1000.0;
+    }
+}
+BENCHMARK(BM_Lookup)->Threads(1)->Threads(8)->UseRealTime();
+
+// Same, while a writer keeps refreshing one package after another and swapping snapshots
+static void BM_LookupDuringRefresh(benchmark::State& state) {
+    AircraftIndexer& indexer = lookupIndexer();
+    static std::atomic<bool> writing{false};
+    static std::thread writer;
+    if (state.thread_index() == 0) {
+        worstLookupNs = 0;
+        writing = true;
+        writer = std::thread([&indexer] {
+            const auto& tree = scanTree();
+            for (size_t package = 0; writing; package++) {
+                indexer.refreshPackages({ tree.packagePath(package % tree.options().packages).string() });
+            }
+        });
+    }
+    lookupLoop(state);
+    if (state.thread_index() == 0) {
+        writing = false;
+        writer.join();
+        state.counters["worst_us"] = static_cast<double>(worstLookupNs.load()) / 1000.0;
+    }
+}
+BENCHMARK(BM_LookupDuringRefresh)->Threads(1)->Threads(8)->UseRealTime();
+
+#ifdef __GLIBC__
+// Heap in use after indexing 100 packages x 60 liveries with ~40 KB aircraft.cfg files,
+// from a cold scan and from the cache it wrote
+static void BM_IndexMemory(benchmark::State& state) {
+    static const auto tree = [] {
+        SyntheticTreeOptions options;
+        options.packages = 100;
+        options.variationsPerPackage = 60;
+        options.cfgPaddingBytes = 40 * 1024;
+        return std::make_unique<SyntheticPackageTree>(options);
+    }();
+    bool warm = state.range(0) != 0;
+    if (warm) {
+        AircraftIndexer cold;
+        cold.initialize({ tree->communityPath() }, tree->cacheDirectory());
+    }
+
+    double heapMb = 0.0;
+    for (auto _ : state) {
+        malloc_trim(0);
+        size_t before = mallinfo2().uordblks;
+        AircraftIndexer indexer;
+        indexer.initialize({ tree->communityPath() }, warm ? tree->cacheDirectory() : "");
+        heapMb = static_cast<double>(mallinfo2().uordblks - before) / (1024.0 * 1024.0);
+    }
+    state.counters["heap_mb"] = heapMb;
+}
+BENCHMARK(BM_IndexMemory)->ArgName("warm")->Arg(0)->Arg(1)->Iterations(3)->Unit(benchmark::kMillisecond);
+#endif
+
+// 200 packages with CRLF files and ~21 KB aircraft.cfg files, as in the parser comparison
+static const SyntheticPackageTree& parseTree() {
+    static const auto tree = [] {
+        SyntheticTreeOptions options;
+        options.packages = 200;
+        options.variationsPerPackage = 8;
+        options.cfgPaddingBytes = 20 * 1024;
+        options.crlf = true;
+        return std::make_unique<SyntheticPackageTree>(options);
+    }();
+    return *tree;
+}
+
+static void BM_ParseAircraftCfg(benchmark::State& state) {
+    const auto& tree = parseTree();
+    size_t package = 0;
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        auto path = tree.cfgPath(package++ % tree.options().packages);
+        auto variations = AircraftIndexer::parseAllAircraftCfgVariations(path);
+        bytes += static_cast<int64_t>(variations.empty() ? 0 : variations[0].rawContent->size());
+        benchmark::DoNotOptimize(variations.data());
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ParseAircraftCfg);
+
+static void BM_ParseManifest(benchmark::State& state) {
+    const auto& tree = parseTree();
+    size_t package = 0;
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        auto manifest = AircraftIndexer::parseManifestJson(tree.packagePath(package++ % tree.options().packages) / "manifest.json");
+        bytes += static_cast<int64_t>(manifest.rawJson ? manifest.rawJson->size() : 0);
+        benchmark::DoNotOptimize(manifest.title.data());
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ParseManifest);
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "CommandRequest.h"
+#include "JsonReader.h"
+
+// Client requests of typical size, as the app sends them
+static const char* const REQUESTS[] = {
+    "{\"type\":\"getAircraftData\",\"requestId\":\"5f0c2a1e-8d4b-4c3a-9e57-2b1d6f8a9c01\",\"title\":\"Airbus A320 Neo FlyByWire House Livery\"}",
+    "{\"type\":\"subscribeTelemetry\",\"requestId\":\"5f0c2a1e-8d4b-4c3a-9e57-2b1d6f8a9c02\",\"groups\":[\"position\",\"speed\",\"heading\"],\"maxRateHz\":10}",
+    "{\"type\":\"getClientStats\",\"requestId\":\"5f0c2a1e-8d4b-4c3a-9e57-2b1d6f8a9c03\"}",
+};
+
+// Reading a request into its fields, as the command dispatcher does before any handler runs
+static void BM_ParseRequest(benchmark::State& state) {
+    std::string message = REQUESTS[state.range(0)];
+    CommandRequest request;
+    std::string error;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(request.parse(message, error));
+    }
+    state.SetLabel(std::to_string(message.size()) + " B");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * message.size()));
+}
+BENCHMARK(BM_ParseRequest)->Arg(0)->Arg(1)->Arg(2);
+
+// The reader alone, with a handler that ignores every event; mostly numbers, to cover the grammar checks
+static void BM_ReadNumbers(benchmark::State& state) {
+    std::string json = "[";
+    for (int i = 0; i < 1000; i++) {
+        json += (i ? "," : "") + std::to_string(i * 37 - 5000) + ".25e-3";
+    }
+    json += "]";
+    JsonReader::Handler ignore;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(JsonReader::parse(json, ignore));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+BENCHMARK(BM_ReadNumbers);
@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include "AllocationCounter.h"
+#include "FlightData.h"
+#include "JsonWriter.h"
+#include "SampleFlightData.h"
+
+// One telemetry tick: the full flightData message into a reused buffer
+static void BM_FlightDataMessage(benchmark::State& state) {
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+    FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+
+    uint64_t allocations = threadAllocationCount();
+    for (auto _ : state) {
+        FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.counters["allocs/tick"] = benchmark::Counter(
+        static_cast<double>(threadAllocationCount() - allocations), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+BENCHMARK(BM_FlightDataMessage);
+
+// String escaping, mostly plain text with a few quotes
+static void BM_AppendEscaped(benchmark::State& state) {
+    std::string text = "Airbus A320 Neo FlyByWire \"House\" Livery - C:\\Community\\flybywire-aircraft-a320-neo";
+    std::string buffer;
+    for (auto _ : state) {
+        buffer.clear();
+        JsonWriter::appendEscaped(buffer, text);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_AppendEscaped);
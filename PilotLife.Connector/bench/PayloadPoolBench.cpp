@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include "AllocationCounter.h"
+#include "FlightData.h"
+#include "PayloadPool.h"
+#include "SampleFlightData.h"
+
+using Payload = std::shared_ptr<const std::string>;
+
+// The old tick: serialize into a reused buffer, then copy it into a new shared payload
+static void BM_CopiedPayload(benchmark::State& state) {
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+    Payload latest;
+    uint64_t allocations = threadAllocationCount();
+    for (auto _ : state) {
+        FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+        latest = std::make_shared<const std::string>(buffer);
+        benchmark::DoNotOptimize(latest.get());
+    }
+    state.counters["allocs/tick"] = benchmark::Counter(
+        static_cast<double>(threadAllocationCount() - allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CopiedPayload);
+
+// Serialize straight into a pooled buffer; the previous frame is still held, as a
+// client queue would hold it until the next frame replaces it
+static void BM_PooledPayload(benchmark::State& state) {
+    SimConnectFlightData data = makeSampleFlightData();
+    PayloadPool pool;
+    Payload latest;
+    uint64_t allocations = threadAllocationCount();
+    for (auto _ : state) {
+        auto buffer = pool.acquire();
+        FlightDataEncoder::writeMessage(data, "MSFS2024", *buffer);
+        latest = std::move(buffer);
+        benchmark::DoNotOptimize(latest.get());
+    }
+    state.counters["allocs/tick"] = benchmark::Counter(
+        static_cast<double>(threadAllocationCount() - allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PooledPayload);
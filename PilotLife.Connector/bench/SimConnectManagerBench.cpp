@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include "SampleFlightData.h"
+#include "ScriptedSimMessageSource.h"
+#include "SimConnectManager.h"
+
+namespace {
+
+// A connected manager whose dispatch loop runs on a scripted source, with the
+// change-tracked blocks already received so every fast block publishes a sample
+struct ScriptedSession {
+    ScriptedSimMessageSource* source = nullptr;
+    SimConnectManager manager;
+    SimConnectFlightData sample = makeSampleFlightData();
+    std::atomic<uint64_t> samples{0};
+
+    ScriptedSession()
+        : manager([this](const std::string&) {
+            auto scripted = std::make_unique<ScriptedSimMessageSource>();
+            source = scripted.get();
+            return std::unique_ptr<SimMessageSource>(std::move(scripted));
+        })
+    {
+        manager.setFlightDataCallback([this](const SimConnectFlightData&, const std::string&) {
+            samples.fetch_add(1, std::memory_order_release);
+        });
+        manager.connect();
+        manager.startDispatchLoop();
+        source->pushBlock(REQUEST_AIRCRAFT_STATIC, sample);
+        source->pushBlock(REQUEST_AIRCRAFT_SLOW, sample);
+    }
+
+    ~ScriptedSession() {
+        manager.stopDispatchLoop();
+    }
+};
+
+} // namespace
+
+// Time from a fast block being queued to the flight data callback running on the
+// dispatch thread: one wake-up, one drain, one merge
+static void BM_WakeToCallback(benchmark::State& state) {
+    ScriptedSession session;
+    uint64_t published = 0;
+    for (auto _ : state) {
+        session.source->pushBlock(REQUEST_FLIGHT_FAST, session.sample);
+        published++;
+        while (session.samples.load(std::memory_order_acquire) < published) {
+            std::this_thread::yield();
+        }
+    }
+    state.counters["wakeups/sample"] = benchmark::Counter(
+        static_cast<double>(session.source->wakeups()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_WakeToCallback)->UseRealTime();
+
+// An idle connection for one second: how often the dispatch thread wakes up and
+// how much CPU the process burns while the sim sends nothing
+static void BM_IdleDispatch(benchmark::State& state) {
+    ScriptedSession session;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint64_t wakeups = session.source->wakeups() + session.source->timeouts();
+    std::clock_t cpuStart = std::clock();
+
+    for (auto _ : state) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    double seconds = static_cast<double>(state.iterations());
+    double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    state.counters["wakeups/s"] = static_cast<double>(
+        session.source->wakeups() + session.source->timeouts() - wakeups) / seconds;
+    state.counters["cpu_ms/s"] = cpuMs / seconds;
+}
+BENCHMARK(BM_IdleDispatch)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include "AllocationCounter.h"
+#include "SampleFlightData.h"
+#include "SpscRing.h"
+#include "TelemetryPublisher.h"
+
+// Uncontended push + pop of one raw frame
+static void BM_RingPushPop(benchmark::State& state) {
+    SpscRing<SimConnectFlightData> ring(64, OverflowPolicy::DropOldest);
+    SimConnectFlightData frame = makeSampleFlightData();
+    SimConnectFlightData out;
+    for (auto _ : state) {
+        ring.push(frame);
+        ring.pop(out);
+        benchmark::DoNotOptimize(out.bytes);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sizeof(frame)));
+}
+BENCHMARK(BM_RingPushPop);
+
+// What the dispatch thread pays per frame while the publisher thread drains
+// (and is periodically parked): the cost the sim side sees, with allocations
+static void BM_PublisherEnqueue(benchmark::State& state) {
+    auto policy = static_cast<OverflowPolicy>(state.range(0));
+    TelemetryPublisher publisher(64, policy);
+    publisher.setPublishCallback([](const SimConnectFlightData& data) {
+        benchmark::DoNotOptimize(data.bytes);
+    });
+    publisher.start();
+
+    SimConnectFlightData frame = makeSampleFlightData();
+    uint64_t allocations = threadAllocationCount();
+    for (auto _ : state) {
+        publisher.enqueue(frame);
+    }
+    state.counters["allocs/frame"] = benchmark::Counter(
+        static_cast<double>(threadAllocationCount() - allocations), benchmark::Counter::kAvgIterations);
+    publisher.stop();
+
+    RingStats stats = publisher.getStats();
+    state.counters["dropped"] = static_cast<double>(stats.dropped);
+    state.counters["maxDepth"] = static_cast<double>(stats.maxDepth);
+    state.SetLabel(TelemetryPublisher::getOverflowPolicyString(policy));
+}
+BENCHMARK(BM_PublisherEnqueue)
+    ->Arg(static_cast<int>(OverflowPolicy::DropOldest))
+    ->Arg(static_cast<int>(OverflowPolicy::CoalesceLatest));
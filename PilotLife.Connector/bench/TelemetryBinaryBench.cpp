@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "AllocationCounter.h"
+#include "FlightData.h"
+#include "SampleFlightData.h"
+#include "TelemetryBinary.h"
+
+// Binary frame encode, strings already interned (the steady state)
+static void BM_BinaryFrame(benchmark::State& state) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    std::string stringTable;
+    std::string frame;
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+
+    uint64_t allocations = threadAllocationCount();
+    for (auto _ : state) {
+        encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+        benchmark::DoNotOptimize(frame.data());
+    }
+    state.counters["bytes/frame"] = static_cast<double>(frame.size());
+    state.counters["allocs/frame"] = benchmark::Counter(
+        static_cast<double>(threadAllocationCount() - allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_BinaryFrame);
+
+// The JSON path for the same sample, for comparison
+static void BM_JsonFrame(benchmark::State& state) {
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+    FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+    for (auto _ : state) {
+        FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.counters["bytes/frame"] = static_cast<double>(buffer.size());
+}
+BENCHMARK(BM_JsonFrame);
+
+// Reference decoder on a steady frame
+static void BM_BinaryDecode(benchmark::State& state) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    TelemetryBinaryDecoder decoder;
+    std::string stringTable;
+    std::string frame;
+    DecodedFlightData decoded;
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+    decoder.decode(stringTable, decoded);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decoder.decode(frame, decoded));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+}
+BENCHMARK(BM_BinaryDecode);
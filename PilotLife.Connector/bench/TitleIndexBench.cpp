@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "AircraftIndexer.h"
+#include "SampleTitles.h"
+#include "TitleIndex.h"
+
+namespace {
+
+// Sample titles repeated to about 6000 entries, each looked up as a hit and as a miss
+struct LookupSet {
+    std::vector<std::string> titles;
+    std::vector<IndexedAircraft> records;
+    std::vector<std::string> queries;
+
+    LookupSet() {
+        SampleTitles sample = loadSampleTitles();
+        for (int copy = 0; copy < 3; copy++) {
+            for (const auto& title : sample.titles) {
+                titles.push_back(copy == 0 ? title : title + " Mk " + std::to_string(copy));
+            }
+        }
+        records.resize(titles.size());
+        for (const auto& title : titles) {
+            queries.push_back(title);
+            queries.push_back(title + " Custom");
+        }
+    }
+};
+
+const LookupSet& lookupSet() {
+    static const LookupSet set;
+    return set;
+}
+
+} // namespace
+
+// What the snapshot used before TitleIndex: normalize into a new string, then O(log N) compares
+static void BM_MapLookup(benchmark::State& state) {
+    const LookupSet& set = lookupSet();
+    std::map<std::string, const IndexedAircraft*> index;
+    for (size_t i = 0; i < set.titles.size(); i++) {
+        index[TitleIndex::normalize(set.titles[i])] = &set.records[i];
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        auto it = index.find(TitleIndex::normalize(set.queries[next++ % set.queries.size()]));
+        benchmark::DoNotOptimize(it == index.end() ? nullptr : it->second);
+    }
+    state.counters["titles"] = static_cast<double>(index.size());
+}
+BENCHMARK(BM_MapLookup);
+
+static void BM_TitleIndexLookup(benchmark::State& state) {
+    const LookupSet& set = lookupSet();
+    TitleIndex index;
+    for (size_t i = 0; i < set.titles.size(); i++) {
+        index.insert(TitleIndex::normalize(set.titles[i]), &set.records[i]);
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.find(set.queries[next++ % set.queries.size()]));
+    }
+    state.counters["titles"] = static_cast<double>(index.size());
+}
+BENCHMARK(BM_TitleIndexLookup);
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "SampleTitles.h"
+#include "TitleIndex.h"
+#include "TitleMatcher.h"
+
+// Approximate lookup of titles that are not indexed as such (one letter changed),
+// over the sample titles repeated Arg(0) times with a mark number appended
+static void BM_NearMiss(benchmark::State& state) {
+    SampleTitles sample = loadSampleTitles();
+    if (sample.titles.empty()) {
+        state.SkipWithError("aircraft.csv not found");
+        return;
+    }
+
+    TitleMatcher matcher;
+    for (int64_t copy = 0; copy < state.range(0); copy++) {
+        for (const auto& title : sample.titles) {
+            matcher.add(TitleIndex::normalize(copy == 0 ? title : title + " Mk " + std::to_string(copy)));
+        }
+    }
+
+    std::vector<std::string> queries;
+    for (const auto& title : sample.titles) {
+        std::string query = TitleIndex::normalize(title);
+        query[query.size() / 2] = query[query.size() / 2] == 'x' ? 'q' : 'x';
+        queries.push_back(query);
+    }
+
+    size_t next = 0;
+    int64_t worst = 0;
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(matcher.find(queries[next++ % queries.size()], 5, nullptr));
+        worst = std::max<int64_t>(worst, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    state.counters["titles"] = static_cast<double>(matcher.size());
+    state.counters["worst_us"] = static_cast<double>(worst) / 1000.0;
+}
+BENCHMARK(BM_NearMiss)->Arg(1)->Arg(3)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <IXNetSystem.h>
+#include <IXWebSocket.h>
+#include "FlightData.h"
+#include "SampleFlightData.h"
+#include "WebSocketServer.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr int LOOPBACK_PORT = 18765;
+
+// Peak resident set size of the process in MB (0 where not available)
+double peakResidentMb() {
+#ifndef _WIN32
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#else
+    return 0.0;
+#endif
+}
+
+template <typename Condition>
+bool waitUntil(Condition condition, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+} // namespace
+
+// One flightData frame published on the json channel and fanned out to N loopback
+// clients; each iteration waits until every client has received it
+static void BM_LoopbackFanOut(benchmark::State& state) {
+    const int clientCount = static_cast<int>(state.range(0));
+    ix::initNetSystem();
+
+    WebSocketServer server(LOOPBACK_PORT);
+    if (!server.start()) {
+        state.SkipWithError("Could not listen on the loopback port");
+        return;
+    }
+
+    std::atomic<uint64_t> received{0};
+    std::vector<std::unique_ptr<ix::WebSocket>> clients;
+    for (int i = 0; i < clientCount; i++) {
+        auto client = std::make_unique<ix::WebSocket>();
+        client->setUrl("ws://127.0.0.1:" + std::to_string(LOOPBACK_PORT));
+        client->disableAutomaticReconnection();
+        client->setOnMessageCallback([&received](const ix::WebSocketMessagePtr& msg) {
+            if (msg->type == ix::WebSocketMessageType::Message) {
+                received.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        client->start();
+        clients.push_back(std::move(client));
+    }
+    if (!waitUntil([&] { return server.getClientCount() == static_cast<size_t>(clientCount); },
+                   std::chrono::seconds(10))) {
+        state.SkipWithError("Clients did not connect");
+        return;
+    }
+
+    std::string message;
+    FlightDataEncoder::writeMessage(makeSampleFlightData(), "MSFS2024", message);
+    WebSocketServer::Payload payload = WebSocketServer::makePayload(message);
+
+    double rssBefore = peakResidentMb();
+    uint64_t expected = received.load();
+    for (auto _ : state) {
+        server.publish(WebSocketServer::DEFAULT_TELEMETRY_CHANNEL, payload, DeliveryPolicy::LatestWins);
+        expected += clientCount;
+        if (!waitUntil([&] { return received.load(std::memory_order_relaxed) >= expected; },
+                       std::chrono::seconds(5))) {
+            state.SkipWithError("Frames were not delivered");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * clientCount));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * clientCount * message.size()));
+    state.counters["peak_rss_mb"] = peakResidentMb();
+    state.counters["rss_growth_mb"] = peakResidentMb() - rssBefore;
+
+    for (auto& client : clients) {
+        client->stop();
+    }
+    server.stop();
+}
+BENCHMARK(BM_LoopbackFanOut)->Arg(1)->Arg(8)->Arg(64)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,361 @@
+#include "AircraftIndexCache.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+
+static constexpr char CACHE_MAGIC[4] = { 'P', 'L', 'A', 'C' };
+
+// Little-endian writers (explicit byte order so the file does not depend on the host)
+static void appendU8(std::string& out, uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+static void appendU32(std::string& out, uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; i++) bytes[i] = static_cast<char>(value >> (8 * i));
+    out.append(bytes, 4);
+}
+
+static void appendU64(std::string& out, uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = static_cast<char>(value >> (8 * i));
+    out.append(bytes, 8);
+}
+
+static void appendString(std::string& out, const std::string& value) {
+    appendU32(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+static void appendStamp(std::string& out, const FileStamp& stamp) {
+    appendU64(out, static_cast<uint64_t>(stamp.modified));
+    appendU64(out, stamp.size);
+}
+
+// Little-endian reader over the cache file; every read fails once past the end
+class CacheReader {
+public:
+    explicit CacheReader(std::string_view data) : m_data(data) {}
+
+    bool readU8(uint8_t& value) { return read(value, 1); }
+    bool readU32(uint32_t& value) { return read(value, 4); }
+    bool readU64(uint64_t& value) { return read(value, 8); }
+
+    bool readString(std::string& value) {
+        uint32_t length;
+        if (!readU32(length) || m_data.size() - m_pos < length) return false;
+        value.assign(m_data.data() + m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+    bool readStamp(FileStamp& stamp) {
+        uint64_t modified;
+        if (!readU64(modified) || !readU64(stamp.size)) return false;
+        stamp.modified = static_cast<int64_t>(modified);
+        return true;
+    }
+
+    bool readBytes(size_t length, std::string_view& value) {
+        if (m_data.size() - m_pos < length) return false;
+        value = m_data.substr(m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+    // Counts come from the file; reject any that could not possibly fit in what is left
+    bool readCount(uint32_t& count) {
+        return readU32(count) && count <= m_data.size() - m_pos;
+    }
+
+    bool atEnd() const { return m_pos == m_data.size(); }
+
+private:
+    template <typename T>
+    bool read(T& value, size_t size) {
+        if (m_data.size() - m_pos < size) return false;
+        value = 0;
+        for (size_t i = 0; i < size; i++) {
+            value |= static_cast<T>(static_cast<unsigned char>(m_data[m_pos + i])) << (8 * i);
+        }
+        m_pos += size;
+        return true;
+    }
+
+    std::string_view m_data;
+    size_t m_pos = 0;
+};
+
+// Manifest and config string fields in file order (the raw file blobs follow them);
+// keep both lists in sync with the structs and bump CACHE_VERSION when they change
+static std::string AircraftManifest::* const MANIFEST_FIELDS[] = {
+    &AircraftManifest::packagePath, &AircraftManifest::contentType, &AircraftManifest::title,
+    &AircraftManifest::manufacturer, &AircraftManifest::creator, &AircraftManifest::packageVersion,
+    &AircraftManifest::minimumGameVersion, &AircraftManifest::totalPackageSize, &AircraftManifest::contentId,
+};
+
+static std::string AircraftConfig::* const CONFIG_FIELDS[] = {
+    &AircraftConfig::title, &AircraftConfig::model, &AircraftConfig::panel, &AircraftConfig::sound,
+    &AircraftConfig::texture, &AircraftConfig::atcType, &AircraftConfig::atcModel, &AircraftConfig::atcId,
+    &AircraftConfig::atcAirline, &AircraftConfig::uiManufacturer, &AircraftConfig::uiType,
+    &AircraftConfig::uiVariation, &AircraftConfig::icaoAirline, &AircraftConfig::generalAtcType,
+    &AircraftConfig::generalAtcModel, &AircraftConfig::editable, &AircraftConfig::performance,
+    &AircraftConfig::category, &AircraftConfig::baseContainer, &AircraftConfig::simObject,
+};
+
+static constexpr uint32_t NO_MANIFEST = UINT32_MAX;
+
+// Variations of one aircraft.cfg share its raw content and every aircraft in a package
+// shares the manifest, so each package stores its distinct strings once and the
+// records refer to them by index
+class PackageStrings {
+public:
+    uint32_t intern(const std::string& value) {
+        auto [it, inserted] = m_ids.emplace(value, static_cast<uint32_t>(m_strings.size()));
+        if (inserted) m_strings.push_back(&it->first);
+        return it->second;
+    }
+
+    // Blobs are shared in memory, so most repeats are found without hashing the contents
+    uint32_t internBlob(const FileBlob& blob) {
+        if (!blob) return intern(std::string());
+        auto it = m_blobIds.find(blob.get());
+        if (it != m_blobIds.end()) return it->second;
+        uint32_t id = intern(*blob);
+        m_blobIds.emplace(blob.get(), id);
+        return id;
+    }
+
+    void write(std::string& out) const {
+        appendU32(out, static_cast<uint32_t>(m_strings.size()));
+        for (const auto* value : m_strings) appendString(out, *value);
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> m_ids;
+    std::unordered_map<const std::string*, uint32_t> m_blobIds;
+    std::vector<const std::string*> m_strings;
+};
+
+// A package's string table as read back; a blob is created once per string and
+// shared by every record that refers to it
+class PackageStringTable {
+public:
+    bool read(CacheReader& reader) {
+        uint32_t count;
+        if (!reader.readCount(count)) return false;
+        m_strings.resize(count);
+        m_blobs.resize(count);
+        for (auto& value : m_strings) {
+            if (!reader.readString(value)) return false;
+        }
+        return true;
+    }
+
+    bool readString(CacheReader& reader, std::string& value) const {
+        uint32_t id;
+        if (!reader.readU32(id) || id >= m_strings.size()) return false;
+        value = m_strings[id];
+        return true;
+    }
+
+    bool readBlob(CacheReader& reader, FileBlob& blob) {
+        uint32_t id;
+        if (!reader.readU32(id) || id >= m_strings.size()) return false;
+        if (!m_blobs[id]) {
+            m_blobs[id] = std::make_shared<const std::string>(std::move(m_strings[id]));
+        }
+        blob = m_blobs[id];
+        return true;
+    }
+
+private:
+    std::vector<std::string> m_strings;
+    std::vector<FileBlob> m_blobs;
+};
+
+static void appendManifest(std::string& out, PackageStrings& strings, const AircraftManifest& manifest) {
+    for (auto field : MANIFEST_FIELDS) appendU32(out, strings.intern(manifest.*field));
+    appendU32(out, strings.internBlob(manifest.rawJson));
+}
+
+static void appendAircraft(std::string& out, PackageStrings& strings, uint32_t manifestId, const IndexedAircraft& aircraft) {
+    appendU32(out, manifestId);
+    for (auto field : CONFIG_FIELDS) appendU32(out, strings.intern(aircraft.config.*field));
+    appendU32(out, strings.internBlob(aircraft.config.rawContent));
+    appendU8(out, (aircraft.hasManifest ? 0x01 : 0) | (aircraft.hasConfig ? 0x02 : 0));
+}
+
+static bool readManifest(CacheReader& reader, PackageStringTable& strings, AircraftManifest& manifest) {
+    for (auto field : MANIFEST_FIELDS) {
+        if (!strings.readString(reader, manifest.*field)) return false;
+    }
+    return strings.readBlob(reader, manifest.rawJson);
+}
+
+static bool readAircraft(CacheReader& reader, PackageStringTable& strings,
+                         const std::vector<std::shared_ptr<const AircraftManifest>>& manifests, IndexedAircraft& aircraft) {
+    uint32_t manifestId;
+    if (!reader.readU32(manifestId)) return false;
+    if (manifestId != NO_MANIFEST) {
+        if (manifestId >= manifests.size()) return false;
+        aircraft.manifest = manifests[manifestId];
+    }
+    for (auto field : CONFIG_FIELDS) {
+        if (!strings.readString(reader, aircraft.config.*field)) return false;
+    }
+    if (!strings.readBlob(reader, aircraft.config.rawContent)) return false;
+    uint8_t flags;
+    if (!reader.readU8(flags)) return false;
+    aircraft.hasManifest = (flags & 0x01) != 0;
+    aircraft.hasConfig = (flags & 0x02) != 0;
+    return true;
+}
+
+static bool readPackage(CacheReader& reader, PackageScan& package) {
+    uint8_t isAircraft;
+    uint32_t cfgCount;
+    if (!reader.readString(package.packagePath) || !reader.readStamp(package.manifest) ||
+        !reader.readU8(isAircraft) || !reader.readCount(cfgCount)) {
+        return false;
+    }
+    package.isAircraft = isAircraft != 0;
+
+    package.cfgFiles.resize(cfgCount);
+    for (auto& [path, stamp] : package.cfgFiles) {
+        if (!reader.readString(path) || !reader.readStamp(stamp)) return false;
+    }
+
+    PackageStringTable strings;
+    if (!strings.read(reader)) return false;
+
+    uint32_t manifestCount;
+    if (!reader.readCount(manifestCount)) return false;
+    std::vector<std::shared_ptr<const AircraftManifest>> manifests;
+    manifests.reserve(manifestCount);
+    for (uint32_t i = 0; i < manifestCount; i++) {
+        auto manifest = std::make_shared<AircraftManifest>();
+        if (!readManifest(reader, strings, *manifest)) return false;
+        manifests.push_back(std::move(manifest));
+    }
+
+    uint32_t aircraftCount;
+    if (!reader.readCount(aircraftCount)) return false;
+    package.aircraft.resize(aircraftCount);
+    for (auto& aircraft : package.aircraft) {
+        if (!readAircraft(reader, strings, manifests, aircraft)) return false;
+    }
+    return true;
+}
+
+std::unordered_map<std::string, std::shared_ptr<const PackageScan>> AircraftIndexCache::load(const std::string& cachePath) {
+    std::unordered_map<std::string, std::shared_ptr<const PackageScan>> packages;
+
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file.is_open()) {
+        return packages;
+    }
+
+    // One read of the whole file; it is parsed in place
+    std::error_code ec;
+    auto fileSize = std::filesystem::file_size(cachePath, ec);
+    if (ec) {
+        return packages;
+    }
+    std::string content(static_cast<size_t>(fileSize), '\0');
+    if (!file.read(content.data(), static_cast<std::streamsize>(content.size()))) {
+        return packages;
+    }
+    file.close();
+
+    CacheReader reader(content);
+    std::string_view magic;
+    uint32_t version;
+    uint32_t packageCount;
+    if (!reader.readBytes(sizeof(CACHE_MAGIC), magic) || std::memcmp(magic.data(), CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        !reader.readU32(version) || version != CACHE_VERSION || !reader.readCount(packageCount)) {
+        std::cerr << "Ignoring aircraft index cache with unknown format: " << cachePath << std::endl;
+        return packages;
+    }
+
+    packages.reserve(packageCount);
+    for (uint32_t i = 0; i < packageCount; i++) {
+        auto package = std::make_shared<PackageScan>();
+        if (!readPackage(reader, *package)) {
+            std::cerr << "Ignoring truncated aircraft index cache: " << cachePath << std::endl;
+            packages.clear();
+            return packages;
+        }
+        std::string key = package->packagePath;
+        packages.emplace(std::move(key), std::move(package));
+    }
+
+    if (!reader.atEnd()) {
+        std::cerr << "Ignoring aircraft index cache with trailing data: " << cachePath << std::endl;
+        packages.clear();
+    }
+    return packages;
+}
+
+bool AircraftIndexCache::save(const std::string& cachePath, const std::vector<std::shared_ptr<const PackageScan>>& packages) {
+    std::string content;
+    content.append(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    appendU32(content, CACHE_VERSION);
+    appendU32(content, static_cast<uint32_t>(packages.size()));
+
+    for (const auto& packagePtr : packages) {
+        const PackageScan& package = *packagePtr;
+        appendString(content, package.packagePath);
+        appendStamp(content, package.manifest);
+        appendU8(content, package.isAircraft ? 1 : 0);
+        appendU32(content, static_cast<uint32_t>(package.cfgFiles.size()));
+        for (const auto& [path, stamp] : package.cfgFiles) {
+            appendString(content, path);
+            appendStamp(content, stamp);
+        }
+
+        // Records are built first so the string table they refer to can be written ahead of them
+        PackageStrings strings;
+        std::unordered_map<const AircraftManifest*, uint32_t> manifestIds;
+        std::string manifestRecords;
+        std::string aircraftRecords;
+        for (const auto& aircraft : package.aircraft) {
+            uint32_t manifestId = NO_MANIFEST;
+            if (aircraft.manifest) {
+                auto [it, inserted] = manifestIds.emplace(aircraft.manifest.get(), static_cast<uint32_t>(manifestIds.size()));
+                if (inserted) appendManifest(manifestRecords, strings, *aircraft.manifest);
+                manifestId = it->second;
+            }
+            appendAircraft(aircraftRecords, strings, manifestId, aircraft);
+        }
+        strings.write(content);
+        appendU32(content, static_cast<uint32_t>(manifestIds.size()));
+        content.append(manifestRecords);
+        appendU32(content, static_cast<uint32_t>(package.aircraft.size()));
+        content.append(aircraftRecords);
+    }
+
+    std::error_code ec;
+    std::filesystem::path target(cachePath);
+    std::filesystem::create_directories(target.parent_path(), ec);
+
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write(content.data(), static_cast<std::streamsize>(content.size()))) {
+            std::cerr << "Could not write aircraft index cache: " << temp.string() << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        std::cerr << "Could not replace aircraft index cache " << cachePath << ": " << ec.message() << std::endl;
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "AircraftIndexer.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Persists parsed packages between runs so a warm start only reparses packages
+// whose files changed.
+//
+// The cache is a little-endian binary file ("PLAC" + version) holding, for every
+// package, the modification time and size of its manifest.json and aircraft.cfg
+// files together with the aircraft parsed from them. Strings and manifests are
+// stored once per package and shared again in memory when read back. A package
+// is reused only if all of those stamps still match the files on disk; packages
+// that no longer exist are simply not written back. Any unreadable, truncated or
+// older-version file is treated as an empty cache.
+class AircraftIndexCache {
+public:
+    // Packages from the cache file keyed by package path; empty if the file is missing or invalid
+    static std::unordered_map<std::string, std::shared_ptr<const PackageScan>> load(const std::string& cachePath);
+
+    // Write all packages to the cache file (via a temp file, so a crash never leaves a partial cache)
+    static bool save(const std::string& cachePath, const std::vector<std::shared_ptr<const PackageScan>>& packages);
+
+private:
+    static constexpr uint32_t CACHE_VERSION = 3;
+};
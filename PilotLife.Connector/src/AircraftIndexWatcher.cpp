@@ -0,0 +1,110 @@
+#include "AircraftIndexWatcher.h"
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <vector>
+
+AircraftIndexWatcher::AircraftIndexWatcher(AircraftIndexer& indexer, std::unique_ptr<DirectoryWatcher> watcher,
+                                           std::chrono::milliseconds debounce)
+    : m_indexer(indexer)
+    , m_watcher(std::move(watcher))
+    , m_debounce(debounce)
+{
+}
+
+AircraftIndexWatcher::~AircraftIndexWatcher() {
+    stop();
+}
+
+bool AircraftIndexWatcher::start() {
+    if (m_running || !m_watcher) {
+        return false;
+    }
+
+    auto searchPaths = m_indexer.getSearchPaths();
+    if (searchPaths.empty() || !m_watcher->watch(searchPaths, WATCH_DEPTH)) {
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::thread(&AircraftIndexWatcher::watchLoop, this);
+    return true;
+}
+
+void AircraftIndexWatcher::stop() {
+    m_running = false;
+    if (m_watcher) {
+        m_watcher->wake();
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void AircraftIndexWatcher::watchLoop() {
+    // How long to sleep when nothing is pending; stop() wakes the watcher anyway
+    constexpr std::chrono::milliseconds IDLE_WAIT{1000};
+
+    std::vector<DirectoryChange> changes;
+    std::set<std::string> pendingPackages;
+    bool fullRescan = false;
+    auto quietSince = std::chrono::steady_clock::now();
+
+    while (m_running) {
+        bool pending = fullRescan || !pendingPackages.empty();
+        auto wait = IDLE_WAIT;
+        if (pending) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - quietSince);
+            wait = elapsed < m_debounce ? m_debounce - elapsed : std::chrono::milliseconds(0);
+        }
+
+        changes.clear();
+        if (m_watcher->waitForChanges(wait, changes)) {
+            for (const auto& change : changes) {
+                if (change.relativePath.empty()) {
+                    // Notifications were lost; only a full check can tell what changed
+                    fullRescan = true;
+                    continue;
+                }
+                std::string package = packageForChange(change);
+                if (!package.empty()) {
+                    pendingPackages.insert(package);
+                }
+            }
+            quietSince = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        if (!m_running || !pending || std::chrono::steady_clock::now() - quietSince < m_debounce) {
+            continue;
+        }
+
+        AircraftIndexDelta delta;
+        if (fullRescan) {
+            std::cout << "Aircraft folders changed, re-checking all packages" << std::endl;
+            delta = m_indexer.rescan();
+        } else {
+            std::cout << "Aircraft folders changed, re-indexing " << pendingPackages.size() << " package(s)" << std::endl;
+            delta = m_indexer.refreshPackages(std::vector<std::string>(pendingPackages.begin(), pendingPackages.end()));
+        }
+        fullRescan = false;
+        pendingPackages.clear();
+
+        if (!delta.empty()) {
+            std::cout << "Aircraft index updated: " << delta.added.size() << " added, "
+                      << delta.removed.size() << " removed, " << delta.updated.size() << " updated" << std::endl;
+            if (m_updateCallback) {
+                m_updateCallback(delta);
+            }
+        }
+    }
+}
+
+std::string AircraftIndexWatcher::packageForChange(const DirectoryChange& change) {
+    std::filesystem::path relative(change.relativePath);
+    auto first = relative.begin();
+    if (first == relative.end()) {
+        return std::string();
+    }
+    return (std::filesystem::path(change.root) / *first).string();
+}
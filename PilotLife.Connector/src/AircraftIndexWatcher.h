@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include "AircraftIndexer.h"
+#include "DirectoryWatcher.h"
+
+// Keeps an AircraftIndexer current while the connector runs. A background
+// thread waits for filesystem changes in the search paths, maps each change to
+// the package directory it belongs to, and once the tree has been quiet for the
+// debounce interval re-indexes just those packages. Installers touch thousands
+// of files per package, so a burst becomes a single refresh.
+class AircraftIndexWatcher {
+public:
+    using UpdateCallback = std::function<void(const AircraftIndexDelta&)>;
+
+    AircraftIndexWatcher(AircraftIndexer& indexer, std::unique_ptr<DirectoryWatcher> watcher,
+                         std::chrono::milliseconds debounce);
+    ~AircraftIndexWatcher();
+
+    AircraftIndexWatcher(const AircraftIndexWatcher&) = delete;
+    AircraftIndexWatcher& operator=(const AircraftIndexWatcher&) = delete;
+
+    // Run on the watcher thread after each refresh that changed any title
+    void setUpdateCallback(UpdateCallback callback) { m_updateCallback = callback; }
+
+    // Watch the indexer's current search paths; returns false if none could be watched
+    bool start();
+    void stop();
+
+private:
+    // Directory levels below a search path that matter to the index:
+    // package/SimObjects/Airplanes/<aircraft>/aircraft.cfg
+    static constexpr int WATCH_DEPTH = 4;
+
+    void watchLoop();
+
+    // Package directory a change belongs to; empty if the change is not inside a package
+    static std::string packageForChange(const DirectoryChange& change);
+
+    AircraftIndexer& m_indexer;
+    std::unique_ptr<DirectoryWatcher> m_watcher;
+    std::chrono::milliseconds m_debounce;
+    UpdateCallback m_updateCallback;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+};
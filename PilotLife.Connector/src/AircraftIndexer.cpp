@@ -1,28 +1,69 @@
 #include "AircraftIndexer.h"
+#include "AircraftIndexCache.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "WorkStealing.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <windows.h>
 #include <shlobj.h>
+#endif
+
+// A user folder (CSIDL_APPDATA or CSIDL_LOCAL_APPDATA); empty if it cannot be found.
+// MSFS and the paths config only live there on Windows, so elsewhere nothing is found.
+static std::string getUserFolder(bool local) {
+#ifdef _WIN32
+    char path[MAX_PATH];
+    if (SUCCEEDED(SHGetFolderPathA(NULL, local ? CSIDL_LOCAL_APPDATA : CSIDL_APPDATA, NULL, 0, path))) {
+        return path;
+    }
+#else
+    (void)local;
+#endif
+    return std::string();
+}
 
 // Simple JSON parsing for manifest.json (avoiding external dependency for now)
 // We'll use basic string parsing since manifest.json is simple
 
 AircraftIndexer::AircraftIndexer() {
     // Set default config file path for aircraft paths
-    char appDataPath[MAX_PATH];
-    if (SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, appDataPath))) {
-        m_configFilePath = std::string(appDataPath) + "\\PilotLife\\aircraft_paths.json";
+    std::string appData = getUserFolder(false);
+    if (!appData.empty()) {
+        m_configFilePath = appData + "\\PilotLife\\aircraft_paths.json";
+    }
+    auto empty = std::make_shared<AircraftIndexSnapshot>();
+    empty->configFilePath = m_configFilePath;
+    std::atomic_store(&m_snapshot, std::shared_ptr<const AircraftIndexSnapshot>(std::move(empty)));
+}
+
+AircraftIndexer::~AircraftIndexer() {
+    {
+        std::lock_guard<std::mutex> lock(m_searchMutex);
+        m_searchStopping = true;
+    }
+    m_searchCondition.notify_all();
+    if (m_searchThread.joinable()) {
+        m_searchThread.join();
     }
 }
 
 bool AircraftIndexer::initialize() {
-    std::lock_guard<std::mutex> lock(m_indexMutex);
+    std::lock_guard<std::mutex> scanLock(m_scanMutex);
 
     m_searchPaths.clear();
-    m_packages.clear();
-    m_titleIndex.clear();
 
     // First try to load config file for custom paths
     loadConfigFile();
@@ -38,62 +79,216 @@ bool AircraftIndexer::initialize() {
 
     if (m_searchPaths.empty()) {
         std::cerr << "No MSFS paths found. Aircraft file data will not be available." << std::endl;
+        publishSnapshot(buildSnapshot({}));
         return false;
     }
 
-    // Scan all paths
-    for (const auto& basePath : m_searchPaths) {
-        std::cout << "Scanning: " << basePath << std::endl;
-        scanAircraftFolders(basePath);
-    }
+    return indexSearchPaths();
+}
+
+bool AircraftIndexer::initialize(const std::vector<std::string>& searchPaths, const std::string& cacheDirectory) {
+    std::lock_guard<std::mutex> scanLock(m_scanMutex);
+
+    m_searchPaths = searchPaths;
+    m_indexCacheDirectory = cacheDirectory;
+    return indexSearchPaths();
+}
+
+bool AircraftIndexer::indexSearchPaths() {
+    // Scan all paths, reusing packages from the on-disk cache where their files are unchanged
+    std::string cachePath = getIndexCachePath();
+    auto cached = cachePath.empty() ? std::unordered_map<std::string, std::shared_ptr<const PackageScan>>()
+                                    : AircraftIndexCache::load(cachePath);
+    auto packages = scanAircraftFolders(m_searchPaths, cached, nullptr);
 
     // Build the title index
-    buildTitleIndex();
+    auto snapshot = buildSnapshot(std::move(packages));
+    size_t aircraftCount = snapshot->titleIndex.size();
+    size_t packageCount = snapshot->packages.size();
+    publishSnapshot(std::move(snapshot));
 
-    std::cout << "Indexed " << m_titleIndex.size() << " aircraft variants from "
-              << m_packages.size() << " packages" << std::endl;
+    std::cout << "Indexed " << aircraftCount << " aircraft variants from "
+              << packageCount << " packages" << std::endl;
 
-    return !m_packages.empty();
+    return packageCount > 0;
 }
 
-void AircraftIndexer::rescan() {
-    initialize();
+AircraftIndexDelta AircraftIndexer::rescan() {
+    std::lock_guard<std::mutex> scanLock(m_scanMutex);
+
+    auto current = getSnapshot();
+    std::unordered_map<std::string, std::shared_ptr<const PackageScan>> known;
+    for (const auto& package : current->packages) {
+        known.emplace(package->packagePath, package);
+    }
+
+    auto packages = scanAircraftFolders(m_searchPaths, known, nullptr);
+    return publishSnapshot(buildSnapshot(std::move(packages)));
 }
 
-std::optional<IndexedAircraft> AircraftIndexer::findByTitle(const std::string& title) const {
-    std::lock_guard<std::mutex> lock(m_indexMutex);
+AircraftIndexDelta AircraftIndexer::refreshPackages(const std::vector<std::string>& packagePaths) {
+    std::lock_guard<std::mutex> scanLock(m_scanMutex);
 
-    std::string normalizedTitle = normalizeTitle(title);
+    auto current = getSnapshot();
+    std::unordered_map<std::string, std::shared_ptr<const PackageScan>> known;
+    for (const auto& package : current->packages) {
+        known.emplace(package->packagePath, package);
+    }
+
+    // Only the named packages are looked at; the package list itself is re-read so
+    // added and removed packages land in the same order a full scan would give
+    std::unordered_set<std::string> recheck(packagePaths.begin(), packagePaths.end());
+    auto packages = scanAircraftFolders(m_searchPaths, known, &recheck);
+    return publishSnapshot(buildSnapshot(std::move(packages)));
+}
+
+AircraftHandle AircraftIndexer::findByTitle(const std::string& title, const AircraftMatchHints& hints) const {
+    return lookup(title, hints, 1).aircraft;
+}
+
+AircraftLookup AircraftIndexer::lookup(const std::string& title, const AircraftMatchHints& hints, size_t maxCandidates) const {
+    // The snapshot stays valid for this lookup even if a scan publishes a new one meanwhile
+    auto snapshot = getSnapshot();
+
+    AircraftLookup result;
 
     // Try exact match first
-    auto it = m_titleIndex.find(normalizedTitle);
-    if (it != m_titleIndex.end()) {
+    if (const IndexedAircraft* aircraft = snapshot->titleIndex.find(title)) {
         std::cout << "Found exact match in index for: " << title << std::endl;
-        return it->second;
+        result.aircraft = AircraftHandle(snapshot, aircraft);
+        result.confidence = 1.0;
+        result.exact = true;
+        return result;
     }
 
-    // Try partial match if exact match fails
-    for (const auto& [key, aircraft] : m_titleIndex) {
-        if (key.find(normalizedTitle) != std::string::npos ||
-            normalizedTitle.find(key) != std::string::npos) {
-            std::cout << "Found partial match in index: " << key << std::endl;
-            return aircraft;
+    // Answers from earlier background searches, valid until the index changes
+    std::string normalizedTitle = normalizeTitle(title);
+    {
+        std::lock_guard<std::mutex> lock(m_searchMutex);
+        auto hit = m_diskHits.find(normalizedTitle);
+        if (hit != m_diskHits.end()) {
+            result.aircraft = hit->second;
+            result.confidence = 1.0;
+            result.exact = true;
+            return result;
         }
+        auto miss = m_missCache.find(normalizedTitle);
+        if (miss != m_missCache.end() && miss->second.expires > std::chrono::steady_clock::now()) {
+            std::cout << "Known miss, not searching again: " << title << std::endl;
+            return miss->second.lookup;
+        }
+    }
+
+    // Closest indexed titles; equal scores (e.g. liveries of one model) go to the
+    // variation whose ATC type/model agree with what the simulator reports
+    auto tieBreak = [&snapshot, &hints](uint32_t id) {
+        return countHintMatches(snapshot->titleIndex.aircraft(id)->config, hints);
+    };
+    for (const auto& match : snapshot->titleMatcher.find(title, maxCandidates, tieBreak)) {
+        result.candidates.push_back({ AircraftHandle(snapshot, snapshot->titleIndex.aircraft(match.id)),
+                                      std::string(snapshot->titleIndex.key(match.id)), match.score });
+    }
+    if (!result.candidates.empty() && result.candidates.front().confidence >= MIN_MATCH_CONFIDENCE) {
+        const auto& best = result.candidates.front();
+        std::cout << "Found closest match in index: " << best.title << " (confidence " << best.confidence << ")" << std::endl;
+        result.aircraft = best.aircraft;
+        result.confidence = best.confidence;
+        return result;
     }
 
-    // Fallback: do an on-demand search through all aircraft.cfg files
-    std::cout << "No match in index, trying fallback search..." << std::endl;
-    return searchForTitle(title);
+    std::cout << "No match in index for: " << title << std::endl;
+    return result;
+}
+
+void AircraftIndexer::searchInBackground(const std::string& title, AircraftLookup partial, SearchCallback done) {
+    std::string key = normalizeTitle(title);
+
+    std::lock_guard<std::mutex> lock(m_searchMutex);
+    if (m_searchStopping) {
+        return;
+    }
+    if (!m_searchThread.joinable()) {
+        m_searchThread = std::thread(&AircraftIndexer::searchLoop, this);
+    }
+
+    // Clients tend to ask for the loaded aircraft together; one search answers them all
+    auto [it, added] = m_pendingSearches.try_emplace(key);
+    if (added) {
+        it->second.title = title;
+        it->second.partial = std::move(partial);
+        m_searchQueue.push_back(key);
+        m_searchCondition.notify_one();
+    }
+    it->second.callbacks.push_back(std::move(done));
+}
+
+void AircraftIndexer::searchLoop() {
+    // Misses kept before expired ones are pruned
+    constexpr size_t MISS_CACHE_PRUNE_SIZE = 256;
+
+    std::unique_lock<std::mutex> lock(m_searchMutex);
+    while (true) {
+        m_searchCondition.wait(lock, [this] { return m_searchStopping || !m_searchQueue.empty(); });
+        if (m_searchStopping) {
+            return;
+        }
+
+        std::string key = std::move(m_searchQueue.front());
+        m_searchQueue.pop_front();
+        std::string title = m_pendingSearches[key].title;
+
+        lock.unlock();
+        AircraftIndexDelta delta;
+        AircraftLookup result = searchForTitle(title, delta);
+        lock.lock();
+
+        // Cut short by shutdown; not a miss, and nobody is left to answer
+        if (m_searchStopping) {
+            return;
+        }
+
+        PendingSearch search = std::move(m_pendingSearches[key]);
+        m_pendingSearches.erase(key);
+        if (!result.aircraft) {
+            result = std::move(search.partial);
+            result.knownMiss = true;
+
+            auto now = std::chrono::steady_clock::now();
+            if (m_missCache.size() >= MISS_CACHE_PRUNE_SIZE) {
+                for (auto it = m_missCache.begin(); it != m_missCache.end();) {
+                    it = it->second.expires <= now ? m_missCache.erase(it) : std::next(it);
+                }
+            }
+            m_missCache[key] = { now + m_missCacheTtl, result };
+        }
+
+        lock.unlock();
+        for (const auto& callback : search.callbacks) {
+            callback(result, delta);
+        }
+        lock.lock();
+    }
 }
 
 size_t AircraftIndexer::getIndexedCount() const {
-    std::lock_guard<std::mutex> lock(m_indexMutex);
-    return m_titleIndex.size();
+    return getSnapshot()->titleIndex.size();
+}
+
+std::shared_ptr<const AircraftIndexSnapshot> AircraftIndexer::getSnapshot() const {
+    return std::atomic_load(&m_snapshot);
 }
 
 std::vector<std::string> AircraftIndexer::getSearchPaths() const {
-    std::lock_guard<std::mutex> lock(m_indexMutex);
-    return m_searchPaths;
+    return getSnapshot()->searchPaths;
+}
+
+void AircraftIndexer::setScanWorkerCount(size_t count) {
+    m_scanWorkerCount = count;
+}
+
+void AircraftIndexer::setMissCacheTtl(std::chrono::steady_clock::duration ttl) {
+    std::lock_guard<std::mutex> lock(m_searchMutex);
+    m_missCacheTtl = ttl;
 }
 
 std::string AircraftIndexer::parseInstalledPackagesPath(const std::string& userCfgPath) {
@@ -120,12 +315,11 @@ std::string AircraftIndexer::parseInstalledPackagesPath(const std::string& userC
 std::vector<std::string> AircraftIndexer::detectMSFSInstallPaths() {
     std::vector<std::string> paths;
 
-    char appData[MAX_PATH];
-    char localAppData[MAX_PATH];
-
     // Get AppData and LocalAppData paths
-    bool hasAppData = SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, appData));
-    bool hasLocalAppData = SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_LOCAL_APPDATA, NULL, 0, localAppData));
+    std::string appData = getUserFolder(false);
+    std::string localAppData = getUserFolder(true);
+    bool hasAppData = !appData.empty();
+    bool hasLocalAppData = !localAppData.empty();
 
     // UserCfg.opt locations to check (in order of preference)
     std::vector<std::pair<std::string, std::string>> userCfgPaths;
@@ -133,12 +327,12 @@ std::vector<std::string> AircraftIndexer::detectMSFSInstallPaths() {
     if (hasAppData) {
         // MSFS 2024 Steam/Standard
         userCfgPaths.push_back({
-            std::string(appData) + "\\Microsoft Flight Simulator 2024\\UserCfg.opt",
+            appData + "\\Microsoft Flight Simulator 2024\\UserCfg.opt",
             "MSFS 2024 (Steam/Standard)"
         });
         // MSFS 2020 Steam/Standard
         userCfgPaths.push_back({
-            std::string(appData) + "\\Microsoft Flight Simulator\\UserCfg.opt",
+            appData + "\\Microsoft Flight Simulator\\UserCfg.opt",
             "MSFS 2020 (Steam/Standard)"
         });
     }
@@ -146,12 +340,12 @@ std::vector<std::string> AircraftIndexer::detectMSFSInstallPaths() {
     if (hasLocalAppData) {
         // MSFS 2024 MS Store
         userCfgPaths.push_back({
-            std::string(localAppData) + "\\Packages\\Microsoft.Limitless_8wekyb3d8bbwe\\LocalCache\\UserCfg.opt",
+            localAppData + "\\Packages\\Microsoft.Limitless_8wekyb3d8bbwe\\LocalCache\\UserCfg.opt",
             "MSFS 2024 (MS Store)"
         });
         // MSFS 2020 MS Store
         userCfgPaths.push_back({
-            std::string(localAppData) + "\\Packages\\Microsoft.FlightSimulator_8wekyb3d8bbwe\\LocalCache\\UserCfg.opt",
+            localAppData + "\\Packages\\Microsoft.FlightSimulator_8wekyb3d8bbwe\\LocalCache\\UserCfg.opt",
             "MSFS 2020 (MS Store)"
         });
     }
@@ -227,12 +421,12 @@ std::vector<std::string> AircraftIndexer::detectMSFSInstallPaths() {
 
 void AircraftIndexer::savePathsToConfig(const std::vector<std::string>& paths) {
     // Save to config file in AppData
-    char appData[MAX_PATH];
-    if (!SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, appData))) {
+    std::string appData = getUserFolder(false);
+    if (appData.empty()) {
         return;
     }
 
-    std::string configDir = std::string(appData) + "\\PilotLife";
+    std::string configDir = appData + "\\PilotLife";
     std::filesystem::create_directories(configDir);
 
     std::string configPath = configDir + "\\aircraft_paths.json";
@@ -265,12 +459,12 @@ void AircraftIndexer::savePathsToConfig(const std::vector<std::string>& paths) {
 }
 
 bool AircraftIndexer::loadPathsFromConfig() {
-    char appData[MAX_PATH];
-    if (!SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, appData))) {
+    std::string appData = getUserFolder(false);
+    if (appData.empty()) {
         return false;
     }
 
-    std::string configPath = std::string(appData) + "\\PilotLife\\aircraft_paths.json";
+    std::string configPath = appData + "\\PilotLife\\aircraft_paths.json";
     if (!std::filesystem::exists(configPath)) {
         return false;
     }
@@ -338,109 +532,283 @@ bool AircraftIndexer::loadConfigFile() {
     return loadPathsFromConfig();
 }
 
-void AircraftIndexer::scanAircraftFolders(const std::string& basePath) {
+std::vector<std::shared_ptr<const PackageScan>> AircraftIndexer::scanAircraftFolders(
+    const std::vector<std::string>& basePaths,
+    const std::unordered_map<std::string, std::shared_ptr<const PackageScan>>& known,
+    const std::unordered_set<std::string>* recheck) {
+    // Listing directories is cheap; reading and parsing the files is what runs in parallel
+    std::vector<std::filesystem::path> packageDirs;
+    for (const auto& basePath : basePaths) {
+        std::cout << "Scanning: " << basePath << std::endl;
+        collectPackageDirectories(basePath, packageDirs);
+    }
+
+    size_t workers = m_scanWorkerCount;
+    std::string cachePath = getIndexCachePath();
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> matched{0};
+    std::atomic<size_t> reused{0};
+
+    // Each task fills only its own slot; keeping the slots in package order makes
+    // the package list (and so the title index) identical to a serial scan
+    std::vector<std::shared_ptr<const PackageScan>> results(packageDirs.size());
+    parallelForEach(packageDirs.size(), workers, [&](size_t i) {
+        std::string packagePath = packageDirs[i].string();
+        auto it = known.find(packagePath);
+        if (it != known.end()) {
+            matched++;
+            bool trusted = recheck && recheck->count(packagePath) == 0;
+            if (trusted || isPackageUnchanged(*it->second, packageDirs[i])) {
+                results[i] = it->second;
+                reused++;
+                return;
+            }
+        }
+        results[i] = std::make_shared<const PackageScan>(scanPackage(packageDirs[i]));
+    });
+
+    size_t removed = known.size() - matched;
+
+    if (!cachePath.empty() && (reused != results.size() || removed > 0)) {
+        AircraftIndexCache::save(cachePath, results);
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "Scanned " << packageDirs.size() << " packages (" << reused << " unchanged, "
+              << (packageDirs.size() - reused) << " parsed, " << removed << " removed) with "
+              << std::min(workers, packageDirs.size()) << " threads in " << elapsed.count() << " ms" << std::endl;
+    return results;
+}
+
+void AircraftIndexer::collectPackageDirectories(const std::string& basePath, std::vector<std::filesystem::path>& packageDirs) {
     if (!std::filesystem::exists(basePath)) {
         return;
     }
 
     try {
         for (const auto& entry : std::filesystem::directory_iterator(basePath)) {
-            if (!entry.is_directory()) continue;
-
-            std::filesystem::path packagePath = entry.path();
-            std::filesystem::path manifestPath = packagePath / "manifest.json";
-
-            if (!std::filesystem::exists(manifestPath)) continue;
-
-            // Parse manifest.json first
-            AircraftManifest manifest = parseManifestJson(manifestPath);
-            manifest.packagePath = packagePath.string();
+            if (entry.is_directory()) {
+                packageDirs.push_back(entry.path());
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error scanning " << basePath << ": " << e.what() << std::endl;
+    }
+}
 
-            // Only process aircraft packages
-            if (manifest.contentType != "AIRCRAFT") continue;
+// ASCII case-insensitive comparison against a lowercase name
+static bool equalsLower(std::string_view text, std::string_view lowerName) {
+    if (text.size() != lowerName.size()) return false;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != lowerName[i]) return false;
+    }
+    return true;
+}
 
-            // Look for Aircraft.cfg in SimObjects/Airplanes subdirectories
-            std::filesystem::path simObjectsPath = packagePath / "SimObjects" / "Airplanes";
-            if (std::filesystem::exists(simObjectsPath)) {
-                for (const auto& aircraftDir : std::filesystem::directory_iterator(simObjectsPath)) {
-                    if (!aircraftDir.is_directory()) continue;
+// Manifest content_type (lowercase) of packages whose SimObjects are indexed. Livery
+// packages only add [FLTSIM.x] variations to an aircraft from another package.
+static const std::string_view AIRCRAFT_CONTENT_TYPES[] = { "aircraft", "livery" };
 
-                    std::filesystem::path cfgPath = aircraftDir.path() / "aircraft.cfg";
-                    if (std::filesystem::exists(cfgPath)) {
-                        // Parse ALL variations from this aircraft.cfg
-                        auto variations = parseAllAircraftCfgVariations(cfgPath);
+static bool isAircraftContent(std::string_view contentType) {
+    for (std::string_view type : AIRCRAFT_CONTENT_TYPES) {
+        if (equalsLower(contentType, type)) return true;
+    }
+    return false;
+}
 
-                        for (const auto& config : variations) {
-                            IndexedAircraft aircraft;
-                            aircraft.manifest = manifest;
-                            aircraft.hasManifest = !manifest.contentId.empty();
-                            aircraft.config = config;
-                            aircraft.hasConfig = !config.rawContent.empty();
+PackageScan AircraftIndexer::scanPackage(const std::filesystem::path& packagePath) {
+    PackageScan package;
+    package.packagePath = packagePath.string();
 
-                            if (aircraft.hasManifest || aircraft.hasConfig) {
-                                m_packages.push_back(aircraft);
-                            }
-                        }
-                    }
+    try {
+        std::filesystem::path manifestPath = packagePath / "manifest.json";
+        auto manifestStamp = FileStamp::of(manifestPath);
+        if (!manifestStamp) return package;
+        package.manifest = *manifestStamp;
+
+        // Parse manifest.json first; every variation in the package points at this one copy
+        auto manifest = std::make_shared<AircraftManifest>(parseManifestJson(manifestPath));
+        manifest->packagePath = package.packagePath;
+
+        // Only process aircraft and livery packages
+        if (!isAircraftContent(manifest->contentType)) return package;
+        package.isAircraft = true;
+
+        // Look for aircraft.cfg in every SimObjects category (Airplanes, Rotorcraft, ...)
+        package.cfgFiles = stampAircraftCfgs(packagePath);
+        for (const auto& [cfgPath, stamp] : package.cfgFiles) {
+            // Parse ALL variations from this aircraft.cfg
+            auto variations = parseAllAircraftCfgVariations(cfgPath);
+
+            for (auto& config : variations) {
+                IndexedAircraft aircraft;
+                aircraft.manifest = manifest;
+                aircraft.hasManifest = !manifest->contentId.empty();
+                aircraft.hasConfig = !fileText(config.rawContent).empty();
+                aircraft.config = std::move(config);
+
+                if (aircraft.hasManifest || aircraft.hasConfig) {
+                    package.aircraft.push_back(std::move(aircraft));
                 }
             }
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error scanning " << basePath << ": " << e.what() << std::endl;
+        std::cerr << "Error scanning " << package.packagePath << ": " << e.what() << std::endl;
     }
+
+    return package;
 }
 
-AircraftManifest AircraftIndexer::parseManifestJson(const std::filesystem::path& filePath) {
-    AircraftManifest manifest;
+std::vector<std::pair<std::string, FileStamp>> AircraftIndexer::stampAircraftCfgs(const std::filesystem::path& packagePath) {
+    std::vector<std::pair<std::string, FileStamp>> cfgFiles;
 
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        return manifest;
+    std::filesystem::path simObjectsPath = packagePath / "SimObjects";
+    std::error_code ec;
+    if (!std::filesystem::exists(simObjectsPath, ec)) return cfgFiles;
+
+    for (const auto& categoryDir : std::filesystem::directory_iterator(simObjectsPath)) {
+        if (!categoryDir.is_directory()) continue;
+
+        for (const auto& aircraftDir : std::filesystem::directory_iterator(categoryDir.path())) {
+            if (!aircraftDir.is_directory()) continue;
+
+            std::filesystem::path cfgPath = aircraftDir.path() / "aircraft.cfg";
+            if (auto stamp = FileStamp::of(cfgPath)) {
+                cfgFiles.emplace_back(cfgPath.string(), *stamp);
+            }
+        }
     }
+    return cfgFiles;
+}
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    manifest.rawJson = buffer.str();
-    file.close();
+bool AircraftIndexer::isPackageUnchanged(const PackageScan& cached, const std::filesystem::path& packagePath) {
+    try {
+        auto manifestStamp = FileStamp::of(packagePath / "manifest.json");
+        if (!manifestStamp || *manifestStamp != cached.manifest) return false;
 
-    // Simple JSON parsing - look for key-value pairs
-    auto extractValue = [&](const std::string& key) -> std::string {
-        std::string searchKey = "\"" + key + "\"";
-        size_t keyPos = manifest.rawJson.find(searchKey);
-        if (keyPos == std::string::npos) return "";
+        // Non-aircraft packages are decided by their manifest alone
+        if (!cached.isAircraft) return true;
 
-        size_t colonPos = manifest.rawJson.find(':', keyPos);
-        if (colonPos == std::string::npos) return "";
+        // Catches edited, added and removed aircraft.cfg files
+        return stampAircraftCfgs(packagePath) == cached.cfgFiles;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
 
-        // Skip whitespace
-        size_t valueStart = colonPos + 1;
-        while (valueStart < manifest.rawJson.length() &&
-               (manifest.rawJson[valueStart] == ' ' || manifest.rawJson[valueStart] == '\t' ||
-                manifest.rawJson[valueStart] == '\n' || manifest.rawJson[valueStart] == '\r')) {
-            valueStart++;
+std::string AircraftIndexer::getIndexCachePath() const {
+    if (m_indexCacheDirectory) {
+        if (m_indexCacheDirectory->empty()) {
+            return std::string();
         }
+        return (std::filesystem::path(*m_indexCacheDirectory) / "aircraft_index.bin").string();
+    }
+    if (m_configFilePath.empty()) {
+        return std::string();
+    }
+    return (std::filesystem::path(m_configFilePath).parent_path() / "aircraft_index.bin").string();
+}
 
-        if (valueStart >= manifest.rawJson.length()) return "";
+std::optional<FileStamp> FileStamp::of(const std::filesystem::path& filePath) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filePath, ec);
+    if (ec) return std::nullopt;
+    auto modified = std::filesystem::last_write_time(filePath, ec);
+    if (ec) return std::nullopt;
+
+    FileStamp stamp;
+    stamp.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+    stamp.size = static_cast<uint64_t>(size);
+    return stamp;
+}
 
-        if (manifest.rawJson[valueStart] == '"') {
-            // String value
-            size_t valueEnd = manifest.rawJson.find('"', valueStart + 1);
-            if (valueEnd != std::string::npos) {
-                return manifest.rawJson.substr(valueStart + 1, valueEnd - valueStart - 1);
+FileBlob AircraftIndexer::readFile(const std::filesystem::path& filePath) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filePath, ec);
+    if (ec) return nullptr;
+
+    // Text mode as before, so raw contents (and the cache) keep the same line endings
+    std::ifstream file(filePath);
+    if (!file.is_open()) return nullptr;
+
+    // One read into a buffer sized up front; text mode can only make it shorter
+    std::string content(static_cast<size_t>(size), '\0');
+    file.read(&content[0], static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<size_t>(file.gcount()));
+    return std::make_shared<const std::string>(std::move(content));
+}
+
+// manifest.json members kept in AircraftManifest (top level, string values)
+static const std::pair<std::string_view, std::string AircraftManifest::*> MANIFEST_KEYS[] = {
+    { "content_type", &AircraftManifest::contentType },
+    { "title", &AircraftManifest::title },
+    { "manufacturer", &AircraftManifest::manufacturer },
+    { "creator", &AircraftManifest::creator },
+    { "package_version", &AircraftManifest::packageVersion },
+    { "minimum_game_version", &AircraftManifest::minimumGameVersion },
+    { "total_package_size", &AircraftManifest::totalPackageSize },
+    { "content_id", &AircraftManifest::contentId },
+};
+
+// Fills an AircraftManifest in one pass over the document
+class ManifestHandler : public JsonReader::Handler {
+public:
+    explicit ManifestHandler(AircraftManifest& manifest) : m_manifest(manifest) {}
+
+    bool beginObject() override { m_depth++; m_field = nullptr; return true; }
+    bool endObject() override { m_depth--; return true; }
+    bool beginArray() override { m_depth++; m_field = nullptr; return true; }
+    bool endArray() override { m_depth--; return true; }
+
+    bool key(std::string_view name) override {
+        m_field = nullptr;
+        if (m_depth != 1) return true;
+        for (size_t i = 0; i < std::size(MANIFEST_KEYS); i++) {
+            // First occurrence wins, as with the find()-based parser this replaces
+            if (MANIFEST_KEYS[i].first == name && !(m_assigned & (1u << i))) {
+                m_field = MANIFEST_KEYS[i].second;
+                m_assigned |= 1u << i;
+                break;
             }
         }
-        return "";
-    };
+        return true;
+    }
 
-    manifest.contentType = extractValue("content_type");
-    manifest.title = extractValue("title");
-    manifest.manufacturer = extractValue("manufacturer");
-    manifest.creator = extractValue("creator");
-    manifest.packageVersion = extractValue("package_version");
-    manifest.minimumGameVersion = extractValue("minimum_game_version");
-    manifest.totalPackageSize = extractValue("total_package_size");
-    manifest.contentId = extractValue("content_id");
+    bool string(std::string_view value) override {
+        if (m_field) {
+            m_manifest.*m_field = std::string(value);
+            m_field = nullptr;
+        }
+        return true;
+    }
+
+    bool number(std::string_view) override { m_field = nullptr; return true; }
+    bool boolean(bool) override { m_field = nullptr; return true; }
+    bool null() override { m_field = nullptr; return true; }
+
+private:
+    AircraftManifest& m_manifest;
+    std::string AircraftManifest::* m_field = nullptr;  // Member the next string value goes to
+    unsigned m_assigned = 0;
+    int m_depth = 0;
+};
 
+AircraftManifest AircraftIndexer::parseManifestJson(const std::filesystem::path& filePath) {
+    AircraftManifest manifest;
+    manifest.rawJson = readFile(filePath);
+    if (!manifest.rawJson) {
+        return manifest;
+    }
+
+    // Members read before any syntax error are kept
+    ManifestHandler handler(manifest);
+    JsonReader::parse(*manifest.rawJson, handler);
     return manifest;
 }
 
@@ -452,224 +820,402 @@ AircraftConfig AircraftIndexer::parseAircraftCfg(const std::filesystem::path& fi
     return AircraftConfig();
 }
 
+// aircraft.cfg keys read from [FLTSIM.x] sections
+static const std::pair<std::string_view, std::string AircraftConfig::*> FLTSIM_KEYS[] = {
+    { "title", &AircraftConfig::title },
+    { "model", &AircraftConfig::model },
+    { "panel", &AircraftConfig::panel },
+    { "sound", &AircraftConfig::sound },
+    { "texture", &AircraftConfig::texture },
+    { "atc_type", &AircraftConfig::atcType },
+    { "atc_model", &AircraftConfig::atcModel },
+    { "atc_id", &AircraftConfig::atcId },
+    { "atc_airline", &AircraftConfig::atcAirline },
+    { "ui_manufacturer", &AircraftConfig::uiManufacturer },
+    { "ui_type", &AircraftConfig::uiType },
+    { "ui_variation", &AircraftConfig::uiVariation },
+    { "icao_airline", &AircraftConfig::icaoAirline },
+};
+
+// aircraft.cfg keys read from [GENERAL], copied into every variation
+static const std::pair<std::string_view, std::string AircraftConfig::*> GENERAL_KEYS[] = {
+    { "atc_type", &AircraftConfig::generalAtcType },
+    { "atc_model", &AircraftConfig::generalAtcModel },
+    { "editable", &AircraftConfig::editable },
+    { "performance", &AircraftConfig::performance },
+    { "category", &AircraftConfig::category },
+};
+
 std::vector<AircraftConfig> AircraftIndexer::parseAllAircraftCfgVariations(const std::filesystem::path& filePath) {
     std::vector<AircraftConfig> variations;
 
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+    FileBlob rawContent = readFile(filePath);
+    if (!rawContent) {
         return variations;
     }
 
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string rawContent = buffer.str();
-    file.close();
+    // One forward pass over the file; keys, sections and values are views into it,
+    // and only the values that are kept get copied
+    std::string_view text = *rawContent;
+    std::string_view general[std::size(GENERAL_KEYS)];
+    std::string_view baseContainer;
+    AircraftConfig currentConfig;
+    bool inFltsimSection = false;
+    bool inGeneralSection = false;
+    bool inVariationSection = false;
 
-    std::istringstream stream(rawContent);
-    std::string line;
-    std::string currentSection;
+    // ".../SimObjects/<category>/<folder>/aircraft.cfg"
+    std::filesystem::path aircraftDir = filePath.parent_path();
+    std::string simObject = aircraftDir.parent_path().filename().string() + "/" + aircraftDir.filename().string();
 
-    // Store GENERAL section data to apply to all variations
-    std::string generalAtcType, generalAtcModel, generalEditable, generalPerformance, generalCategory;
+    auto finishVariation = [&]() {
+        if (!inFltsimSection || currentConfig.title.empty()) return;
+        currentConfig.rawContent = rawContent;
+        for (size_t i = 0; i < std::size(GENERAL_KEYS); i++) {
+            currentConfig.*GENERAL_KEYS[i].second = std::string(general[i]);
+        }
+        currentConfig.baseContainer = std::string(baseContainer);
+        currentConfig.simObject = simObject;
+        variations.push_back(std::move(currentConfig));
+        currentConfig = AircraftConfig();
+    };
 
-    // Current variation being parsed
-    AircraftConfig currentConfig;
-    bool inFltsimSection = false;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t lineEnd = text.find('\n', pos);
+        if (lineEnd == std::string_view::npos) lineEnd = text.size();
+        std::string_view line = text.substr(pos, lineEnd - pos);
+        pos = lineEnd + 1;
 
-    while (std::getline(stream, line)) {
         // Trim whitespace
         size_t start = line.find_first_not_of(" \t\r\n");
-        if (start == std::string::npos) continue;
-        line = line.substr(start);
+        if (start == std::string_view::npos) continue;
+        line.remove_prefix(start);
 
         // Skip comments
         if (line[0] == ';' || line[0] == '#') continue;
 
-        // Check for section header
+        // Section header: the previous [FLTSIM.x] is complete
         if (line[0] == '[') {
-            // If we were in a FLTSIM section, save the current config
-            if (inFltsimSection && !currentConfig.title.empty()) {
-                currentConfig.rawContent = rawContent;
-                currentConfig.generalAtcType = generalAtcType;
-                currentConfig.generalAtcModel = generalAtcModel;
-                currentConfig.editable = generalEditable;
-                currentConfig.performance = generalPerformance;
-                currentConfig.category = generalCategory;
-                variations.push_back(currentConfig);
-                currentConfig = AircraftConfig();
-            }
+            finishVariation();
 
             size_t end = line.find(']');
-            if (end != std::string::npos) {
-                currentSection = line.substr(1, end - 1);
-                // Normalize section name
-                std::transform(currentSection.begin(), currentSection.end(),
-                              currentSection.begin(), ::toupper);
-
-                // Check if this is a FLTSIM.x section
-                inFltsimSection = (currentSection.find("FLTSIM.") == 0);
+            if (end != std::string_view::npos) {
+                std::string_view section = line.substr(1, end - 1);
+                inFltsimSection = section.size() >= 7 && equalsLower(section.substr(0, 7), "fltsim.");
+                inGeneralSection = equalsLower(section, "general");
+                inVariationSection = equalsLower(section, "variation");
             }
             continue;
         }
 
         // Parse key=value
         size_t eqPos = line.find('=');
-        if (eqPos == std::string::npos) continue;
-
-        std::string key = line.substr(0, eqPos);
-        std::string value = line.substr(eqPos + 1);
+        if (eqPos == std::string_view::npos) continue;
 
-        // Trim key
+        std::string_view key = line.substr(0, eqPos);
         size_t keyEnd = key.find_last_not_of(" \t");
-        if (keyEnd != std::string::npos) {
+        if (keyEnd != std::string_view::npos) {
             key = key.substr(0, keyEnd + 1);
         }
 
-        // Normalize key
-        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
-
-        // Parse value (remove quotes and comments)
-        value = parseConfigValue(value);
-
         if (inFltsimSection) {
-            if (key == "title") currentConfig.title = value;
-            else if (key == "model") currentConfig.model = value;
-            else if (key == "panel") currentConfig.panel = value;
-            else if (key == "sound") currentConfig.sound = value;
-            else if (key == "texture") currentConfig.texture = value;
-            else if (key == "atc_type") currentConfig.atcType = value;
-            else if (key == "atc_model") currentConfig.atcModel = value;
-            else if (key == "atc_id") currentConfig.atcId = value;
-            else if (key == "atc_airline") currentConfig.atcAirline = value;
-            else if (key == "ui_manufacturer") currentConfig.uiManufacturer = value;
-            else if (key == "ui_type") currentConfig.uiType = value;
-            else if (key == "ui_variation") currentConfig.uiVariation = value;
-            else if (key == "icao_airline") currentConfig.icaoAirline = value;
-        }
-        else if (currentSection == "GENERAL") {
-            if (key == "atc_type") generalAtcType = value;
-            else if (key == "atc_model") generalAtcModel = value;
-            else if (key == "editable") generalEditable = value;
-            else if (key == "performance") generalPerformance = value;
-            else if (key == "category") generalCategory = value;
+            for (const auto& [name, field] : FLTSIM_KEYS) {
+                if (equalsLower(key, name)) {
+                    currentConfig.*field = std::string(parseConfigValue(line.substr(eqPos + 1)));
+                    break;
+                }
+            }
+        } else if (inGeneralSection) {
+            for (size_t i = 0; i < std::size(GENERAL_KEYS); i++) {
+                if (equalsLower(key, GENERAL_KEYS[i].first)) {
+                    general[i] = parseConfigValue(line.substr(eqPos + 1));
+                    break;
+                }
+            }
+        } else if (inVariationSection && equalsLower(key, "base_container")) {
+            baseContainer = parseConfigValue(line.substr(eqPos + 1));
         }
     }
 
     // Don't forget the last variation
-    if (inFltsimSection && !currentConfig.title.empty()) {
-        currentConfig.rawContent = rawContent;
-        currentConfig.generalAtcType = generalAtcType;
-        currentConfig.generalAtcModel = generalAtcModel;
-        currentConfig.editable = generalEditable;
-        currentConfig.performance = generalPerformance;
-        currentConfig.category = generalCategory;
-        variations.push_back(currentConfig);
-    }
+    finishVariation();
 
     return variations;
 }
 
-void AircraftIndexer::buildTitleIndex() {
-    for (const auto& aircraft : m_packages) {
-        // Index by manifest title
-        if (!aircraft.manifest.title.empty()) {
-            m_titleIndex[normalizeTitle(aircraft.manifest.title)] = aircraft;
+std::shared_ptr<const AircraftIndexSnapshot> AircraftIndexer::buildSnapshot(std::vector<std::shared_ptr<const PackageScan>> packages) const {
+    auto snapshot = std::make_shared<AircraftIndexSnapshot>();
+    snapshot->packages = std::move(packages);
+    snapshot->searchPaths = m_searchPaths;
+    snapshot->configFilePath = m_configFilePath;
+    snapshot->userCfgOptPath = m_userCfgOptPath;
+
+    // What a base_container can name: the first variation of each SimObjects folder that is
+    // not a livery itself (the first package wins if several ship the same folder)
+    std::unordered_map<std::string, std::pair<const IndexedAircraft*, const PackageScan*>> bases;
+    for (const auto& package : snapshot->packages) {
+        for (const auto& aircraft : package->aircraft) {
+            if (aircraft.config.baseContainer.empty()) {
+                bases.emplace(simObjectKey(aircraft.config.simObject), std::make_pair(&aircraft, package.get()));
+            }
         }
+    }
 
-        // Also index by config title (often includes livery variation)
-        if (!aircraft.config.title.empty()) {
-            m_titleIndex[normalizeTitle(aircraft.config.title)] = aircraft;
+    for (const auto& package : snapshot->packages) {
+        for (const auto& aircraft : package->aircraft) {
+            // Liveries are indexed as their merged copy; one whose base is not installed stays as read
+            const IndexedAircraft* record = &aircraft;
+            if (!aircraft.config.baseContainer.empty()) {
+                auto base = bases.find(resolveBaseContainer(aircraft.config));
+                if (base != bases.end()) {
+                    snapshot->liveries.push_back({ mergeWithBase(aircraft, *base->second.first), base->second.second });
+                    record = &snapshot->liveries.back().aircraft;
+                }
+            }
+
+            // Index by manifest title
+            if (record->manifest && !record->manifest->title.empty()) {
+                snapshot->titleIndex.insert(normalizeTitle(record->manifest->title), record);
+            }
+
+            // Also index by config title (often includes livery variation)
+            if (!record->config.title.empty()) {
+                snapshot->titleIndex.insert(normalizeTitle(record->config.title), record);
+            }
         }
     }
 
-    std::cout << "Built title index with " << m_titleIndex.size() << " entries" << std::endl;
+    for (size_t id = 0; id < snapshot->titleIndex.size(); id++) {
+        snapshot->titleMatcher.add(snapshot->titleIndex.key(id));
+    }
+
+    std::cout << "Built title index with " << snapshot->titleIndex.size() << " entries ("
+              << snapshot->liveries.size() << " liveries resolved to their base aircraft)" << std::endl;
+    return snapshot;
 }
 
-std::optional<IndexedAircraft> AircraftIndexer::searchForTitle(const std::string& title) const {
-    std::cout << "Performing fallback search for: " << title << std::endl;
-    std::string normalizedSearch = normalizeTitle(title);
+std::string AircraftIndexer::resolveBaseContainer(const AircraftConfig& config) {
+    // Relative to the livery's own folder, usually "..\<folder>" in the same category
+    std::string relative = config.baseContainer;
+    std::replace(relative.begin(), relative.end(), '\\', '/');
+    while (!relative.empty() && relative.back() == '/') {
+        relative.pop_back();
+    }
 
-    // Search through all aircraft.cfg files in all search paths
-    for (const auto& basePath : m_searchPaths) {
-        if (!std::filesystem::exists(basePath)) continue;
+    std::filesystem::path target = (std::filesystem::path("SimObjects") / config.simObject / relative).lexically_normal();
+    return simObjectKey(target.parent_path().filename().string() + "/" + target.filename().string());
+}
 
-        try {
-            for (const auto& entry : std::filesystem::directory_iterator(basePath)) {
-                if (!entry.is_directory()) continue;
+std::string AircraftIndexer::simObjectKey(std::string_view simObject) {
+    std::string key(simObject);
+    for (char& ch : key) {
+        if (ch >= 'A' && ch <= 'Z') ch = static_cast<char>(ch - 'A' + 'a');
+    }
+    return key;
+}
 
-                std::filesystem::path packagePath = entry.path();
-                std::filesystem::path manifestPath = packagePath / "manifest.json";
+// Fields a livery inherits from its base aircraft when its own [FLTSIM.x] leaves them empty
+// (an empty model means the base's model). Title, texture and the registration and airline
+// fields identify the livery itself and are never taken from the base.
+static std::string AircraftConfig::* const INHERITED_FIELDS[] = {
+    &AircraftConfig::model, &AircraftConfig::panel, &AircraftConfig::sound,
+    &AircraftConfig::atcType, &AircraftConfig::atcModel, &AircraftConfig::uiManufacturer,
+    &AircraftConfig::uiType, &AircraftConfig::generalAtcType, &AircraftConfig::generalAtcModel,
+    &AircraftConfig::editable, &AircraftConfig::performance, &AircraftConfig::category,
+};
+
+IndexedAircraft AircraftIndexer::mergeWithBase(const IndexedAircraft& livery, const IndexedAircraft& base) {
+    // Not a plain copy: the livery's cached response does not describe the merged record
+    IndexedAircraft merged;
+    merged.manifest = livery.manifest;
+    merged.config = livery.config;
+    merged.hasManifest = livery.hasManifest;
+    merged.hasConfig = livery.hasConfig;
+
+    for (auto field : INHERITED_FIELDS) {
+        if ((merged.config.*field).empty()) {
+            merged.config.*field = base.config.*field;
+        }
+    }
+    return merged;
+}
 
-                // Look for Aircraft.cfg in SimObjects/Airplanes subdirectories
-                std::filesystem::path simObjectsPath = packagePath / "SimObjects" / "Airplanes";
-                if (!std::filesystem::exists(simObjectsPath)) continue;
+AircraftIndexDelta AircraftIndexer::publishSnapshot(std::shared_ptr<const AircraftIndexSnapshot> snapshot) {
+    auto previous = std::atomic_exchange(&m_snapshot, snapshot);
+    {
+        // Cached search answers only hold for the index they were made against
+        std::lock_guard<std::mutex> lock(m_searchMutex);
+        m_missCache.clear();
+        m_diskHits.clear();
+    }
 
-                for (const auto& aircraftDir : std::filesystem::directory_iterator(simObjectsPath)) {
-                    if (!aircraftDir.is_directory()) continue;
+    // Only packages that were reparsed, added or removed can change titles; unchanged
+    // packages are the same object in both snapshots
+    std::unordered_set<const PackageScan*> kept;
+    for (const auto& package : snapshot->packages) {
+        kept.insert(package.get());
+    }
 
-                    std::filesystem::path cfgPath = aircraftDir.path() / "aircraft.cfg";
-                    if (!std::filesystem::exists(cfgPath)) continue;
+    std::unordered_set<std::string> oldTitles;
+    for (const auto& package : previous->packages) {
+        if (kept.count(package.get())) continue;
+        for (const auto& aircraft : package->aircraft) {
+            oldTitles.insert(aircraft.config.title);
+        }
+    }
 
-                    // Parse all variations in this aircraft.cfg
-                    auto variations = const_cast<AircraftIndexer*>(this)->parseAllAircraftCfgVariations(cfgPath);
+    std::unordered_set<const PackageScan*> previousPackages;
+    for (const auto& package : previous->packages) {
+        previousPackages.insert(package.get());
+    }
 
-                    for (const auto& config : variations) {
-                        if (normalizeTitle(config.title) == normalizedSearch) {
-                            std::cout << "Found match in: " << cfgPath.string() << std::endl;
+    AircraftIndexDelta delta;
+    std::unordered_set<std::string> seen;
+    for (const auto& package : snapshot->packages) {
+        if (previousPackages.count(package.get())) continue;
+        for (const auto& aircraft : package->aircraft) {
+            const std::string& title = aircraft.config.title;
+            if (!seen.insert(title).second) continue;
+            if (oldTitles.erase(title)) {
+                delta.updated.push_back(title);
+            } else {
+                delta.added.push_back(title);
+            }
+        }
+    }
 
-                            // Build the IndexedAircraft result
-                            IndexedAircraft result;
-                            result.config = config;
-                            result.hasConfig = true;
+    // A livery in an unchanged package still changes when the base it was merged with was
+    // reparsed, appeared or went away; unchanged bases are the same package in both snapshots
+    std::unordered_map<std::string, const PackageScan*> oldBases;
+    for (const auto& livery : previous->liveries) {
+        oldBases.emplace(livery.aircraft.config.title, livery.basePackage);
+    }
+    for (const auto& livery : snapshot->liveries) {
+        const std::string& title = livery.aircraft.config.title;
+        auto old = oldBases.find(title);
+        bool sameBase = old != oldBases.end() && old->second == livery.basePackage;
+        if (old != oldBases.end()) oldBases.erase(old);
+        if (!sameBase && seen.insert(title).second) {
+            delta.updated.push_back(title);
+        }
+    }
+    for (const auto& [title, basePackage] : oldBases) {
+        // Titles of removed packages are reported as removed instead
+        if (!oldTitles.count(title) && seen.insert(title).second) {
+            delta.updated.push_back(title);
+        }
+    }
 
-                            // Try to get manifest if it exists
-                            if (std::filesystem::exists(manifestPath)) {
-                                result.manifest = const_cast<AircraftIndexer*>(this)->parseManifestJson(manifestPath);
-                                result.manifest.packagePath = packagePath.string();
-                                result.hasManifest = !result.manifest.contentId.empty();
-                            }
+    delta.removed.assign(oldTitles.begin(), oldTitles.end());
+    std::sort(delta.removed.begin(), delta.removed.end());
+    return delta;
+}
 
-                            return result;
+AircraftLookup AircraftIndexer::searchForTitle(const std::string& title, AircraftIndexDelta& delta) {
+    std::cout << "Searching aircraft folders for: " << title << std::endl;
+    AircraftLookup result;
+
+    // A scan may have indexed it since it was asked for
+    auto snapshot = getSnapshot();
+    const IndexedAircraft* indexed = snapshot->titleIndex.find(title);
+    AircraftHandle record;
+    if (!indexed) {
+        std::string packagePath;
+        record = searchPackages(normalizeTitle(title), *snapshot, packagePath);
+        if (!record) {
+            std::cout << "Fallback search found no matches" << std::endl;
+            return result;
+        }
+
+        // Usually a package installed since the last scan that has not been picked up yet
+        delta = refreshPackages({ packagePath });
+        snapshot = getSnapshot();
+        indexed = snapshot->titleIndex.find(title);
+    }
+
+    if (indexed) {
+        result.aircraft = AircraftHandle(snapshot, indexed);
+    } else {
+        // The index skips this package (not AIRCRAFT content); answer from the copy read here
+        std::lock_guard<std::mutex> lock(m_searchMutex);
+        m_diskHits[normalizeTitle(title)] = record;
+        result.aircraft = std::move(record);
+    }
+    result.confidence = 1.0;
+    result.exact = true;
+    return result;
+}
+
+AircraftHandle AircraftIndexer::searchPackages(const std::string& normalizedTitle, const AircraftIndexSnapshot& snapshot,
+                                               std::string& packagePath) const {
+    std::unordered_map<std::string, const PackageScan*> known;
+    for (const auto& package : snapshot.packages) {
+        known.emplace(package->packagePath, package.get());
+    }
+
+    for (const auto& basePath : snapshot.searchPaths) {
+        std::vector<std::filesystem::path> packageDirs;
+        collectPackageDirectories(basePath, packageDirs);
+
+        for (const auto& packageDir : packageDirs) {
+            if (m_searchStopping) return nullptr;
+
+            // Every title of an unchanged aircraft package is in the index already
+            auto it = known.find(packageDir.string());
+            if (it != known.end() && it->second->isAircraft && isPackageUnchanged(*it->second, packageDir)) continue;
+
+            try {
+                for (const auto& [cfgPath, stamp] : stampAircraftCfgs(packageDir)) {
+                    for (auto& config : parseAllAircraftCfgVariations(cfgPath)) {
+                        if (normalizeTitle(config.title) != normalizedTitle) continue;
+                        std::cout << "Found match in: " << cfgPath << std::endl;
+
+                        auto result = std::make_shared<IndexedAircraft>();
+                        result->config = std::move(config);
+                        result->hasConfig = true;
+
+                        // Try to get manifest if it exists
+                        std::filesystem::path manifestPath = packageDir / "manifest.json";
+                        if (std::filesystem::exists(manifestPath)) {
+                            auto manifest = std::make_shared<AircraftManifest>(parseManifestJson(manifestPath));
+                            manifest->packagePath = packageDir.string();
+                            result->hasManifest = !manifest->contentId.empty();
+                            result->manifest = std::move(manifest);
                         }
+
+                        packagePath = packageDir.string();
+                        return result;
                     }
                 }
+            } catch (const std::exception& e) {
+                std::cerr << "Error during fallback search in " << packageDir.string() << ": " << e.what() << std::endl;
             }
-        } catch (const std::exception& e) {
-            std::cerr << "Error during fallback search in " << basePath << ": " << e.what() << std::endl;
         }
     }
-
-    std::cout << "Fallback search found no matches" << std::endl;
-    return std::nullopt;
+    return nullptr;
 }
 
 std::string AircraftIndexer::normalizeTitle(const std::string& title) {
-    std::string normalized = title;
-    // Convert to lowercase
-    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::tolower);
-    // Remove extra whitespace
-    normalized.erase(std::unique(normalized.begin(), normalized.end(),
-        [](char a, char b) { return a == ' ' && b == ' '; }), normalized.end());
-    return normalized;
+    // Lowercase, runs of spaces collapsed; the title index applies the same rule to queries
+    return TitleIndex::normalize(title);
 }
 
-std::string AircraftIndexer::parseConfigValue(const std::string& line) {
-    std::string value = line;
-
+std::string_view AircraftIndexer::parseConfigValue(std::string_view value) {
     // Trim leading whitespace
     size_t start = value.find_first_not_of(" \t");
-    if (start == std::string::npos) return "";
-    value = value.substr(start);
+    if (start == std::string_view::npos) return std::string_view();
+    value.remove_prefix(start);
 
     // Remove inline comments (semicolon)
     size_t commentPos = value.find(';');
-    if (commentPos != std::string::npos) {
+    if (commentPos != std::string_view::npos) {
         value = value.substr(0, commentPos);
     }
 
     // Trim trailing whitespace
     size_t end = value.find_last_not_of(" \t\r\n");
-    if (end != std::string::npos) {
+    if (end != std::string_view::npos) {
         value = value.substr(0, end + 1);
     }
 
@@ -681,114 +1227,204 @@ std::string AircraftIndexer::parseConfigValue(const std::string& line) {
     return value;
 }
 
+// "match" member of an aircraftDataResponse: how the title was matched and the closest titles
+static void writeMatchInfo(JsonWriter& json, const AircraftLookup& lookup) {
+    json.key("match");
+    json.beginObject();
+    json.field("exact", lookup.exact);
+    json.field("confidence", lookup.confidence, 3);
+    json.key("candidates");
+    json.beginArray();
+    for (const auto& candidate : lookup.candidates) {
+        json.beginObject();
+        json.field("title", candidate.title);
+        json.field("confidence", candidate.confidence, 3);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
 std::string AircraftIndexer::toJsonResponse(const IndexedAircraft& aircraft, const std::string& requestId) {
-    auto escapeJson = [](const std::string& s) -> std::string {
-        std::string result;
-        result.reserve(s.length() * 2);
-        for (char c : s) {
-            switch (c) {
-                case '"': result += "\\\""; break;
-                case '\\': result += "\\\\"; break;
-                case '\n': result += "\\n"; break;
-                case '\r': result += "\\r"; break;
-                case '\t': result += "\\t"; break;
-                default: result += c;
-            }
-        }
-        return result;
+    return writeAircraftResponse(aircraft, requestId, nullptr);
+}
+
+std::string AircraftIndexer::toJsonResponse(const AircraftLookup& lookup, const std::string& requestId) {
+    if (lookup.aircraft) {
+        return writeAircraftResponse(*lookup.aircraft, requestId, &lookup);
+    }
+
+    // Not found, but the near misses can still help the client (or the user) pick one
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "aircraftDataResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.field("found", false);
+    json.endObject();
+    writeMatchInfo(json, lookup);
+    json.endObject();
+    return buffer;
+}
+
+std::string AircraftIndexer::writeAircraftResponse(const IndexedAircraft& aircraft, const std::string& requestId,
+                                                   const AircraftLookup* lookup) {
+    // Clients look up the same aircraft on every reconnect; serialize each record once.
+    // Two threads may race to fill the cache, in which case both results are identical.
+    auto data = std::atomic_load(&aircraft.responseData);
+    if (!data) {
+        data = std::make_shared<const std::string>(writeResponseData(aircraft));
+        std::atomic_store(&aircraft.responseData, data);
+    }
+
+    std::string buffer;
+    buffer.reserve(128 + requestId.size() + data->size());
+
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "aircraftDataResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.rawValue(*data);
+    if (lookup) {
+        // Per request, so kept out of the cached data object
+        writeMatchInfo(json, *lookup);
+    }
+    json.endObject();
+    return buffer;
+}
+
+int AircraftIndexer::countHintMatches(const AircraftConfig& config, const AircraftMatchHints& hints) {
+    auto same = [](const std::string& hint, const std::string& value) {
+        return !hint.empty() && hint.size() == value.size() &&
+               std::equal(hint.begin(), hint.end(), value.begin(), [](char a, char b) {
+                   return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+               });
     };
 
-    std::ostringstream json;
-    json << "{";
-    json << "\"type\":\"aircraftDataResponse\",";
-    json << "\"requestId\":\"" << escapeJson(requestId) << "\",";
-    json << "\"data\":{";
-    json << "\"found\":true,";
+    int matches = 0;
+    if (same(hints.atcType, config.atcType) || same(hints.atcType, config.generalAtcType)) matches++;
+    if (same(hints.atcModel, config.atcModel) || same(hints.atcModel, config.generalAtcModel)) matches++;
+    return matches;
+}
+
+std::string AircraftIndexer::writeResponseData(const IndexedAircraft& aircraft) {
+    static const AircraftManifest noManifest;
+    const AircraftManifest& manifest = aircraft.manifest ? *aircraft.manifest : noManifest;
+
+    std::string buffer;
+    // Raw file contents dominate the response size
+    buffer.reserve(1024 + fileText(manifest.rawJson).size() + fileText(aircraft.config.rawContent).size());
+
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("found", true);
 
     // Manifest data
-    json << "\"manifest\":{";
-    json << "\"contentType\":\"" << escapeJson(aircraft.manifest.contentType) << "\",";
-    json << "\"title\":\"" << escapeJson(aircraft.manifest.title) << "\",";
-    json << "\"manufacturer\":\"" << escapeJson(aircraft.manifest.manufacturer) << "\",";
-    json << "\"creator\":\"" << escapeJson(aircraft.manifest.creator) << "\",";
-    json << "\"packageVersion\":\"" << escapeJson(aircraft.manifest.packageVersion) << "\",";
-    json << "\"minimumGameVersion\":\"" << escapeJson(aircraft.manifest.minimumGameVersion) << "\",";
-    json << "\"totalPackageSize\":\"" << escapeJson(aircraft.manifest.totalPackageSize) << "\",";
-    json << "\"contentId\":\"" << escapeJson(aircraft.manifest.contentId) << "\",";
-    json << "\"raw\":\"" << escapeJson(aircraft.manifest.rawJson) << "\"";
-    json << "},";
+    json.key("manifest");
+    json.beginObject();
+    json.field("contentType", manifest.contentType);
+    json.field("title", manifest.title);
+    json.field("manufacturer", manifest.manufacturer);
+    json.field("creator", manifest.creator);
+    json.field("packageVersion", manifest.packageVersion);
+    json.field("minimumGameVersion", manifest.minimumGameVersion);
+    json.field("totalPackageSize", manifest.totalPackageSize);
+    json.field("contentId", manifest.contentId);
+    json.field("raw", fileText(manifest.rawJson));
+    json.endObject();
 
     // Config data
-    json << "\"config\":{";
-    json << "\"title\":\"" << escapeJson(aircraft.config.title) << "\",";
-    json << "\"model\":\"" << escapeJson(aircraft.config.model) << "\",";
-    json << "\"panel\":\"" << escapeJson(aircraft.config.panel) << "\",";
-    json << "\"sound\":\"" << escapeJson(aircraft.config.sound) << "\",";
-    json << "\"texture\":\"" << escapeJson(aircraft.config.texture) << "\",";
-    json << "\"atcType\":\"" << escapeJson(aircraft.config.atcType) << "\",";
-    json << "\"atcModel\":\"" << escapeJson(aircraft.config.atcModel) << "\",";
-    json << "\"atcId\":\"" << escapeJson(aircraft.config.atcId) << "\",";
-    json << "\"atcAirline\":\"" << escapeJson(aircraft.config.atcAirline) << "\",";
-    json << "\"uiManufacturer\":\"" << escapeJson(aircraft.config.uiManufacturer) << "\",";
-    json << "\"uiType\":\"" << escapeJson(aircraft.config.uiType) << "\",";
-    json << "\"uiVariation\":\"" << escapeJson(aircraft.config.uiVariation) << "\",";
-    json << "\"icaoAirline\":\"" << escapeJson(aircraft.config.icaoAirline) << "\",";
-    json << "\"generalAtcType\":\"" << escapeJson(aircraft.config.generalAtcType) << "\",";
-    json << "\"generalAtcModel\":\"" << escapeJson(aircraft.config.generalAtcModel) << "\",";
-    json << "\"editable\":\"" << escapeJson(aircraft.config.editable) << "\",";
-    json << "\"performance\":\"" << escapeJson(aircraft.config.performance) << "\",";
-    json << "\"category\":\"" << escapeJson(aircraft.config.category) << "\",";
-    json << "\"raw\":\"" << escapeJson(aircraft.config.rawContent) << "\"";
-    json << "}";
-
-    json << "}}";
-    return json.str();
+    json.key("config");
+    json.beginObject();
+    json.field("title", aircraft.config.title);
+    json.field("model", aircraft.config.model);
+    json.field("panel", aircraft.config.panel);
+    json.field("sound", aircraft.config.sound);
+    json.field("texture", aircraft.config.texture);
+    json.field("atcType", aircraft.config.atcType);
+    json.field("atcModel", aircraft.config.atcModel);
+    json.field("atcId", aircraft.config.atcId);
+    json.field("atcAirline", aircraft.config.atcAirline);
+    json.field("uiManufacturer", aircraft.config.uiManufacturer);
+    json.field("uiType", aircraft.config.uiType);
+    json.field("uiVariation", aircraft.config.uiVariation);
+    json.field("icaoAirline", aircraft.config.icaoAirline);
+    json.field("generalAtcType", aircraft.config.generalAtcType);
+    json.field("generalAtcModel", aircraft.config.generalAtcModel);
+    json.field("editable", aircraft.config.editable);
+    json.field("performance", aircraft.config.performance);
+    json.field("category", aircraft.config.category);
+    json.field("baseContainer", aircraft.config.baseContainer);
+    json.field("simObject", aircraft.config.simObject);
+    json.field("raw", fileText(aircraft.config.rawContent));
+    json.endObject();
+
+    json.endObject();
+    return buffer;
 }
 
 std::string AircraftIndexer::toNotFoundResponse(const std::string& requestId) {
-    std::ostringstream json;
-    json << "{";
-    json << "\"type\":\"aircraftDataResponse\",";
-    json << "\"requestId\":\"" << requestId << "\",";
-    json << "\"data\":{\"found\":false}";
-    json << "}";
-    return json.str();
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "aircraftDataResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.field("found", false);
+    json.endObject();
+    json.endObject();
+    return buffer;
 }
 
 std::string AircraftIndexer::toPathsInfoResponse() const {
-    std::lock_guard<std::mutex> lock(m_indexMutex);
-
-    auto escapeJson = [](const std::string& s) -> std::string {
-        std::string result;
-        result.reserve(s.length() * 2);
-        for (char c : s) {
-            switch (c) {
-                case '"': result += "\\\""; break;
-                case '\\': result += "\\\\"; break;
-                case '\n': result += "\\n"; break;
-                case '\r': result += "\\r"; break;
-                case '\t': result += "\\t"; break;
-                default: result += c;
-            }
-        }
-        return result;
-    };
-
-    std::ostringstream json;
-    json << "{";
-    json << "\"type\":\"msfsPaths\",";
-    json << "\"data\":{";
-    json << "\"userCfgOptPath\":\"" << escapeJson(m_userCfgOptPath) << "\",";
-    json << "\"configFilePath\":\"" << escapeJson(m_configFilePath) << "\",";
-    json << "\"indexedAircraftCount\":" << m_titleIndex.size() << ",";
-    json << "\"searchPaths\":[";
+    auto snapshot = getSnapshot();
+
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "msfsPaths");
+    json.key("data");
+    json.beginObject();
+    json.field("userCfgOptPath", snapshot->userCfgOptPath);
+    json.field("configFilePath", snapshot->configFilePath);
+    json.field("indexedAircraftCount", snapshot->titleIndex.size());
+    json.key("searchPaths");
+    json.beginArray();
+    for (const auto& path : snapshot->searchPaths) {
+        json.value(path);
+    }
+    json.endArray();
+    json.endObject();
+    json.endObject();
+    return buffer;
+}
 
-    for (size_t i = 0; i < m_searchPaths.size(); i++) {
-        json << "\"" << escapeJson(m_searchPaths[i]) << "\"";
-        if (i < m_searchPaths.size() - 1) json << ",";
+std::string AircraftIndexer::toIndexUpdatedMessage(const AircraftIndexDelta& delta, size_t indexedCount) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "aircraftIndexUpdated");
+    json.key("data");
+    json.beginObject();
+    json.field("indexedAircraftCount", indexedCount);
+
+    const std::pair<const char*, const std::vector<std::string>*> lists[] = {
+        { "added", &delta.added }, { "removed", &delta.removed }, { "updated", &delta.updated },
+    };
+    for (const auto& [name, titles] : lists) {
+        json.key(name);
+        json.beginArray();
+        for (const auto& title : *titles) {
+            json.value(title);
+        }
+        json.endArray();
     }
 
-    json << "]";
-    json << "}}";
-    return json.str();
+    json.endObject();
+    json.endObject();
+    return buffer;
 }
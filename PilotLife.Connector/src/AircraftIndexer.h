@@ -1,17 +1,32 @@
 #pragma once
 
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <winsock2.h>
-#include <windows.h>
-
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include "TitleIndex.h"
+#include "TitleMatcher.h"
+
+// Contents of a file read during indexing. Every record parsed from the file
+// shares this one copy instead of holding its own.
+using FileBlob = std::shared_ptr<const std::string>;
+
+inline std::string_view fileText(const FileBlob& blob) {
+    return blob ? std::string_view(*blob) : std::string_view();
+}
 
 // Parsed manifest.json data
 struct AircraftManifest {
@@ -24,7 +39,7 @@ struct AircraftManifest {
     std::string minimumGameVersion;
     std::string totalPackageSize;
     std::string contentId;
-    std::string rawJson;
+    FileBlob rawJson;
 };
 
 // Parsed Aircraft.cfg data
@@ -51,30 +66,154 @@ struct AircraftConfig {
     std::string performance;
     std::string category;
 
-    std::string rawContent;
+    // [VARIATION] section: set by livery packages, relative to the aircraft.cfg folder
+    // (e.g. "..\Asobo_C172"); names the aircraft whose model and settings the livery uses
+    std::string baseContainer;
+
+    // Where the aircraft.cfg is: "<SimObjects category>/<folder>", e.g. "Rotorcraft/Asobo_H135"
+    std::string simObject;
+
+    FileBlob rawContent;    // Whole aircraft.cfg, shared by all of its [FLTSIM.x] variations
 };
 
 // Combined indexed aircraft data
 struct IndexedAircraft {
-    AircraftManifest manifest;
+    std::shared_ptr<const AircraftManifest> manifest;   // Shared by every variation in the package; null if none was read
     AircraftConfig config;
     bool hasManifest = false;
     bool hasConfig = false;
+
+    // "data" object of this record's aircraftDataResponse, serialized on first lookup.
+    // Only accessed through std::atomic_load/atomic_store; records are shared by readers.
+    mutable std::shared_ptr<const std::string> responseData;
+};
+
+// Result of a lookup: points at a record inside the index snapshot it came from
+// and keeps that snapshot alive, so nothing is copied; null if not found
+using AircraftHandle = std::shared_ptr<const IndexedAircraft>;
+
+// Modification time and size of a file when it was parsed
+struct FileStamp {
+    int64_t modified = 0;
+    uint64_t size = 0;
+
+    bool operator==(const FileStamp& other) const { return modified == other.modified && size == other.size; }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+
+    // Stamp of the file on disk; nullopt if it cannot be read
+    static std::optional<FileStamp> of(const std::filesystem::path& filePath);
+};
+
+// Result of scanning one package directory, with the stamps of the files it was read from
+struct PackageScan {
+    std::string packagePath;
+    FileStamp manifest;
+    bool isAircraft = false;                                  // Aircraft or livery package; its cfgs were looked at
+    std::vector<std::pair<std::string, FileStamp>> cfgFiles;  // aircraft.cfg path -> stamp, in directory order
+    std::vector<IndexedAircraft> aircraft;
+};
+
+// A livery variation merged with the base aircraft its base_container names
+struct ResolvedLivery {
+    IndexedAircraft aircraft;           // The livery's record, with what it leaves empty taken from the base
+    const PackageScan* basePackage;     // Package of the base aircraft
+};
+
+// Immutable view of the index (RCU style). Scans build a new snapshot off to the
+// side and swap the pointer atomically; readers load the pointer and never block
+// on a rescan, and a snapshot lives until the last reader holding it lets go.
+// (std::atomic_load on a shared_ptr takes a short internal lock in libstdc++ and
+// MSVC, held only for the pointer copy, so this is not lock-free; C++20's
+// std::atomic<std::shared_ptr> is the drop-in replacement.)
+struct AircraftIndexSnapshot {
+    std::vector<std::shared_ptr<const PackageScan>> packages;   // In scan order; unchanged packages are shared between snapshots
+    TitleIndex titleIndex;      // Normalized title -> aircraft owned by packages
+    TitleMatcher titleMatcher;  // Approximate matching over the titleIndex keys (same ids)
+
+    // Liveries whose base aircraft is indexed; the title index points at these instead of the
+    // package records. Rebuilt with every snapshot, since the base may be in another package.
+    std::deque<ResolvedLivery> liveries;
+
+    // Where the packages came from (for the fallback search and msfsPaths info)
+    std::vector<std::string> searchPaths;
+    std::string configFilePath;
+    std::string userCfgOptPath;
+};
+
+// Live simulator data (ATC TYPE / ATC MODEL) used to choose between titles that match equally well
+struct AircraftMatchHints {
+    std::string atcType;
+    std::string atcModel;
+};
+
+// One candidate of a title lookup
+struct AircraftMatch {
+    AircraftHandle aircraft;
+    std::string title;          // Normalized title that matched
+    double confidence = 0.0;    // 1.0 for an exact match
+};
+
+// Result of a title lookup, with the runners-up when it was not an exact match
+struct AircraftLookup {
+    AircraftHandle aircraft;                // Best match; null if nothing matched well enough
+    double confidence = 0.0;
+    bool exact = false;
+    bool knownMiss = false;                 // Not on disk either when last searched; no search needed
+    std::vector<AircraftMatch> candidates;  // Best approximate matches, best first (empty for exact matches)
+};
+
+// Aircraft titles affected by one index update
+struct AircraftIndexDelta {
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+    std::vector<std::string> updated;   // Still present, but their package (or a livery's base aircraft) was reparsed
+
+    bool empty() const { return added.empty() && removed.empty() && updated.empty(); }
 };
 
 class AircraftIndexer {
 public:
+    // Receives the outcome of a background search, and what it changed in the index
+    using SearchCallback = std::function<void(const AircraftLookup& lookup, const AircraftIndexDelta& delta)>;
+
     AircraftIndexer();
-    ~AircraftIndexer() = default;
+    ~AircraftIndexer();
 
     // Initialize and scan for aircraft
     bool initialize();
 
-    // Rescan all aircraft folders
-    void rescan();
+    // Scan the given package folders instead of the configured and detected MSFS paths
+    // (benchmarks, tests, tools). The index cache is kept in cacheDirectory; empty disables it.
+    bool initialize(const std::vector<std::string>& searchPaths, const std::string& cacheDirectory);
+
+    // Re-check every package in the search paths and reparse the ones whose files changed
+    AircraftIndexDelta rescan();
 
-    // Find aircraft by title (matches SimConnect TITLE variable)
-    std::optional<IndexedAircraft> findByTitle(const std::string& title) const;
+    // Reparse the given package directories (dropping ones that no longer exist) and publish the result
+    AircraftIndexDelta refreshPackages(const std::vector<std::string>& packagePaths);
+
+    // Approximate matches below this confidence are not used
+    static constexpr double MIN_MATCH_CONFIDENCE = 0.6;
+
+    // How long a title that could not be found on disk is answered from memory (default)
+    static constexpr std::chrono::seconds MISS_CACHE_TTL{60};
+
+    // Override MISS_CACHE_TTL for misses recorded from now on (tests, tools)
+    void setMissCacheTtl(std::chrono::steady_clock::duration ttl);
+
+    // Find aircraft by title (matches SimConnect TITLE variable) without touching the disk
+    AircraftHandle findByTitle(const std::string& title, const AircraftMatchHints& hints = {}) const;
+
+    // Exact title, else the closest indexed titles (up to maxCandidates). Never touches the
+    // disk: if nothing matched and the title is not a known miss, use searchInBackground.
+    AircraftLookup lookup(const std::string& title, const AircraftMatchHints& hints, size_t maxCandidates) const;
+
+    // Look for a title lookup() did not find in the package folders, on a background thread.
+    // Packages found that way are indexed; misses are remembered for the miss cache TTL. done runs
+    // on the background thread (once per call; concurrent searches for one title are merged)
+    // with 'partial' (lookup()'s result) filled in. Searches still queued or running when
+    // the indexer is destroyed are abandoned, and done is not run for them.
+    void searchInBackground(const std::string& title, AircraftLookup partial, SearchCallback done);
 
     // Get indexed count
     size_t getIndexedCount() const;
@@ -82,15 +221,30 @@ public:
     // Get all search paths being used
     std::vector<std::string> getSearchPaths() const;
 
-    // Convert IndexedAircraft to JSON response string
+    // Threads used to scan packages (0 = one per hardware thread); takes effect on the next scan
+    void setScanWorkerCount(size_t count);
+
+    // Convert IndexedAircraft to JSON response string (the record's part is cached after the first call)
     static std::string toJsonResponse(const IndexedAircraft& aircraft, const std::string& requestId);
 
+    // Same, plus a "match" object describing how the title was matched
+    static std::string toJsonResponse(const AircraftLookup& lookup, const std::string& requestId);
+
     // Create a "not found" JSON response
     static std::string toNotFoundResponse(const std::string& requestId);
 
     // Create a JSON response with MSFS paths info
     std::string toPathsInfoResponse() const;
 
+    // Create the aircraftIndexUpdated push sent to clients after a live re-index
+    static std::string toIndexUpdatedMessage(const AircraftIndexDelta& delta, size_t indexedCount);
+
+    // Parse manifest.json file
+    static AircraftManifest parseManifestJson(const std::filesystem::path& filePath);
+
+    // Parse all FLTSIM sections from Aircraft.cfg file
+    static std::vector<AircraftConfig> parseAllAircraftCfgVariations(const std::filesystem::path& filePath);
+
 private:
     // Detect MSFS installation paths by parsing UserCfg.opt files
     std::vector<std::string> detectMSFSInstallPaths();
@@ -107,35 +261,89 @@ private:
     // Load custom paths from config file (legacy, delegates to loadPathsFromConfig)
     bool loadConfigFile();
 
-    // Scan a base path for aircraft packages
-    void scanAircraftFolders(const std::string& basePath);
+    // Scan all base paths for aircraft packages (one parallel task per package directory).
+    // Packages in 'known' are reused if unchanged on disk; with 'recheck' set, only those
+    // paths are checked and every other known package is reused without touching the disk.
+    std::vector<std::shared_ptr<const PackageScan>> scanAircraftFolders(
+        const std::vector<std::string>& basePaths,
+        const std::unordered_map<std::string, std::shared_ptr<const PackageScan>>& known,
+        const std::unordered_set<std::string>* recheck);
 
-    // Parse manifest.json file
-    AircraftManifest parseManifestJson(const std::filesystem::path& filePath);
+    // List the package directories under a base path, in directory order
+    static void collectPackageDirectories(const std::string& basePath, std::vector<std::filesystem::path>& packageDirs);
+
+    // Read one package's manifest and aircraft.cfg variations
+    static PackageScan scanPackage(const std::filesystem::path& packagePath);
+
+    // List the aircraft.cfg files in every SimObjects category of a package, with their stamps
+    static std::vector<std::pair<std::string, FileStamp>> stampAircraftCfgs(const std::filesystem::path& packagePath);
+
+    // True if none of the files a cached scan was read from have changed
+    static bool isPackageUnchanged(const PackageScan& cached, const std::filesystem::path& packagePath);
+
+    // Scan m_searchPaths (reusing cached packages) and publish the first snapshot; m_scanMutex must be held
+    bool indexSearchPaths();
+
+    // Index cache file next to the paths config (or in the directory given to initialize);
+    // empty if there is none
+    std::string getIndexCachePath() const;
+
+    // Whole file in one read; null if it cannot be read
+    static FileBlob readFile(const std::filesystem::path& filePath);
 
     // Parse Aircraft.cfg file (returns config for first FLTSIM section)
-    AircraftConfig parseAircraftCfg(const std::filesystem::path& filePath);
+    static AircraftConfig parseAircraftCfg(const std::filesystem::path& filePath);
 
-    // Parse all FLTSIM sections from Aircraft.cfg file
-    std::vector<AircraftConfig> parseAllAircraftCfgVariations(const std::filesystem::path& filePath);
+    // Key of the SimObjects folder a livery's base_container points at (same form as simObjectKey)
+    static std::string resolveBaseContainer(const AircraftConfig& config);
+
+    // Lowercased "<category>/<folder>"; the simulator's file system ignores case
+    static std::string simObjectKey(std::string_view simObject);
+
+    // Copy of a livery record with the fields it leaves empty (model, [GENERAL], ...) taken from its base
+    static IndexedAircraft mergeWithBase(const IndexedAircraft& livery, const IndexedAircraft& base);
+
+    // Build a snapshot (with its title index) from scanned packages and the current paths
+    std::shared_ptr<const AircraftIndexSnapshot> buildSnapshot(std::vector<std::shared_ptr<const PackageScan>> packages) const;
+
+    // Swap in a new snapshot and report which titles changed relative to the old one
+    AircraftIndexDelta publishSnapshot(std::shared_ptr<const AircraftIndexSnapshot> snapshot);
+
+    // Current snapshot (never null); never blocks on a rescan
+    std::shared_ptr<const AircraftIndexSnapshot> getSnapshot() const;
+
+    // Body of the background search thread
+    void searchLoop();
+
+    // Index the package holding a title (or read it from disk) if it exists; runs on the search thread
+    AircraftLookup searchForTitle(const std::string& title, AircraftIndexDelta& delta);
+
+    // Find a title in the aircraft.cfg files of every package the index cannot already
+    // answer for; packagePath is set to where it was found
+    AircraftHandle searchPackages(const std::string& normalizedTitle, const AircraftIndexSnapshot& snapshot,
+                                  std::string& packagePath) const;
+
+    // Serialize the "data" object of an aircraftDataResponse
+    static std::string writeResponseData(const IndexedAircraft& aircraft);
 
-    // Build title index from all scanned packages
-    void buildTitleIndex();
+    // Shared by both toJsonResponse overloads
+    static std::string writeAircraftResponse(const IndexedAircraft& aircraft, const std::string& requestId,
+                                             const AircraftLookup* lookup);
 
-    // Fallback search: scan all aircraft.cfg files for a specific title
-    std::optional<IndexedAircraft> searchForTitle(const std::string& title) const;
+    // How many of the hinted ATC type/model values an aircraft.cfg agrees with
+    static int countHintMatches(const AircraftConfig& config, const AircraftMatchHints& hints);
 
     // Helper to normalize title for matching
     static std::string normalizeTitle(const std::string& title);
 
-    // Helper to parse INI-style config value
-    static std::string parseConfigValue(const std::string& line);
+    // Helper to parse INI-style config value (the text after '='); returns a view into it
+    static std::string_view parseConfigValue(std::string_view value);
 
-    // Index by normalized title -> IndexedAircraft
-    std::map<std::string, IndexedAircraft> m_titleIndex;
+    // Current index; only accessed through std::atomic_load/atomic_store
+    std::shared_ptr<const AircraftIndexSnapshot> m_snapshot;
 
-    // All discovered packages
-    std::vector<IndexedAircraft> m_packages;
+    // Path state below is owned by whichever scan holds m_scanMutex; readers see
+    // the copies published in the snapshot
 
     // Search paths
     std::vector<std::string> m_searchPaths;
@@ -146,6 +354,33 @@ private:
     // UserCfg.opt path that was used (for info display)
     std::string m_userCfgOptPath;
 
-    // Thread safety
-    mutable std::mutex m_indexMutex;
+    // Set when initialize was given the cache location instead of deriving it from the config path
+    std::optional<std::string> m_indexCacheDirectory;
+
+    // Package scan threads (0 = hardware concurrency)
+    std::atomic<size_t> m_scanWorkerCount{0};
+
+    // Serializes writers (initialize, rescan, refreshPackages); lookups never take it
+    std::mutex m_scanMutex;
+
+    // Background search state; everything below is guarded by m_searchMutex. Both caches
+    // are keyed by normalized title and emptied whenever a new snapshot is published.
+    struct PendingSearch {
+        std::string title;
+        AircraftLookup partial;
+        std::vector<SearchCallback> callbacks;
+    };
+    struct CachedMiss {
+        std::chrono::steady_clock::time_point expires;
+        AircraftLookup lookup;
+    };
+    mutable std::mutex m_searchMutex;
+    std::condition_variable m_searchCondition;
+    std::deque<std::string> m_searchQueue;                          // Normalized titles, oldest first
+    std::unordered_map<std::string, PendingSearch> m_pendingSearches;
+    std::unordered_map<std::string, CachedMiss> m_missCache;
+    std::chrono::steady_clock::duration m_missCacheTtl = MISS_CACHE_TTL;
+    std::unordered_map<std::string, AircraftHandle> m_diskHits;     // Found on disk in packages the index skips
+    std::thread m_searchThread;
+    std::atomic<bool> m_searchStopping{false};
 };
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "CommandRequest.h"
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+
+// A member of a command's parameter struct, filled from the request field of the same name
+template <typename Params>
+struct CommandField {
+    using Member = std::variant<std::string Params::*, int Params::*, bool Params::*, std::vector<std::string> Params::*>;
+
+    std::string_view name;
+    Member member;
+    bool required = false;  // Otherwise a missing (or null) field leaves the member's default
+};
+
+// Maps the "type" of a client request to a handler that takes typed, validated
+// parameters.
+//
+// Each command declares a parameter struct and a table of CommandFields naming
+// its members. dispatch() parses the message once, fills a fresh struct and calls
+// the handler only if every required field is present and every field has its
+// declared type; anything else is answered with an errorResponse. Members a
+// command does not declare are ignored, so clients may send more than it reads.
+//
+// Handlers either return their response or, registered with addAsync, pass it to
+// a Reply later (from any thread). Every dispatch replies exactly once, and the
+// time from receipt to reply is recorded per command type (see writeStats).
+//
+// Context is what handlers need to know about the sender (the client connection).
+// Register every command before the first dispatch; dispatch() only reads the
+// registry and may run on several threads at once.
+template <typename Context>
+class CommandRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Receives a request's response; empty if there is nothing to send
+    using Reply = std::function<void(std::string response)>;
+
+    template <typename Params>
+    using Handler = std::function<std::string(const Params& params, const std::string& requestId, Context& context)>;
+
+    // Must call reply exactly once, on any thread
+    template <typename Params>
+    using AsyncHandler = std::function<void(const Params& params, const std::string& requestId, Context& context, Reply reply)>;
+
+    template <typename Params>
+    void add(std::string type, std::vector<CommandField<Params>> fields, Handler<Params> handler) {
+        addAsync<Params>(std::move(type), std::move(fields),
+            [handler = std::move(handler)](const Params& params, const std::string& requestId, Context& context, Reply reply) {
+                reply(handler(params, requestId, context));
+            });
+    }
+
+    template <typename Params>
+    void addAsync(std::string type, std::vector<CommandField<Params>> fields, AsyncHandler<Params> handler) {
+        m_commands[std::move(type)].run = [fields = std::move(fields), handler = std::move(handler)](
+            const CommandRequest& request, const std::string& requestId, Context& context,
+            Reply& reply, std::string& error) {
+            Params params;
+            if (!readFields(request, fields, params, error)) return false;
+            handler(params, requestId, context, std::move(reply));
+            return true;
+        };
+    }
+
+    // Parse a message received at receivedAt and run its command. Its response goes to
+    // reply: the handler's, or an errorResponse for malformed messages, unknown types
+    // and bad fields.
+    void dispatch(std::string_view message, Context& context, Clock::time_point receivedAt, Reply reply) const {
+        // One request per thread, so its buffers are reused from message to message
+        thread_local CommandRequest request;
+        std::string error;
+        std::string requestId;
+        std::string_view type;
+
+        if (request.parse(message, error) && readEnvelope(request, type, requestId, error)) {
+            auto it = m_commands.find(type);
+            if (it == m_commands.end()) {
+                error = "Unknown command";
+            } else {
+                const Command& command = it->second;
+                Reply timed = [&command, receivedAt, reply = std::move(reply)](std::string response) {
+                    command.latency.record(Clock::now() - receivedAt);
+                    reply(std::move(response));
+                };
+                if (command.run(request, requestId, context, timed, error)) {
+                    return;
+                }
+                reply = std::move(timed);
+            }
+        }
+
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "Rejected " << (type.empty() ? std::string_view("request") : type) << ": " << error << std::endl;
+        reply(toErrorResponse(type, requestId, error));
+    }
+
+    // errorResponse for a message that will not be dispatched (e.g. the sender is over its
+    // request limit); reads just enough of it to echo its type and requestId
+    std::string reject(std::string_view message, std::string_view error) const {
+        thread_local CommandRequest request;
+        std::string parseError;
+        std::string requestId;
+        std::string_view type;
+        if (request.parse(message, parseError)) {
+            readEnvelope(request, type, requestId, parseError);
+        }
+
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "Rejected " << (type.empty() ? std::string_view("request") : type) << ": " << error << std::endl;
+        return toErrorResponse(type, requestId, error);
+    }
+
+    // {"rejected": n, "commands": {"<type>": <LatencyHistogram>, ...}} for the commands run so far
+    void writeStats(JsonWriter& json) const {
+        json.beginObject();
+        json.field("rejected", static_cast<int64_t>(m_rejected.load(std::memory_order_relaxed)));
+        json.key("commands");
+        json.beginObject();
+        for (const auto& [type, command] : m_commands) {
+            if (command.latency.count() == 0) continue;
+            json.key(type);
+            command.latency.writeJson(json);
+        }
+        json.endObject();
+        json.endObject();
+    }
+
+    // Reply to a request that could not be run
+    static std::string toErrorResponse(std::string_view type, std::string_view requestId, std::string_view error) {
+        std::string buffer;
+        JsonWriter json(buffer);
+        json.beginObject();
+        json.field("type", "errorResponse");
+        json.field("requestId", requestId);
+        json.key("data");
+        json.beginObject();
+        json.field("command", type);
+        json.field("error", error);
+        json.endObject();
+        json.endObject();
+        return buffer;
+    }
+
+private:
+    struct Command {
+        // False (with error set) if the fields do not validate; otherwise the handler owns reply
+        std::function<bool(const CommandRequest& request, const std::string& requestId, Context& context,
+                           Reply& reply, std::string& error)> run;
+        mutable LatencyHistogram latency;   // Receipt to reply
+    };
+
+    // "type" (required) and "requestId" (optional) are common to every command
+    static bool readEnvelope(const CommandRequest& request, std::string_view& type, std::string& requestId, std::string& error) {
+        const CommandRequest::Field* requestIdField = request.find("requestId");
+        if (requestIdField && !request.get(*requestIdField, requestId)) {
+            error = "Field requestId must be a string";
+            return false;
+        }
+
+        const CommandRequest::Field* typeField = request.find("type");
+        if (!typeField || typeField->type != CommandRequest::ValueType::String) {
+            error = "Field type must be a string";
+            return false;
+        }
+        type = typeField->text;
+        return true;
+    }
+
+    template <typename Params>
+    static bool readFields(const CommandRequest& request, const std::vector<CommandField<Params>>& fields,
+                           Params& params, std::string& error) {
+        for (const auto& spec : fields) {
+            const CommandRequest::Field* field = request.find(spec.name);
+            if (!field || field->type == CommandRequest::ValueType::Null) {
+                if (spec.required) {
+                    error = "Missing field: " + std::string(spec.name);
+                    return false;
+                }
+                continue;
+            }
+
+            bool valid = std::visit([&](auto member) {
+                if (request.get(*field, params.*member)) return true;
+                error = "Field " + std::string(spec.name) + " must be " + CommandRequest::describe(params.*member);
+                return false;
+            }, spec.member);
+            if (!valid) return false;
+        }
+        return true;
+    }
+
+    std::map<std::string, Command, std::less<>> m_commands;
+    mutable std::atomic<uint64_t> m_rejected{0};    // Malformed, unknown or invalid requests, and ones turned away
+};
@@ -0,0 +1,179 @@
+#include "CommandRequest.h"
+#include "JsonReader.h"
+#include <charconv>
+#include <functional>
+
+// Collects the members of the root object into a CommandRequest
+class CommandRequestReader : public JsonReader::Handler {
+public:
+    CommandRequestReader(std::string_view message, CommandRequest& request, std::string& error)
+        : m_message(message), m_request(request), m_error(error) {}
+
+    bool beginObject() override {
+        if (m_depth == 0) {
+            m_depth++;
+            return true;
+        }
+        return beginNested();
+    }
+
+    bool endObject() override {
+        m_depth--;
+        return true;
+    }
+
+    bool beginArray() override {
+        if (m_depth == 0) {
+            m_error = "Request is not a JSON object";
+            return false;
+        }
+        if (m_depth == 1) {
+            CommandRequest::Field& field = addField(CommandRequest::ValueType::StringArray, std::string_view());
+            field.firstItem = static_cast<uint32_t>(m_request.m_items.size());
+            m_depth++;
+            return true;
+        }
+        return beginNested();
+    }
+
+    bool endArray() override {
+        m_depth--;
+        return true;
+    }
+
+    bool key(std::string_view name) override {
+        if (m_depth != 1) return true;
+        if (m_request.m_fields.size() == CommandRequest::MAX_FIELDS) {
+            m_error = "Too many fields";
+            return false;
+        }
+        name = keep(name);
+        for (const auto& field : m_request.m_fields) {
+            if (field.name == name) {
+                m_error = "Duplicate field: " + std::string(name);
+                return false;
+            }
+        }
+        m_name = name;
+        return true;
+    }
+
+    bool string(std::string_view value) override {
+        if (m_depth == 1) {
+            return scalar(CommandRequest::ValueType::String, keep(value));
+        }
+        if (m_depth == 2 && m_request.m_fields.back().type == CommandRequest::ValueType::StringArray) {
+            m_request.m_items.push_back(keep(value));
+            m_request.m_fields.back().itemCount++;
+            return true;
+        }
+        return scalar(CommandRequest::ValueType::String, value);
+    }
+
+    bool number(std::string_view text) override { return scalar(CommandRequest::ValueType::Number, text); }
+    bool boolean(bool value) override { return scalar(CommandRequest::ValueType::Boolean, value ? "true" : "false"); }
+    bool null() override { return scalar(CommandRequest::ValueType::Null, std::string_view()); }
+
+private:
+    CommandRequest::Field& addField(CommandRequest::ValueType type, std::string_view text) {
+        m_request.m_fields.push_back({ m_name, type, text });
+        return m_request.m_fields.back();
+    }
+
+    // A value directly inside the root object, or an element of a string array
+    bool scalar(CommandRequest::ValueType type, std::string_view text) {
+        if (m_depth == 0) {
+            m_error = "Request is not a JSON object";
+            return false;
+        }
+        if (m_depth == 1) {
+            addField(type, text);
+        } else if (m_depth == 2) {
+            markOther();
+        }
+        return true;
+    }
+
+    bool beginNested() {
+        if (m_depth == 1) {
+            addField(CommandRequest::ValueType::Other, std::string_view());
+        } else if (m_depth == 2) {
+            markOther();
+        }
+        m_depth++;
+        return true;
+    }
+
+    // The member being read holds more than strings; drop the items collected so far
+    void markOther() {
+        CommandRequest::Field& field = m_request.m_fields.back();
+        if (field.type != CommandRequest::ValueType::StringArray) return;
+        field.type = CommandRequest::ValueType::Other;
+        m_request.m_items.resize(field.firstItem);
+        field.firstItem = 0;
+        field.itemCount = 0;
+    }
+
+    // Views into the message stay valid; decoded strings live in JsonReader's scratch buffer
+    std::string_view keep(std::string_view text) {
+        std::less<const char*> before;
+        if (!before(text.data(), m_message.data()) && before(text.data(), m_message.data() + m_message.size())) {
+            return text;
+        }
+        return m_request.m_decoded.emplace_back(text);
+    }
+
+    std::string_view m_message;
+    CommandRequest& m_request;
+    std::string& m_error;
+    std::string_view m_name;
+    int m_depth = 0;
+};
+
+bool CommandRequest::parse(std::string_view message, std::string& error) {
+    m_fields.clear();
+    m_items.clear();
+    m_decoded.clear();
+
+    CommandRequestReader reader(message, *this, error);
+    if (!JsonReader::parse(message, reader)) {
+        if (error.empty()) {
+            error = "Malformed JSON";
+        }
+        return false;
+    }
+    return true;
+}
+
+const CommandRequest::Field* CommandRequest::find(std::string_view name) const {
+    // Requests have a handful of members; a linear scan beats hashing them
+    for (const auto& field : m_fields) {
+        if (field.name == name) return &field;
+    }
+    return nullptr;
+}
+
+bool CommandRequest::get(const Field& field, std::string& value) const {
+    if (field.type != ValueType::String) return false;
+    value.assign(field.text.data(), field.text.size());
+    return true;
+}
+
+bool CommandRequest::get(const Field& field, int& value) const {
+    if (field.type != ValueType::Number) return false;
+    const char* end = field.text.data() + field.text.size();
+    auto result = std::from_chars(field.text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+bool CommandRequest::get(const Field& field, bool& value) const {
+    if (field.type != ValueType::Boolean) return false;
+    value = field.text == "true";
+    return true;
+}
+
+bool CommandRequest::get(const Field& field, std::vector<std::string>& value) const {
+    if (field.type != ValueType::StringArray) return false;
+    value.assign(m_items.begin() + field.firstItem, m_items.begin() + field.firstItem + field.itemCount);
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One client request: the top-level members of a JSON object, read in a single
+// pass with JsonReader. Names and values are views into the message, so the
+// message must outlive the request; only strings containing escapes are copied
+// (decoded) into storage owned by the request. Nested objects, and arrays holding
+// anything but strings, are checked for syntax but not kept.
+//
+// A request can be reused for successive messages; parse() keeps the capacity of
+// its buffers, so a warm request does not allocate for typical messages.
+class CommandRequest {
+public:
+    enum class ValueType { String, Number, Boolean, Null, StringArray, Other };
+
+    // Members accepted in one request (each new name is checked against the ones before it)
+    static constexpr size_t MAX_FIELDS = 64;
+
+    struct Field {
+        std::string_view name;
+        ValueType type;
+        std::string_view text;      // String contents, number text, or "true"/"false"
+        uint32_t firstItem = 0;     // StringArray: items [firstItem, firstItem + itemCount)
+        uint32_t itemCount = 0;
+    };
+
+    // Read a message. Fails (with a reason in error) if it is not a JSON object, a member
+    // name appears twice or there are more than MAX_FIELDS members.
+    bool parse(std::string_view message, std::string& error);
+
+    // Member by name; nullptr if absent
+    const Field* find(std::string_view name) const;
+
+    const std::vector<Field>& fields() const { return m_fields; }
+
+    // Typed reads of a field; false if the field holds another type (or an integer is out of range)
+    bool get(const Field& field, std::string& value) const;
+    bool get(const Field& field, int& value) const;
+    bool get(const Field& field, bool& value) const;
+    bool get(const Field& field, std::vector<std::string>& value) const;
+
+    // "a string", "an integer", ... for the type get() reads into; for error messages
+    static const char* describe(const std::string&) { return "a string"; }
+    static const char* describe(const int&) { return "an integer"; }
+    static const char* describe(const bool&) { return "a boolean"; }
+    static const char* describe(const std::vector<std::string>&) { return "an array of strings"; }
+
+private:
+    friend class CommandRequestReader;
+
+    std::vector<Field> m_fields;
+    std::vector<std::string_view> m_items;  // Elements of StringArray fields
+    std::deque<std::string> m_decoded;      // Strings that had escapes (deque: views into it stay valid)
+};
@@ -0,0 +1,305 @@
+#include "DirectoryWatcher.h"
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <windows.h>
+
+// ReadDirectoryChangesW on each root with bWatchSubtree set, so one handle
+// covers the whole tree. Each root has an overlapped read in flight whose
+// event is waited on together with the wake event.
+class Win32DirectoryWatcher : public DirectoryWatcher {
+public:
+    Win32DirectoryWatcher()
+        : m_wakeEvent(CreateEvent(nullptr, FALSE, FALSE, nullptr))
+    {
+    }
+
+    ~Win32DirectoryWatcher() override {
+        for (auto& root : m_roots) {
+            CancelIoEx(root->directory, &root->overlapped);
+            DWORD bytes = 0;
+            GetOverlappedResult(root->directory, &root->overlapped, &bytes, TRUE);
+            CloseHandle(root->overlapped.hEvent);
+            CloseHandle(root->directory);
+        }
+        if (m_wakeEvent) {
+            CloseHandle(m_wakeEvent);
+        }
+    }
+
+    bool watch(const std::vector<std::string>& roots, int) override {
+        for (const auto& path : roots) {
+            // Leave one wait slot for the wake event
+            if (m_roots.size() + 1 >= MAXIMUM_WAIT_OBJECTS) break;
+
+            HANDLE directory = CreateFileA(path.c_str(), FILE_LIST_DIRECTORY,
+                                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                           OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (directory == INVALID_HANDLE_VALUE) {
+                std::cerr << "Cannot watch " << path << " (error " << GetLastError() << ")" << std::endl;
+                continue;
+            }
+
+            auto root = std::make_unique<WatchedRoot>();
+            root->path = path;
+            root->directory = directory;
+            root->overlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+            if (!issueRead(*root)) {
+                std::cerr << "Cannot watch " << path << " (error " << GetLastError() << ")" << std::endl;
+                CloseHandle(root->overlapped.hEvent);
+                CloseHandle(directory);
+                continue;
+            }
+            m_roots.push_back(std::move(root));
+        }
+        return !m_roots.empty();
+    }
+
+    bool waitForChanges(std::chrono::milliseconds timeout, std::vector<DirectoryChange>& changes) override {
+        std::vector<HANDLE> handles;
+        for (const auto& root : m_roots) {
+            handles.push_back(root->overlapped.hEvent);
+        }
+        if (m_wakeEvent) {
+            handles.push_back(m_wakeEvent);
+        }
+
+        DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE,
+                                              static_cast<DWORD>(timeout.count()));
+        if (result == WAIT_TIMEOUT || result == WAIT_FAILED) {
+            return false;
+        }
+
+        size_t before = changes.size();
+        for (auto it = m_roots.begin(); it != m_roots.end();) {
+            WatchedRoot& root = **it;
+            DWORD bytes = 0;
+            if (GetOverlappedResult(root.directory, &root.overlapped, &bytes, FALSE)) {
+                if (bytes == 0) {
+                    // The buffer overflowed and the individual changes are lost
+                    changes.push_back({ root.path, std::string() });
+                } else {
+                    appendChanges(root, changes);
+                }
+            } else {
+                DWORD error = GetLastError();
+                if (error == ERROR_IO_INCOMPLETE) {
+                    ++it;  // Still pending
+                    continue;
+                }
+                // The read failed (root deleted or renamed, share gone); what changed is unknown
+                std::cerr << "Watching " << root.path << " failed (error " << error << ")" << std::endl;
+                changes.push_back({ root.path, std::string() });
+            }
+
+            // Clear the manual-reset event before the next read, or every wait returns at once;
+            // a root that cannot be read again (it no longer exists) is dropped
+            ResetEvent(root.overlapped.hEvent);
+            if (!issueRead(root)) {
+                std::cerr << "No longer watching " << root.path << " (error " << GetLastError() << ")" << std::endl;
+                CloseHandle(root.overlapped.hEvent);
+                CloseHandle(root.directory);
+                it = m_roots.erase(it);
+                continue;
+            }
+            ++it;
+        }
+        return changes.size() > before;
+    }
+
+    void wake() override {
+        if (m_wakeEvent) {
+            SetEvent(m_wakeEvent);
+        }
+    }
+
+private:
+    static constexpr DWORD NOTIFY_BUFFER_SIZE = 64 * 1024;
+
+    struct WatchedRoot {
+        std::string path;
+        HANDLE directory = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped = {};
+        DWORD buffer[NOTIFY_BUFFER_SIZE / sizeof(DWORD)];  // DWORD-aligned as the API requires
+    };
+
+    static bool issueRead(WatchedRoot& root) {
+        return ReadDirectoryChangesW(root.directory, root.buffer, sizeof(root.buffer), TRUE,
+                                     FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                     FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE,
+                                     nullptr, &root.overlapped, nullptr) != FALSE;
+    }
+
+    static void appendChanges(const WatchedRoot& root, std::vector<DirectoryChange>& changes) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(root.buffer);
+        for (;;) {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(bytes);
+            std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+            changes.push_back({ root.path, std::filesystem::path(name).string() });
+
+            if (info->NextEntryOffset == 0) break;
+            bytes += info->NextEntryOffset;
+        }
+    }
+
+    std::vector<std::unique_ptr<WatchedRoot>> m_roots;
+    HANDLE m_wakeEvent;
+};
+
+std::unique_ptr<DirectoryWatcher> DirectoryWatcher::create() {
+    return std::make_unique<Win32DirectoryWatcher>();
+}
+
+#elif defined(__linux__)
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cstdint>
+#include <unordered_map>
+
+// inotify watches single directories, so every directory down to maxDepth gets
+// its own watch; directories created later are added as they appear. An eventfd
+// is polled alongside the inotify descriptor to implement wake().
+class InotifyDirectoryWatcher : public DirectoryWatcher {
+public:
+    InotifyDirectoryWatcher()
+        : m_inotify(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+        , m_wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+    }
+
+    ~InotifyDirectoryWatcher() override {
+        if (m_inotify >= 0) close(m_inotify);
+        if (m_wakeFd >= 0) close(m_wakeFd);
+    }
+
+    bool watch(const std::vector<std::string>& roots, int maxDepth) override {
+        if (m_inotify < 0) return false;
+
+        m_maxDepth = maxDepth;
+        bool watching = false;
+        for (const auto& root : roots) {
+            if (addTree(root, std::filesystem::path(), 0)) {
+                watching = true;
+            } else {
+                std::cerr << "Cannot watch " << root << std::endl;
+            }
+        }
+        return watching;
+    }
+
+    bool waitForChanges(std::chrono::milliseconds timeout, std::vector<DirectoryChange>& changes) override {
+        pollfd fds[2] = { { m_inotify, POLLIN, 0 }, { m_wakeFd, POLLIN, 0 } };
+        if (poll(fds, 2, static_cast<int>(timeout.count())) <= 0) {
+            return false;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            uint64_t count;
+            (void)read(m_wakeFd, &count, sizeof(count));
+        }
+
+        size_t before = changes.size();
+        alignas(inotify_event) char buffer[16 * 1024];
+        for (;;) {
+            ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+            if (length <= 0) break;
+
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = reinterpret_cast<inotify_event*>(p);
+                p += sizeof(inotify_event) + event->len;
+                handleEvent(*event, changes);
+            }
+        }
+        return changes.size() > before;
+    }
+
+    void wake() override {
+        uint64_t one = 1;
+        (void)write(m_wakeFd, &one, sizeof(one));
+    }
+
+private:
+    struct WatchedDirectory {
+        std::string root;
+        std::filesystem::path relativePath;
+        int depth;
+    };
+
+    static constexpr uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE |
+                                           IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+
+    bool addTree(const std::string& root, const std::filesystem::path& relativePath, int depth) {
+        std::filesystem::path fullPath = std::filesystem::path(root) / relativePath;
+        int wd = inotify_add_watch(m_inotify, fullPath.c_str(), WATCH_MASK | IN_ONLYDIR);
+        if (wd < 0) return false;
+        m_watches[wd] = { root, relativePath, depth };
+
+        if (depth < m_maxDepth) {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(fullPath, ec)) {
+                if (entry.is_directory(ec)) {
+                    addTree(root, relativePath / entry.path().filename(), depth + 1);
+                }
+            }
+        }
+        return true;
+    }
+
+    void handleEvent(const inotify_event& event, std::vector<DirectoryChange>& changes) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            // Events were dropped; every root has to be rescanned
+            for (const auto& [wd, watched] : m_watches) {
+                if (watched.depth == 0) changes.push_back({ watched.root, std::string() });
+            }
+            return;
+        }
+
+        auto it = m_watches.find(event.wd);
+        if (it == m_watches.end()) return;
+
+        if (event.mask & IN_IGNORED) {
+            m_watches.erase(it);
+            return;
+        }
+
+        WatchedDirectory watched = it->second;
+        std::filesystem::path changed = watched.relativePath;
+        if (event.len > 0) {
+            changed /= event.name;
+        }
+        if (!changed.empty()) {
+            changes.push_back({ watched.root, changed.string() });
+        }
+
+        // New directories inside the watched depth need watches of their own
+        if ((event.mask & (IN_CREATE | IN_MOVED_TO)) && (event.mask & IN_ISDIR) && watched.depth < m_maxDepth) {
+            addTree(watched.root, changed, watched.depth + 1);
+        }
+    }
+
+    int m_inotify;
+    int m_wakeFd;
+    int m_maxDepth = 0;
+    std::unordered_map<int, WatchedDirectory> m_watches;
+};
+
+std::unique_ptr<DirectoryWatcher> DirectoryWatcher::create() {
+    return std::make_unique<InotifyDirectoryWatcher>();
+}
+
+#else
+
+std::unique_ptr<DirectoryWatcher> DirectoryWatcher::create() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One filesystem change below a watched root
+struct DirectoryChange {
+    std::string root;           // Watched root the change was reported under
+    std::string relativePath;   // Changed path relative to root; empty if events were lost and root must be rescanned
+};
+
+// Source of filesystem change notifications for a set of directory trees.
+// A single thread calls waitForChanges() in a loop; wake() may be called from
+// any thread to unblock it (shutdown).
+class DirectoryWatcher {
+public:
+    virtual ~DirectoryWatcher() = default;
+
+    // Start watching each root and everything below it (up to maxDepth directory
+    // levels where the platform cannot watch a whole tree). Returns false if no root could be watched.
+    virtual bool watch(const std::vector<std::string>& roots, int maxDepth) = 0;
+
+    // Block until changes arrive, wake() is called, or the timeout elapses, then
+    // append whatever changes are pending. Returns false if nothing was appended.
+    virtual bool waitForChanges(std::chrono::milliseconds timeout, std::vector<DirectoryChange>& changes) = 0;
+
+    // Unblock a thread waiting in waitForChanges()
+    virtual void wake() = 0;
+
+    // Watcher for the current platform (ReadDirectoryChangesW on Windows, inotify on Linux);
+    // nullptr where neither is available
+    static std::unique_ptr<DirectoryWatcher> create();
+};
@@ -1,6 +1,7 @@
 #include "FlightData.h"
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <ctime>
 #include <chrono>
 
@@ -8,7 +9,7 @@
 constexpr double LBS_TO_KGS = 0.453592;
 
 // Helper to convert engine type enum to string
-static std::string engineTypeToString(int engineType) {
+static const char* engineTypeToString(int engineType) {
     switch (engineType) {
         case 0: return "Piston";
         case 1: return "Jet";
@@ -20,155 +21,348 @@ static std::string engineTypeToString(int engineType) {
     }
 }
 
-FlightDataJson FlightDataJson::fromSimConnect(const SimConnectFlightData& data, const std::string& simVersion) {
-    FlightDataJson json;
-
-    // Aircraft metadata
-    json.aircraftTitle = data.title;
-    json.atcType = data.atcType;
-    json.atcModel = data.atcModel;
-    json.atcId = data.atcId;
-    json.atcAirline = data.atcAirline;
-    json.atcFlightNumber = data.atcFlightNumber;
-    json.category = data.category;
-    json.engineType = static_cast<int>(data.engineType);
-    json.engineTypeStr = engineTypeToString(static_cast<int>(data.engineType));
-    json.numberOfEngines = static_cast<int>(data.numberOfEngines);
-    json.maxGrossWeightLbs = data.maxGrossWeight;
-    json.cruiseSpeedKts = data.cruiseSpeed;
-    json.emptyWeightLbs = data.emptyWeight;
-
-    // Position
-    json.latitude = data.latitude;
-    json.longitude = data.longitude;
-    json.altitudeIndicated = data.altitudeIndicated;
-    json.altitudeTrue = data.altitudeTrue;
-    json.altitudeAGL = data.altitudeAGL;
-
-    // Speed
-    json.airspeedIndicated = data.airspeedIndicated;
-    json.airspeedTrue = data.airspeedTrue;
-    json.groundSpeed = data.groundSpeed;
-    json.machNumber = data.machNumber;
-
-    // Heading
-    json.headingMagnetic = data.headingMagnetic;
-    json.headingTrue = data.headingTrue;
-    json.track = data.gpsGroundTrack;
-
-    // Calculate fuel in LBS and KGS
-    double fuelGallons = data.fuelTotalQuantity;
-    json.fuelLbs = fuelGallons * data.fuelWeightPerGallon;
-    json.fuelKgs = json.fuelLbs * LBS_TO_KGS;
-
-    // Calculate weights
-    json.totalWeightLbs = data.totalWeight;
-    json.totalWeightKgs = data.totalWeight * LBS_TO_KGS;
-
-    // Payload = Total Weight - Empty Weight - Fuel
-    json.payloadLbs = data.totalWeight - data.emptyWeight - json.fuelLbs;
-    json.payloadKgs = json.payloadLbs * LBS_TO_KGS;
-
-    // Format frequencies
-    json.com1Frequency = formatFrequency(data.com1ActiveFreq);
-    json.com2Frequency = formatFrequency(data.com2ActiveFreq);
-    json.nav1Frequency = formatFrequency(data.nav1ActiveFreq);
-    json.nav2Frequency = formatFrequency(data.nav2ActiveFreq);
-
-    json.timestamp = getCurrentTimestamp();
-    json.simulatorVersion = simVersion;
-
-    return json;
-}
-
-std::string FlightDataJson::formatFrequency(double freqHz) {
+// Format frequency from Hz to MHz (e.g., 118700000 -> "118.700") into a caller buffer
+static std::string_view formatFrequency(double freqHz, char (&out)[32]) {
     // SimConnect returns frequency in Hz as FLOAT64 (e.g., 118700000.0 for 118.700 MHz)
-    double freqMHz = freqHz / 1000000.0;
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3) << freqMHz;
-    return oss.str();
+    auto result = std::to_chars(out, out + sizeof(out), freqHz / 1000000.0, std::chars_format::fixed, 3);
+    if (result.ec != std::errc()) {
+        return std::string_view();
+    }
+    return std::string_view(out, result.ptr - out);
 }
 
-std::string FlightDataJson::getCurrentTimestamp() {
+// Format current UTC time in ISO 8601 format into a caller buffer
+static std::string_view formatTimestamp(char (&out)[32]) {
     auto now = std::chrono::system_clock::now();
     auto time_t_now = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
 
     std::tm tm_utc;
+#ifdef _WIN32
     gmtime_s(&tm_utc, &time_t_now);
+#else
+    gmtime_r(&time_t_now, &tm_utc);
+#endif
+
+    size_t len = std::strftime(out, sizeof(out), "%Y-%m-%dT%H:%M:%S", &tm_utc);
+    int millis = static_cast<int>(ms.count());
+    out[len++] = '.';
+    out[len++] = static_cast<char>('0' + millis / 100);
+    out[len++] = static_cast<char>('0' + (millis / 10) % 10);
+    out[len++] = static_cast<char>('0' + millis % 10);
+    out[len++] = 'Z';
+    return std::string_view(out, len);
+}
+
+void FlightDataEncoder::writeMessage(const SimConnectFlightData& data, std::string_view simVersion, std::string& buffer) {
+    writeMessage(data, simVersion, FIELD_GROUP_ALL, buffer);
+}
+
+void FlightDataEncoder::writeMessage(const SimConnectFlightData& data, std::string_view simVersion, uint32_t groups, std::string& buffer) {
+    JsonWriter writer(buffer);
+    writer.reset();
+    writer.beginObject();
+    writer.field("type", "flightData");
+    writer.key("data");
+    writeJson(data, simVersion, groups, writer);
+    writer.endObject();
+}
+
+// Registry SimVars read by derived fields
+constexpr size_t SV_ENGINE_TYPE = simVarIndex("ENGINE TYPE");
+constexpr size_t SV_EMPTY_WEIGHT = simVarIndex("EMPTY WEIGHT");
+constexpr size_t SV_FUEL_TOTAL_QUANTITY = simVarIndex("FUEL TOTAL QUANTITY");
+constexpr size_t SV_FUEL_WEIGHT_PER_GALLON = simVarIndex("FUEL WEIGHT PER GALLON");
+constexpr size_t SV_TOTAL_WEIGHT = simVarIndex("TOTAL WEIGHT");
+
+// Derived weights shared by several fields
+static double fuelLbs(const SimConnectFlightData& d) {
+    return d.number(SV_FUEL_TOTAL_QUANTITY) * d.number(SV_FUEL_WEIGHT_PER_GALLON);
+}
+
+static double payloadLbs(const SimConnectFlightData& d) {
+    return d.number(SV_TOTAL_WEIGHT) - d.number(SV_EMPTY_WEIGHT) - fuelLbs(d);
+}
+
+// A field computed from registry SimVars, written right after the SimVar named in 'after'
+struct DerivedField {
+    const char* after;
+    FlightDataField field;
+};
+
+const std::vector<FlightDataField>& FlightDataEncoder::getFields() {
+    using Kind = FlightDataField::Kind;
+    using Data = SimConnectFlightData;
+
+    static const DerivedField derived[] = {
+        { "ENGINE TYPE", { "engineTypeStr", FIELD_GROUP_METADATA, Kind::Text, 0, 0.0, 0,
+            [](const Data& d) { return std::string_view(engineTypeToString(static_cast<int>(d.number(SV_ENGINE_TYPE)))); }, nullptr } },
+        { "FUEL WEIGHT PER GALLON", { "fuelLbs", FIELD_GROUP_WEIGHT, Kind::Number, 1, 1.0, 0,
+            nullptr, [](const Data& d) { return fuelLbs(d); } } },
+        { "FUEL WEIGHT PER GALLON", { "fuelKgs", FIELD_GROUP_WEIGHT, Kind::Number, 1, 0.5, 0,
+            nullptr, [](const Data& d) { return fuelLbs(d) * LBS_TO_KGS; } } },
+        { "FUEL WEIGHT PER GALLON", { "payloadLbs", FIELD_GROUP_WEIGHT, Kind::Number, 1, 1.0, 0,
+            nullptr, [](const Data& d) { return payloadLbs(d); } } },
+        { "FUEL WEIGHT PER GALLON", { "payloadKgs", FIELD_GROUP_WEIGHT, Kind::Number, 1, 0.5, 0,
+            nullptr, [](const Data& d) { return payloadLbs(d) * LBS_TO_KGS; } } },
+        { "TOTAL WEIGHT", { "totalWeightKgs", FIELD_GROUP_WEIGHT, Kind::Number, 1, 0.5, 0,
+            nullptr, [](const Data& d) { return d.number(SV_TOTAL_WEIGHT) * LBS_TO_KGS; } } },
+    };
+
+    // Built once from the registry: every SimVar with a JSON key, each followed by its derived fields
+    static const std::vector<FlightDataField> fields = [] {
+        std::vector<FlightDataField> result;
+        for (size_t i = 0; i < SIM_VAR_COUNT; i++) {
+            const SimVarDef& simVar = SIM_VARS[i];
+            if (simVar.key) {
+                result.push_back({ simVar.key, simVar.group, simVar.kind, simVar.precision, simVar.epsilon, i,
+                                   nullptr, nullptr });
+            }
+            for (const auto& entry : derived) {
+                if (std::string_view(entry.after) == simVar.name) {
+                    result.push_back(entry.field);
+                }
+            }
+        }
+        return result;
+    }();
+    return fields;
+}
+
+void FlightDataEncoder::writeField(const FlightDataField& field, const SimConnectFlightData& data, JsonWriter& writer) {
+    char scratch[32];
+    switch (field.kind) {
+        case FlightDataField::Kind::Text:
+            writer.field(field.key, field.text(data));
+            break;
+        case FlightDataField::Kind::Integer:
+            writer.field(field.key, static_cast<int>(field.number(data)));
+            break;
+        case FlightDataField::Kind::Number:
+            writer.field(field.key, field.number(data), field.precision);
+            break;
+        case FlightDataField::Kind::Frequency:
+            writer.field(field.key, formatFrequency(field.number(data), scratch));
+            break;
+    }
+}
+
+bool FlightDataEncoder::hasChanged(const FlightDataField& field, const SimConnectFlightData& current, const SimConnectFlightData& previous) {
+    if (field.kind == FlightDataField::Kind::Text) {
+        return field.text(current) != field.text(previous);
+    }
+
+    double a = field.number(current);
+    double b = field.number(previous);
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) != std::isnan(b);
+    }
+    return std::fabs(a - b) >= field.epsilon;
+}
+
+void FlightDataEncoder::writeMetadata(std::string_view simVersion, JsonWriter& writer) {
+    writeTimestamp(writer);
+    writer.field("simulatorVersion", simVersion);
+}
+
+void FlightDataEncoder::writeTimestamp(JsonWriter& writer) {
+    char scratch[32];
+    writer.field("timestamp", formatTimestamp(scratch));
+}
+
+void FlightDataEncoder::writeJson(const SimConnectFlightData& data, std::string_view simVersion, JsonWriter& writer) {
+    writeJson(data, simVersion, FIELD_GROUP_ALL, writer);
+}
+
+void FlightDataEncoder::writeJson(const SimConnectFlightData& data, std::string_view simVersion, uint32_t groups, JsonWriter& writer) {
+    writer.beginObject();
+    for (const auto& field : getFields()) {
+        if (field.group & groups) {
+            writeField(field, data, writer);
+        }
+    }
+    // Every message is timestamped; the simulator version travels with the aircraft metadata
+    writeTimestamp(writer);
+    if (groups & FIELD_GROUP_METADATA) {
+        writer.field("simulatorVersion", simVersion);
+    }
+    writer.endObject();
+}
+
+std::optional<FieldGroup> FlightDataEncoder::parseFieldGroup(std::string_view name) {
+    if (name == "metadata") return FIELD_GROUP_METADATA;
+    if (name == "position") return FIELD_GROUP_POSITION;
+    if (name == "speed") return FIELD_GROUP_SPEED;
+    if (name == "heading") return FIELD_GROUP_HEADING;
+    if (name == "weight") return FIELD_GROUP_WEIGHT;
+    if (name == "radios") return FIELD_GROUP_RADIOS;
+    return std::nullopt;
+}
+
+const char* FlightDataEncoder::getFieldGroupString(FieldGroup group) {
+    switch (group) {
+        case FIELD_GROUP_METADATA: return "metadata";
+        case FIELD_GROUP_POSITION: return "position";
+        case FIELD_GROUP_SPEED: return "speed";
+        case FIELD_GROUP_HEADING: return "heading";
+        case FIELD_GROUP_WEIGHT: return "weight";
+        case FIELD_GROUP_RADIOS: return "radios";
+        default: return "unknown";
+    }
+}
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm_utc, "%Y-%m-%dT%H:%M:%S")
-        << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-    return oss.str();
+// The FlightDataJson member holding each field, by JSON key. Fields without a
+// member (SimVars added to the registry since) are only sent by FlightDataEncoder.
+struct FlightDataJsonMember {
+    const char* key;
+    std::string FlightDataJson::* text;
+    int FlightDataJson::* integer;
+    double FlightDataJson::* number;
+};
+
+static const FlightDataJsonMember* findFlightDataJsonMember(std::string_view key) {
+    using J = FlightDataJson;
+    static const FlightDataJsonMember members[] = {
+        { "aircraftTitle", &J::aircraftTitle, nullptr, nullptr },
+        { "atcType", &J::atcType, nullptr, nullptr },
+        { "atcModel", &J::atcModel, nullptr, nullptr },
+        { "atcId", &J::atcId, nullptr, nullptr },
+        { "atcAirline", &J::atcAirline, nullptr, nullptr },
+        { "atcFlightNumber", &J::atcFlightNumber, nullptr, nullptr },
+        { "category", &J::category, nullptr, nullptr },
+        { "engineTypeStr", &J::engineTypeStr, nullptr, nullptr },
+        { "engineType", nullptr, &J::engineType, nullptr },
+        { "numberOfEngines", nullptr, &J::numberOfEngines, nullptr },
+        { "maxGrossWeightLbs", nullptr, nullptr, &J::maxGrossWeightLbs },
+        { "cruiseSpeedKts", nullptr, nullptr, &J::cruiseSpeedKts },
+        { "emptyWeightLbs", nullptr, nullptr, &J::emptyWeightLbs },
+        { "latitude", nullptr, nullptr, &J::latitude },
+        { "longitude", nullptr, nullptr, &J::longitude },
+        { "altitudeIndicated", nullptr, nullptr, &J::altitudeIndicated },
+        { "altitudeTrue", nullptr, nullptr, &J::altitudeTrue },
+        { "altitudeAGL", nullptr, nullptr, &J::altitudeAGL },
+        { "airspeedIndicated", nullptr, nullptr, &J::airspeedIndicated },
+        { "airspeedTrue", nullptr, nullptr, &J::airspeedTrue },
+        { "groundSpeed", nullptr, nullptr, &J::groundSpeed },
+        { "machNumber", nullptr, nullptr, &J::machNumber },
+        { "headingMagnetic", nullptr, nullptr, &J::headingMagnetic },
+        { "headingTrue", nullptr, nullptr, &J::headingTrue },
+        { "track", nullptr, nullptr, &J::track },
+        { "fuelLbs", nullptr, nullptr, &J::fuelLbs },
+        { "fuelKgs", nullptr, nullptr, &J::fuelKgs },
+        { "payloadLbs", nullptr, nullptr, &J::payloadLbs },
+        { "payloadKgs", nullptr, nullptr, &J::payloadKgs },
+        { "totalWeightLbs", nullptr, nullptr, &J::totalWeightLbs },
+        { "totalWeightKgs", nullptr, nullptr, &J::totalWeightKgs },
+        { "com1Frequency", &J::com1Frequency, nullptr, nullptr },
+        { "com2Frequency", &J::com2Frequency, nullptr, nullptr },
+        { "nav1Frequency", &J::nav1Frequency, nullptr, nullptr },
+        { "nav2Frequency", &J::nav2Frequency, nullptr, nullptr },
+    };
+    for (const auto& member : members) {
+        if (key == member.key) {
+            return &member;
+        }
+    }
+    return nullptr;
+}
+
+FlightDataJson FlightDataJson::fromSimConnect(const SimConnectFlightData& data, const std::string& simVersion) {
+    FlightDataJson json;
+    char scratch[32];
+    for (const auto& field : FlightDataEncoder::getFields()) {
+        const FlightDataJsonMember* member = findFlightDataJsonMember(field.key);
+        if (!member) {
+            continue;
+        }
+        switch (field.kind) {
+            case FlightDataField::Kind::Text:
+                json.*member->text = std::string(field.text(data));
+                break;
+            case FlightDataField::Kind::Integer:
+                json.*member->integer = static_cast<int>(field.number(data));
+                break;
+            case FlightDataField::Kind::Number:
+                json.*member->number = field.number(data);
+                break;
+            case FlightDataField::Kind::Frequency:
+                json.*member->text = std::string(formatFrequency(field.number(data), scratch));
+                break;
+        }
+    }
+    json.timestamp = std::string(formatTimestamp(scratch));
+    json.simulatorVersion = simVersion;
+    return json;
 }
 
 std::string FlightDataJson::toJson() const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(6);
-
-    oss << "{";
-    // Aircraft metadata
-    oss << "\"aircraftTitle\":\"" << aircraftTitle << "\",";
-    oss << "\"atcType\":\"" << atcType << "\",";
-    oss << "\"atcModel\":\"" << atcModel << "\",";
-    oss << "\"atcId\":\"" << atcId << "\",";
-    oss << "\"atcAirline\":\"" << atcAirline << "\",";
-    oss << "\"atcFlightNumber\":\"" << atcFlightNumber << "\",";
-    oss << "\"category\":\"" << category << "\",";
-    oss << "\"engineType\":" << engineType << ",";
-    oss << "\"engineTypeStr\":\"" << engineTypeStr << "\",";
-    oss << "\"numberOfEngines\":" << numberOfEngines << ",";
-    oss << "\"maxGrossWeightLbs\":" << std::setprecision(1) << maxGrossWeightLbs << ",";
-    oss << "\"cruiseSpeedKts\":" << cruiseSpeedKts << ",";
-    oss << "\"emptyWeightLbs\":" << emptyWeightLbs << ",";
-    // Position
-    oss << "\"latitude\":" << std::setprecision(6) << latitude << ",";
-    oss << "\"longitude\":" << longitude << ",";
-    oss << "\"altitudeIndicated\":" << std::setprecision(1) << altitudeIndicated << ",";
-    oss << "\"altitudeTrue\":" << altitudeTrue << ",";
-    oss << "\"altitudeAGL\":" << altitudeAGL << ",";
-    // Speed
-    oss << "\"airspeedIndicated\":" << airspeedIndicated << ",";
-    oss << "\"airspeedTrue\":" << airspeedTrue << ",";
-    oss << "\"groundSpeed\":" << groundSpeed << ",";
-    oss << "\"machNumber\":" << std::setprecision(3) << machNumber << ",";
-    // Heading
-    oss << "\"headingMagnetic\":" << std::setprecision(1) << headingMagnetic << ",";
-    oss << "\"headingTrue\":" << headingTrue << ",";
-    oss << "\"track\":" << track << ",";
-    // Weight & Fuel
-    oss << "\"fuelLbs\":" << fuelLbs << ",";
-    oss << "\"fuelKgs\":" << fuelKgs << ",";
-    oss << "\"payloadLbs\":" << payloadLbs << ",";
-    oss << "\"payloadKgs\":" << payloadKgs << ",";
-    oss << "\"totalWeightLbs\":" << totalWeightLbs << ",";
-    oss << "\"totalWeightKgs\":" << totalWeightKgs << ",";
-    // Radios
-    oss << "\"com1Frequency\":\"" << com1Frequency << "\",";
-    oss << "\"com2Frequency\":\"" << com2Frequency << "\",";
-    oss << "\"nav1Frequency\":\"" << nav1Frequency << "\",";
-    oss << "\"nav2Frequency\":\"" << nav2Frequency << "\",";
-    // Metadata
-    oss << "\"timestamp\":\"" << timestamp << "\",";
-    oss << "\"simulatorVersion\":\"" << simulatorVersion << "\"";
-    oss << "}";
-
-    return oss.str();
+    std::string buffer;
+    JsonWriter writer(buffer);
+    writeJson(writer);
+    return buffer;
+}
+
+void FlightDataJson::writeMessage(std::string& buffer) const {
+    JsonWriter writer(buffer);
+    writer.reset();
+    writer.beginObject();
+    writer.field("type", "flightData");
+    writer.key("data");
+    writeJson(writer);
+    writer.endObject();
+}
+
+void FlightDataJson::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    for (const auto& field : FlightDataEncoder::getFields()) {
+        const FlightDataJsonMember* member = findFlightDataJsonMember(field.key);
+        if (!member) {
+            continue;
+        }
+        switch (field.kind) {
+            case FlightDataField::Kind::Text:
+            case FlightDataField::Kind::Frequency:
+                writer.field(field.key, this->*member->text);
+                break;
+            case FlightDataField::Kind::Integer:
+                writer.field(field.key, this->*member->integer);
+                break;
+            case FlightDataField::Kind::Number:
+                writer.field(field.key, this->*member->number, field.precision);
+                break;
+        }
+    }
+    writer.field("timestamp", timestamp);
+    writer.field("simulatorVersion", simulatorVersion);
+    writer.endObject();
 }
 
 std::string SimulatorStatus::toJson() const {
-    std::ostringstream oss;
+    std::string buffer;
+    JsonWriter writer(buffer);
+    writeJson(writer);
+    return buffer;
+}
 
-    oss << "{";
-    oss << "\"isConnected\":" << (isConnected ? "true" : "false") << ",";
-    oss << "\"isSimRunning\":" << (isSimRunning ? "true" : "false") << ",";
-    oss << "\"simulatorVersion\":\"" << simulatorVersion << "\"";
+void SimulatorStatus::writeJson(JsonWriter& writer) const {
+    writer.beginObject();
+    writer.field("isConnected", isConnected);
+    writer.field("isSimRunning", isSimRunning);
+    writer.field("simulatorVersion", simulatorVersion);
     if (!connectionError.empty()) {
-        oss << ",\"connectionError\":\"" << connectionError << "\"";
+        writer.field("connectionError", connectionError);
     }
-    oss << "}";
+    writer.endObject();
+}
 
-    return oss.str();
+std::string SimulatorStatus::toMessage() const {
+    std::string buffer;
+    JsonWriter writer(buffer);
+    writer.beginObject();
+    writer.field("type", "status");
+    writer.key("data");
+    writeJson(writer);
+    writer.endObject();
+    return buffer;
 }
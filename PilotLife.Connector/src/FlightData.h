@@ -1,69 +1,127 @@
 #pragma once
 
-// Must include winsock2.h before windows.h
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <winsock2.h>
-#include <windows.h>
 #include <string>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
-
-// Forward declaration for SimConnect types
-struct SimConnectFlightData;
-
-// SimConnect Data Definition IDs
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+#include "JsonWriter.h"
+#include "SimVarRegistry.h"
+
+// SimConnect Data Definition IDs, one per SimVarVolatility (same order)
 enum DATA_DEFINE_ID {
-    DEFINITION_FLIGHT_DATA = 0
+    DEFINITION_AIRCRAFT_STATIC = 0,
+    DEFINITION_AIRCRAFT_SLOW = 1,
+    DEFINITION_FLIGHT_FAST = 2
 };
 
-// SimConnect Request IDs
+// SimConnect Request IDs, one per data definition
 enum DATA_REQUEST_ID {
-    REQUEST_FLIGHT_DATA = 0
+    REQUEST_AIRCRAFT_STATIC = 0,
+    REQUEST_AIRCRAFT_SLOW = 1,
+    REQUEST_FLIGHT_FAST = 2
 };
 
-// Structure must match the order of AddToDataDefinition calls EXACTLY
-// SimConnect returns all numeric values as FLOAT64 (double) when units are specified
-// Uses #pragma pack to ensure proper memory alignment with SimConnect
-#pragma pack(push, 1)
+// Merged snapshot of every registry SimVar. Its layout is generated from SIM_VARS
+// (see SimVarRegistry.h); values are read by registry index.
 struct SimConnectFlightData {
-    char title[256];              // TITLE
-    char atcType[64];             // ATC TYPE (aircraft type e.g., "Boeing 737")
-    char atcModel[64];            // ATC MODEL (model variant e.g., "B738")
-    char atcId[64];               // ATC ID (tail number e.g., "N12345")
-    char atcAirline[64];          // ATC AIRLINE (airline name)
-    char atcFlightNumber[64];     // ATC FLIGHT NUMBER
-    char category[256];           // CATEGORY (e.g., "Airplane", "Helicopter")
-    double engineType;            // ENGINE TYPE (0=Piston, 1=Jet, 2=None, 3=Helo, 4=Rocket, 5=Turboprop) - FLOAT64
-    double numberOfEngines;       // NUMBER OF ENGINES - FLOAT64
-    double maxGrossWeight;        // MAX GROSS WEIGHT (pounds)
-    double cruiseSpeed;           // DESIGN CRUISE ALT (knots)
-    double latitude;              // PLANE LATITUDE (degrees)
-    double longitude;             // PLANE LONGITUDE (degrees)
-    double altitudeIndicated;     // INDICATED ALTITUDE (feet)
-    double altitudeTrue;          // PLANE ALTITUDE (feet)
-    double altitudeAGL;           // PLANE ALT ABOVE GROUND (feet)
-    double airspeedIndicated;     // AIRSPEED INDICATED (knots)
-    double airspeedTrue;          // AIRSPEED TRUE (knots)
-    double groundSpeed;           // GROUND VELOCITY (knots)
-    double machNumber;            // AIRSPEED MACH
-    double headingMagnetic;       // HEADING INDICATOR (degrees)
-    double headingTrue;           // PLANE HEADING DEGREES TRUE (degrees)
-    double gpsGroundTrack;        // GPS GROUND TRUE TRACK (degrees)
-    double fuelTotalQuantity;     // FUEL TOTAL QUANTITY (gallons)
-    double fuelWeightPerGallon;   // FUEL WEIGHT PER GALLON (pounds)
-    double totalWeight;           // TOTAL WEIGHT (pounds)
-    double emptyWeight;           // EMPTY WEIGHT (pounds)
-    double com1ActiveFreq;        // COM ACTIVE FREQUENCY:1 (Hz) - FLOAT64
-    double com2ActiveFreq;        // COM ACTIVE FREQUENCY:2 (Hz) - FLOAT64
-    double nav1ActiveFreq;        // NAV ACTIVE FREQUENCY:1 (Hz) - FLOAT64
-    double nav2ActiveFreq;        // NAV ACTIVE FREQUENCY:2 (Hz) - FLOAT64
+    unsigned char bytes[SIM_VAR_BLOCK_SIZE];
+
+    // Value of a Float64 SimVar
+    double number(size_t index) const {
+        double value;
+        std::memcpy(&value, bytes + SIM_VAR_OFFSETS[index], sizeof(value));
+        return value;
+    }
+
+    // Value of a string SimVar, without copying it
+    std::string_view text(size_t index) const {
+        const char* str = reinterpret_cast<const char*>(bytes + SIM_VAR_OFFSETS[index]);
+        size_t size = simVarSize(SIM_VARS[index].type);
+        return std::string_view(str, std::find(str, str + size, '\0') - str);
+    }
+
+    // Writers for tools and tests that build samples without a simulator
+    void setNumber(size_t index, double value) {
+        std::memcpy(bytes + SIM_VAR_OFFSETS[index], &value, sizeof(value));
+    }
+
+    void setText(size_t index, std::string_view value) {
+        size_t size = simVarSize(SIM_VARS[index].type);
+        size_t length = std::min(value.size(), size - 1);
+        std::memcpy(bytes + SIM_VAR_OFFSETS[index], value.data(), length);
+        std::memset(bytes + SIM_VAR_OFFSETS[index] + length, 0, size - length);
+    }
+};
+
+static_assert(sizeof(SimConnectFlightData) == SIM_VAR_BLOCK_SIZE, "Receive buffer must match the SimVar registry");
+
+// One field of the flightData message: a registry SimVar read at its offset,
+// or a value derived from other SimVars
+struct FlightDataField {
+    using Kind = FieldKind;
+
+    const char* key;
+    FieldGroup group;
+    Kind kind;
+    int precision;      // Decimal places for Number
+    double epsilon;     // Smallest change worth sending in a delta
+    size_t simVar;      // Registry index for SimVar fields
+
+    // Set for derived fields only
+    std::string_view (*derivedText)(const SimConnectFlightData& data);
+    double (*derivedNumber)(const SimConnectFlightData& data);
+
+    std::string_view text(const SimConnectFlightData& data) const {
+        return derivedText ? derivedText(data) : data.text(simVar);
+    }
+
+    double number(const SimConnectFlightData& data) const {
+        return derivedNumber ? derivedNumber(data) : data.number(simVar);
+    }
 };
-#pragma pack(pop)
 
-// JSON-serializable flight data for WebSocket transmission
+// Writes the flightData wire message straight from the SimConnect data block.
+// Registry fields are read at precomputed offsets; fuel, payload and kg
+// conversions are computed inline, so nothing is copied per tick.
+struct FlightDataEncoder {
+    // Write the full {"type":"flightData","data":{...}} message into a reusable buffer
+    static void writeMessage(const SimConnectFlightData& data, std::string_view simVersion, std::string& buffer);
+
+    // Write a flightData message containing only the given field groups
+    static void writeMessage(const SimConnectFlightData& data, std::string_view simVersion, uint32_t groups, std::string& buffer);
+
+    // Write only the data object into an existing JSON writer
+    static void writeJson(const SimConnectFlightData& data, std::string_view simVersion, JsonWriter& writer);
+    static void writeJson(const SimConnectFlightData& data, std::string_view simVersion, uint32_t groups, JsonWriter& writer);
+
+    // All fields in wire order (timestamp and simulatorVersion are appended separately)
+    static const std::vector<FlightDataField>& getFields();
+
+    // Write one field's key and value
+    static void writeField(const FlightDataField& field, const SimConnectFlightData& data, JsonWriter& writer);
+
+    // Whether a field differs between two samples by more than its epsilon
+    static bool hasChanged(const FlightDataField& field, const SimConnectFlightData& current, const SimConnectFlightData& previous);
+
+    // Write the timestamp and simulatorVersion fields
+    static void writeMetadata(std::string_view simVersion, JsonWriter& writer);
+    static void writeTimestamp(JsonWriter& writer);
+
+    // Field group names used by subscribeTelemetry ("position", "radios", ...)
+    static std::optional<FieldGroup> parseFieldGroup(std::string_view name);
+    static const char* getFieldGroupString(FieldGroup group);
+};
+
+// Decoded flight data with one member per flightData field.
+// Kept for callers that want named values; it is filled and serialized through
+// FlightDataEncoder's field table, so the registry stays the only layout. The
+// telemetry path encodes straight from SimConnectFlightData instead.
 struct FlightDataJson {
     // Aircraft metadata
     std::string aircraftTitle;
@@ -74,37 +132,37 @@ struct FlightDataJson {
     std::string atcFlightNumber;
     std::string category;
     std::string engineTypeStr;
-    int engineType;
-    int numberOfEngines;
-    double maxGrossWeightLbs;
-    double cruiseSpeedKts;
-    double emptyWeightLbs;
+    int engineType = 0;
+    int numberOfEngines = 0;
+    double maxGrossWeightLbs = 0.0;
+    double cruiseSpeedKts = 0.0;
+    double emptyWeightLbs = 0.0;
 
     // Position
-    double latitude;
-    double longitude;
-    double altitudeIndicated;
-    double altitudeTrue;
-    double altitudeAGL;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double altitudeIndicated = 0.0;
+    double altitudeTrue = 0.0;
+    double altitudeAGL = 0.0;
 
     // Speed
-    double airspeedIndicated;
-    double airspeedTrue;
-    double groundSpeed;
-    double machNumber;
+    double airspeedIndicated = 0.0;
+    double airspeedTrue = 0.0;
+    double groundSpeed = 0.0;
+    double machNumber = 0.0;
 
     // Heading
-    double headingMagnetic;
-    double headingTrue;
-    double track;
+    double headingMagnetic = 0.0;
+    double headingTrue = 0.0;
+    double track = 0.0;
 
     // Weight & Fuel
-    double fuelLbs;
-    double fuelKgs;
-    double payloadLbs;
-    double payloadKgs;
-    double totalWeightLbs;
-    double totalWeightKgs;
+    double fuelLbs = 0.0;
+    double fuelKgs = 0.0;
+    double payloadLbs = 0.0;
+    double payloadKgs = 0.0;
+    double totalWeightLbs = 0.0;
+    double totalWeightKgs = 0.0;
 
     // Radios
     std::string com1Frequency;
@@ -122,12 +180,11 @@ struct FlightDataJson {
     // Serialize to JSON string
     std::string toJson() const;
 
-private:
-    // Helper to format frequency from Hz to MHz string (e.g., 118700000 -> "118.700")
-    static std::string formatFrequency(double freqHz);
+    // Write the data object into an existing JSON writer
+    void writeJson(JsonWriter& writer) const;
 
-    // Helper to get current UTC timestamp in ISO 8601 format
-    static std::string getCurrentTimestamp();
+    // Write the full {"type":"flightData","data":{...}} message into a reusable buffer
+    void writeMessage(std::string& buffer) const;
 };
 
 // Simulator connection status
@@ -138,4 +195,8 @@ struct SimulatorStatus {
     std::string connectionError;
 
     std::string toJson() const;
+    void writeJson(JsonWriter& writer) const;
+
+    // Full {"type":"status","data":{...}} message
+    std::string toMessage() const;
 };
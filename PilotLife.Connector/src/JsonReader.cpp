@@ -0,0 +1,278 @@
+#include "JsonReader.h"
+#include <cstring>
+
+bool JsonReader::parse(std::string_view json, Handler& handler) {
+    if (json.substr(0, 3) == "\xEF\xBB\xBF") {
+        json.remove_prefix(3);
+    }
+
+    JsonReader reader(json, handler);
+    reader.skipWhitespace();
+    if (!reader.parseValue(0)) {
+        return false;
+    }
+    reader.skipWhitespace();
+    return reader.m_pos == json.size();
+}
+
+bool JsonReader::parseValue(int depth) {
+    if (m_pos >= m_json.size()) {
+        return false;
+    }
+
+    switch (m_json[m_pos]) {
+        case '{':
+            return parseObject(depth + 1);
+        case '[':
+            return parseArray(depth + 1);
+        case '"': {
+            std::string_view value;
+            return parseString(value) && m_handler.string(value);
+        }
+        case 't':
+            return parseLiteral("true") && m_handler.boolean(true);
+        case 'f':
+            return parseLiteral("false") && m_handler.boolean(false);
+        case 'n':
+            return parseLiteral("null") && m_handler.null();
+        default:
+            return parseNumber();
+    }
+}
+
+bool JsonReader::parseObject(int depth) {
+    if (depth > MAX_DEPTH || !m_handler.beginObject()) {
+        return false;
+    }
+    m_pos++;  // '{'
+
+    skipWhitespace();
+    if (m_pos < m_json.size() && m_json[m_pos] == '}') {
+        m_pos++;
+        return m_handler.endObject();
+    }
+
+    for (;;) {
+        skipWhitespace();
+        std::string_view name;
+        if (m_pos >= m_json.size() || m_json[m_pos] != '"' || !parseString(name) || !m_handler.key(name)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_json.size() || m_json[m_pos] != ':') {
+            return false;
+        }
+        m_pos++;
+
+        skipWhitespace();
+        if (!parseValue(depth)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_json.size()) {
+            return false;
+        }
+        char c = m_json[m_pos++];
+        if (c == '}') {
+            return m_handler.endObject();
+        }
+        if (c != ',') {
+            return false;
+        }
+    }
+}
+
+bool JsonReader::parseArray(int depth) {
+    if (depth > MAX_DEPTH || !m_handler.beginArray()) {
+        return false;
+    }
+    m_pos++;  // '['
+
+    skipWhitespace();
+    if (m_pos < m_json.size() && m_json[m_pos] == ']') {
+        m_pos++;
+        return m_handler.endArray();
+    }
+
+    for (;;) {
+        skipWhitespace();
+        if (!parseValue(depth)) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_json.size()) {
+            return false;
+        }
+        char c = m_json[m_pos++];
+        if (c == ']') {
+            return m_handler.endArray();
+        }
+        if (c != ',') {
+            return false;
+        }
+    }
+}
+
+bool JsonReader::parseString(std::string_view& value) {
+    size_t start = ++m_pos;  // Past the opening quote
+
+    // Common case: no escapes, so the value is a view into the input. Two memchr
+    // passes (vectorized) beat testing each character against both '"' and '\\'.
+    const char* data = m_json.data();
+    const char* quote = static_cast<const char*>(std::memchr(data + start, '"', m_json.size() - start));
+    if (!quote) {
+        return false;
+    }
+    const char* backslash = static_cast<const char*>(std::memchr(data + start, '\\', quote - (data + start)));
+    size_t end = static_cast<size_t>((backslash ? backslash : quote) - data);
+    if (m_json[end] == '"') {
+        value = m_json.substr(start, end - start);
+        m_pos = end + 1;
+        return true;
+    }
+
+    m_scratch.assign(m_json.data() + start, end - start);
+    m_pos = end;
+    while (m_pos < m_json.size()) {
+        char c = m_json[m_pos++];
+        if (c == '"') {
+            value = m_scratch;
+            return true;
+        }
+        if (c != '\\') {
+            m_scratch.push_back(c);
+            continue;
+        }
+        if (m_pos >= m_json.size()) {
+            return false;
+        }
+
+        char escape = m_json[m_pos++];
+        switch (escape) {
+            case '"': m_scratch.push_back('"'); break;
+            case '\\': m_scratch.push_back('\\'); break;
+            case '/': m_scratch.push_back('/'); break;
+            case 'b': m_scratch.push_back('\b'); break;
+            case 'f': m_scratch.push_back('\f'); break;
+            case 'n': m_scratch.push_back('\n'); break;
+            case 'r': m_scratch.push_back('\r'); break;
+            case 't': m_scratch.push_back('\t'); break;
+            case 'u': {
+                auto readHex = [this](unsigned& out) {
+                    if (m_pos + 4 > m_json.size()) return false;
+                    out = 0;
+                    for (int i = 0; i < 4; i++) {
+                        char h = m_json[m_pos++];
+                        out <<= 4;
+                        if (h >= '0' && h <= '9') out |= h - '0';
+                        else if (h >= 'a' && h <= 'f') out |= h - 'a' + 10;
+                        else if (h >= 'A' && h <= 'F') out |= h - 'A' + 10;
+                        else return false;
+                    }
+                    return true;
+                };
+                unsigned codePoint;
+                if (!readHex(codePoint)) {
+                    return false;
+                }
+                // A surrogate is only valid as a high one followed by \uDC00-\uDFFF; a lone
+                // half has no UTF-8 encoding, so the document is rejected
+                if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    return false;
+                }
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    unsigned low;
+                    if (m_json.substr(m_pos, 2) != "\\u") {
+                        return false;
+                    }
+                    m_pos += 2;
+                    if (!readHex(low) || low < 0xDC00 || low > 0xDFFF) {
+                        return false;
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(m_scratch, codePoint);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+bool JsonReader::parseNumber() {
+    // RFC 8259: [ "-" ] ( "0" / [1-9] *DIGIT ) [ "." 1*DIGIT ] [ ( "e" / "E" ) [ "-" / "+" ] 1*DIGIT ]
+    size_t start = m_pos;
+    auto peek = [this]() { return m_pos < m_json.size() ? m_json[m_pos] : '\0'; };
+    auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    auto digits = [&]() {
+        size_t first = m_pos;
+        while (isDigit(peek())) {
+            m_pos++;
+        }
+        return m_pos > first;
+    };
+
+    if (peek() == '-') {
+        m_pos++;
+    }
+    if (peek() == '0') {
+        m_pos++;    // No leading zeros; a digit after it ends the number and fails in the caller
+    } else if (!digits()) {
+        return false;
+    }
+    if (peek() == '.') {
+        m_pos++;
+        if (!digits()) {
+            return false;
+        }
+    }
+    if (peek() == 'e' || peek() == 'E') {
+        m_pos++;
+        if (peek() == '-' || peek() == '+') {
+            m_pos++;
+        }
+        if (!digits()) {
+            return false;
+        }
+    }
+    return m_handler.number(m_json.substr(start, m_pos - start));
+}
+
+bool JsonReader::parseLiteral(std::string_view literal) {
+    if (m_json.substr(m_pos, literal.size()) != literal) {
+        return false;
+    }
+    m_pos += literal.size();
+    return true;
+}
+
+void JsonReader::skipWhitespace() {
+    while (m_pos < m_json.size()) {
+        char c = m_json[m_pos];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+        m_pos++;
+    }
+}
+
+void JsonReader::appendUtf8(std::string& out, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
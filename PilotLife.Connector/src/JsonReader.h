@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Forward-only JSON parser in the SAX style: walks a document once and reports
+// each token to a handler instead of building a tree. Strings without escapes
+// are passed as views into the input; escaped ones are decoded into a scratch
+// buffer, so a view is only valid during the callback that receives it.
+//
+// Numbers follow the RFC 8259 grammar and escapes must decode to valid code
+// points (no unpaired surrogates). Raw control characters and invalid UTF-8
+// inside strings are passed through rather than rejected, so a hand-edited
+// package manifest with a stray tab still parses.
+class JsonReader {
+public:
+    // Override the events of interest. Returning false stops the parse.
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+
+        virtual bool beginObject() { return true; }
+        virtual bool endObject() { return true; }
+        virtual bool beginArray() { return true; }
+        virtual bool endArray() { return true; }
+
+        // Object member name; the next event is its value
+        virtual bool key(std::string_view) { return true; }
+
+        virtual bool string(std::string_view) { return true; }
+        virtual bool number(std::string_view) { return true; }  // Unparsed number text
+        virtual bool boolean(bool) { return true; }
+        virtual bool null() { return true; }
+    };
+
+    // Parse one JSON document (a leading UTF-8 BOM is skipped). Returns false if it is
+    // malformed or nested too deeply, or if the handler stopped early.
+    static bool parse(std::string_view json, Handler& handler);
+
+private:
+    static constexpr int MAX_DEPTH = 64;
+
+    JsonReader(std::string_view json, Handler& handler) : m_json(json), m_handler(handler) {}
+
+    bool parseValue(int depth);
+    bool parseObject(int depth);
+    bool parseArray(int depth);
+    bool parseString(std::string_view& value);
+    bool parseNumber();
+    bool parseLiteral(std::string_view literal);
+
+    void skipWhitespace();
+    static void appendUtf8(std::string& out, unsigned codePoint);
+
+    std::string_view m_json;
+    size_t m_pos = 0;
+    Handler& m_handler;
+    std::string m_scratch;  // Decoded text of the last escaped string
+};
@@ -0,0 +1,144 @@
+#include "JsonWriter.h"
+#include <charconv>
+#include <cmath>
+
+void JsonWriter::reset() {
+    m_buffer.clear();
+    m_depth = 0;
+    m_hasElement[0] = false;
+    m_afterKey = false;
+}
+
+void JsonWriter::separator() {
+    if (m_afterKey) {
+        // Value directly follows its key
+        m_afterKey = false;
+        return;
+    }
+    if (m_hasElement[m_depth]) {
+        m_buffer.push_back(',');
+    }
+    m_hasElement[m_depth] = true;
+}
+
+void JsonWriter::beginObject() {
+    separator();
+    m_buffer.push_back('{');
+    if (m_depth < MAX_DEPTH - 1) {
+        m_depth++;
+    }
+    m_hasElement[m_depth] = false;
+}
+
+void JsonWriter::endObject() {
+    m_buffer.push_back('}');
+    if (m_depth > 0) {
+        m_depth--;
+    }
+}
+
+void JsonWriter::beginArray() {
+    separator();
+    m_buffer.push_back('[');
+    if (m_depth < MAX_DEPTH - 1) {
+        m_depth++;
+    }
+    m_hasElement[m_depth] = false;
+}
+
+void JsonWriter::endArray() {
+    m_buffer.push_back(']');
+    if (m_depth > 0) {
+        m_depth--;
+    }
+}
+
+void JsonWriter::key(std::string_view name) {
+    separator();
+    m_buffer.push_back('"');
+    appendEscaped(m_buffer, name);
+    m_buffer.append("\":", 2);
+    m_afterKey = true;
+}
+
+void JsonWriter::value(std::string_view str) {
+    separator();
+    m_buffer.push_back('"');
+    appendEscaped(m_buffer, str);
+    m_buffer.push_back('"');
+}
+
+void JsonWriter::value(double number, int precision) {
+    separator();
+
+    // JSON has no representation for NaN/Infinity
+    if (!std::isfinite(number)) {
+        m_buffer.append("null", 4);
+        return;
+    }
+
+    // Large enough for any fixed-format double SimConnect will realistically hand us;
+    // fall back to scientific notation if it does not fit
+    char buf[128];
+    auto result = std::to_chars(buf, buf + sizeof(buf), number, std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+        result = std::to_chars(buf, buf + sizeof(buf), number, std::chars_format::scientific, precision);
+    }
+    m_buffer.append(buf, result.ptr - buf);
+}
+
+void JsonWriter::value(int64_t number) {
+    separator();
+    char buf[24];
+    auto result = std::to_chars(buf, buf + sizeof(buf), number);
+    m_buffer.append(buf, result.ptr - buf);
+}
+
+void JsonWriter::value(bool boolean) {
+    separator();
+    if (boolean) {
+        m_buffer.append("true", 4);
+    } else {
+        m_buffer.append("false", 5);
+    }
+}
+
+void JsonWriter::null() {
+    separator();
+    m_buffer.append("null", 4);
+}
+
+void JsonWriter::rawValue(std::string_view json) {
+    separator();
+    m_buffer.append(json.data(), json.size());
+}
+
+void JsonWriter::appendEscaped(std::string& out, std::string_view str) {
+    static const char HEX[] = "0123456789abcdef";
+
+    // Copy runs of characters that need no escaping in one append
+    size_t runStart = 0;
+    for (size_t i = 0; i < str.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.append(str.data() + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"': out.append("\\\"", 2); break;
+            case '\\': out.append("\\\\", 2); break;
+            case '\n': out.append("\\n", 2); break;
+            case '\r': out.append("\\r", 2); break;
+            case '\t': out.append("\\t", 2); break;
+            case '\b': out.append("\\b", 2); break;
+            case '\f': out.append("\\f", 2); break;
+            default: {
+                char esc[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF] };
+                out.append(esc, 6);
+                break;
+            }
+        }
+    }
+    out.append(str.data() + runStart, str.size() - runStart);
+}
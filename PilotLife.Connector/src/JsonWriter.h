@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+// Append-only JSON writer over a caller-owned buffer.
+// The buffer is never shrunk, so reusing the same std::string across ticks
+// means no heap allocations once it has grown to the largest message size.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& buffer) : m_buffer(buffer) {}
+
+    // Clear the buffer (keeps its capacity) and reset nesting state
+    void reset();
+
+    // Structure
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    // Write an object key; the next value call supplies its value
+    void key(std::string_view name);
+
+    // Values
+    void value(std::string_view str);
+    void value(const char* str) { value(std::string_view(str)); }
+    void value(const std::string& str) { value(std::string_view(str)); }
+    void value(double number, int precision);
+    void value(int64_t number);
+    void value(int number) { value(static_cast<int64_t>(number)); }
+    void value(size_t number) { value(static_cast<int64_t>(number)); }
+    void value(bool boolean);
+    void null();
+
+    // Write an already-serialized JSON value verbatim
+    void rawValue(std::string_view json);
+
+    // Key/value shorthands
+    template <typename T>
+    void field(std::string_view name, const T& v) { key(name); value(v); }
+    void field(std::string_view name, double number, int precision) { key(name); value(number, precision); }
+
+    // Append a JSON-escaped string (without quotes) to any buffer
+    static void appendEscaped(std::string& out, std::string_view str);
+
+    const std::string& str() const { return m_buffer; }
+
+private:
+    // Emit a separating comma if this is not the first element at this depth
+    void separator();
+
+    static constexpr int MAX_DEPTH = 32;
+
+    std::string& m_buffer;
+    int m_depth = 0;
+    bool m_hasElement[MAX_DEPTH] = {};
+    bool m_afterKey = false;
+};
@@ -0,0 +1,68 @@
+#include "LatencyHistogram.h"
+#include "JsonWriter.h"
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration latency) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    uint64_t value = micros > 0 ? static_cast<uint64_t>(micros) : 0;
+
+    // Bucket = number of significant bits, so each bucket spans twice the previous one
+    size_t bucket = 0;
+    for (uint64_t rest = value; rest != 0 && bucket < BUCKET_COUNT - 1; rest >>= 1) {
+        bucket++;
+    }
+
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalMicros.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t max = m_maxMicros.load(std::memory_order_relaxed);
+    while (value > max && !m_maxMicros.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+double LatencyHistogram::quantileMs(double quantile) const {
+    uint64_t total = 0;
+    uint64_t counts[BUCKET_COUNT];
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+
+    // Smallest bucket whose cumulative count reaches the quantile's rank
+    uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return static_cast<double>(uint64_t(1) << i) / 1000.0;
+        }
+    }
+    return static_cast<double>(uint64_t(1) << (BUCKET_COUNT - 1)) / 1000.0;
+}
+
+void LatencyHistogram::writeJson(JsonWriter& json) const {
+    uint64_t count = this->count();
+
+    json.beginObject();
+    json.field("count", static_cast<int64_t>(count));
+    json.field("meanMs", count ? m_totalMicros.load(std::memory_order_relaxed) / 1000.0 / count : 0.0, 3);
+    json.field("p50Ms", quantileMs(0.50), 3);
+    json.field("p90Ms", quantileMs(0.90), 3);
+    json.field("p99Ms", quantileMs(0.99), 3);
+    json.field("maxMs", m_maxMicros.load(std::memory_order_relaxed) / 1000.0, 3);
+
+    size_t used = BUCKET_COUNT;
+    while (used > 0 && m_buckets[used - 1].load(std::memory_order_relaxed) == 0) {
+        used--;
+    }
+    json.key("buckets");
+    json.beginArray();
+    for (size_t i = 0; i < used; i++) {
+        json.value(static_cast<int64_t>(m_buckets[i].load(std::memory_order_relaxed)));
+    }
+    json.endArray();
+    json.endObject();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+class JsonWriter;
+
+// Distribution of latencies in power-of-two microsecond buckets: bucket 0 counts
+// samples under 1 us and bucket i (i > 0) those in [2^(i-1), 2^i) us. Recording
+// is a few relaxed atomic adds, so any number of threads can share one histogram
+// without a lock; a reader sees each counter exactly, though not necessarily all
+// of them at the same instant, which is fine for monitoring.
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 32;  // The last bucket also takes everything above 2^30 us
+
+    void record(std::chrono::steady_clock::duration latency);
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given quantile (0..1), in milliseconds; 0 if empty
+    double quantileMs(double quantile) const;
+
+    // {"count", "meanMs", "p50Ms", "p90Ms", "p99Ms", "maxMs", "buckets": [...]}; buckets
+    // stops at the last non-empty one
+    void writeJson(JsonWriter& json) const;
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT] = {};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_totalMicros{0};
+    std::atomic<uint64_t> m_maxMicros{0};
+};
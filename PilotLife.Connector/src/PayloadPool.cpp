@@ -0,0 +1,32 @@
+#include "PayloadPool.h"
+#include <atomic>
+
+PayloadPool::PayloadPool(size_t maxBuffers)
+    : m_maxBuffers(maxBuffers)
+{
+    m_buffers.reserve(maxBuffers);
+}
+
+std::shared_ptr<std::string> PayloadPool::acquire() {
+    // Round-robin from the last buffer handed out: the oldest payloads are the
+    // likeliest to have been sent (or coalesced) and released by every client
+    for (size_t i = 0; i < m_buffers.size(); i++) {
+        size_t index = (m_next + i) % m_buffers.size();
+        std::shared_ptr<std::string>& buffer = m_buffers[index];
+        if (buffer.use_count() == 1) {
+            // use_count() is a relaxed load; pair it with the release in the last
+            // client's decrement so its reads of the old message happen before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+            m_next = index + 1;
+            buffer->clear();
+            return buffer;
+        }
+    }
+
+    auto buffer = std::make_shared<std::string>();
+    if (m_buffers.size() < m_maxBuffers) {
+        m_buffers.push_back(buffer);
+        m_next = m_buffers.size();
+    }
+    return buffer;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Recycles the buffers of a message stream that is serialized and shared every tick
+// (telemetry). A buffer is handed out again once every client queue holding it has
+// let go, so a steady stream reuses a few grown buffers instead of copying each
+// message into a fresh allocation.
+//
+// acquire() is called from one thread (the publisher); clients may release their
+// references from any thread.
+class PayloadPool {
+public:
+    // maxBuffers bounds how many buffers are kept; while clients still hold all of
+    // them, acquire() falls back to an unpooled buffer
+    explicit PayloadPool(size_t maxBuffers = 8);
+
+    // An empty buffer no client holds (capacity kept). Serialize into it, then share
+    // it as an immutable payload (WebSocketServer::Payload); do not write to it after.
+    std::shared_ptr<std::string> acquire();
+
+    // Buffers currently kept by the pool
+    size_t size() const { return m_buffers.size(); }
+
+private:
+    size_t m_maxBuffers;
+    size_t m_next = 0;  // Where the next scan for a free buffer starts
+    std::vector<std::shared_ptr<std::string>> m_buffers;
+};
@@ -0,0 +1,128 @@
+#include "RequestExecutor.h"
+#include <algorithm>
+
+RequestExecutor::RequestExecutor(size_t workerCount, size_t maxInFlightPerClient, size_t maxQueued)
+    : m_maxInFlightPerClient(maxInFlightPerClient)
+    , m_maxQueued(maxQueued)
+{
+    workerCount = std::max<size_t>(workerCount, 1);
+    for (size_t i = 0; i < workerCount; i++) {
+        m_workers.emplace_back(&RequestExecutor::workerLoop, this);
+    }
+}
+
+RequestExecutor::~RequestExecutor() {
+    stop();
+}
+
+bool RequestExecutor::submit(const std::string& clientId, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_queued >= m_maxQueued) {
+            return false;
+        }
+
+        ClientQueue& client = m_clients[clientId];
+        if (client.inFlight >= m_maxInFlightPerClient) {
+            if (client.inFlight == 0) m_clients.erase(clientId);
+            return false;
+        }
+
+        client.pending.push_back(std::move(task));
+        client.inFlight++;
+        m_queued++;
+        m_inFlight++;
+        if (client.scheduled) {
+            // Runs after the client's earlier tasks
+            return true;
+        }
+        client.scheduled = true;
+        m_ready.push_back(clientId);
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+void RequestExecutor::complete(const std::string& clientId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_clients.find(clientId);
+    if (it == m_clients.end() || it->second.inFlight == 0) {
+        return;
+    }
+
+    it->second.inFlight--;
+    m_inFlight--;
+    if (it->second.inFlight == 0 && !it->second.scheduled) {
+        m_clients.erase(it);
+    }
+}
+
+void RequestExecutor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return;
+        }
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_clients.clear();
+    m_ready.clear();
+    m_queued = 0;
+    m_inFlight = 0;
+}
+
+size_t RequestExecutor::getQueuedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queued;
+}
+
+size_t RequestExecutor::getInFlightCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_inFlight;
+}
+
+void RequestExecutor::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] { return m_stopping || !m_ready.empty(); });
+        if (m_stopping) {
+            return;
+        }
+
+        std::string clientId = std::move(m_ready.front());
+        m_ready.pop_front();
+        ClientQueue& client = m_clients[clientId];
+        Task task = std::move(client.pending.front());
+        client.pending.pop_front();
+        m_queued--;
+
+        lock.unlock();
+        task();
+        task = nullptr;  // Release captures before taking the lock again
+        lock.lock();
+
+        // The task may have completed its request (and others), so look the client up again
+        auto it = m_clients.find(clientId);
+        if (it == m_clients.end()) {
+            continue;
+        }
+        if (!it->second.pending.empty()) {
+            // Back of the line: clients with work take turns on the workers
+            m_ready.push_back(std::move(clientId));
+            m_condition.notify_one();
+        } else {
+            it->second.scheduled = false;
+            if (it->second.inFlight == 0) {
+                m_clients.erase(it);
+            }
+        }
+    }
+}
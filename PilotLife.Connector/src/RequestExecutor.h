@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Runs client requests on a fixed pool of worker threads instead of the socket
+// threads they arrive on, so a slow request never stalls a connection.
+//
+// Each client's tasks run one at a time, in the order they were submitted (a
+// strand per client); different clients run in parallel, taking turns when there
+// are more clients with work than workers. A request can outlive its task, e.g.
+// when the task hands work to another thread and replies from there: it stays in
+// flight until complete() is called, and each client may have at most
+// maxInFlightPerClient requests in flight. maxQueued bounds the tasks waiting
+// across all clients.
+class RequestExecutor {
+public:
+    using Task = std::function<void()>;
+
+    RequestExecutor(size_t workerCount, size_t maxInFlightPerClient, size_t maxQueued);
+    ~RequestExecutor();
+
+    // Queue a request's task. Returns false (and drops the task) if the client already has
+    // maxInFlightPerClient requests in flight, the queue is full, or the executor was stopped.
+    bool submit(const std::string& clientId, Task task);
+
+    // A request submitted for this client has been answered; call exactly once per accepted
+    // submit (until stop(), after which it does nothing)
+    void complete(const std::string& clientId);
+
+    // Drop the tasks still queued and join the workers; submit() fails afterwards. Requests
+    // that were queued or still waiting to be answered are abandoned without a reply: stop
+    // the server that delivers replies first, so there is nobody left to answer.
+    void stop();
+
+    // Tasks waiting for a worker, and requests accepted but not completed
+    size_t getQueuedCount() const;
+    size_t getInFlightCount() const;
+
+private:
+    struct ClientQueue {
+        std::deque<Task> pending;
+        size_t inFlight = 0;    // Accepted, not yet completed (queued, running or answering later)
+        bool scheduled = false; // In m_ready or running on a worker
+    };
+
+    void workerLoop();
+
+    const size_t m_maxInFlightPerClient;
+    const size_t m_maxQueued;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::unordered_map<std::string, ClientQueue> m_clients;  // Only clients with requests in flight
+    std::deque<std::string> m_ready;                         // Clients whose next task can run, oldest first
+    size_t m_queued = 0;
+    size_t m_inFlight = 0;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
@@ -1,7 +1,14 @@
 #include "SimConnectManager.h"
+#include <cstring>
 #include <iostream>
 
-SimConnectManager::SimConnectManager() {}
+// Upper bound on how long the dispatch thread sleeps without a message or wake-up
+constexpr std::chrono::milliseconds DISPATCH_WAIT_TIMEOUT{1000};
+
+SimConnectManager::SimConnectManager(MessageSourceFactory openSource)
+    : m_openSource(std::move(openSource))
+{
+}
 
 SimConnectManager::~SimConnectManager() {
     stopDispatchLoop();
@@ -13,154 +20,58 @@ bool SimConnectManager::connect(const std::string& appName) {
         return true;
     }
 
-    HRESULT hr = SimConnect_Open(
-        &m_hSimConnect,
-        appName.c_str(),
-        nullptr,    // hWnd - not using window messages
-        0,          // UserEventWin32
-        nullptr,    // hEventHandle
-        0           // ConfigIndex - use default
-    );
-
-    if (SUCCEEDED(hr)) {
-        m_connected = true;
-        setupDataDefinitions();
-        requestPeriodicData();
-        return true;
+    // A session the sim ended on its own (quit) is still installed with its
+    // loop running; tear it down before opening a new one
+    stopDispatchLoop();
+    disconnect();
+
+    auto source = m_openSource ? m_openSource(appName) : nullptr;
+    if (!source) {
+        return false;
     }
 
-    std::cerr << "Failed to connect to SimConnect. HRESULT: " << hr << std::endl;
-    return false;
+    m_receivedBlocks = 0;
+    m_telemetryRateChanged = false;
+    source->requestTelemetryRate(m_telemetryRate);
+    setMessageSource(std::move(source));
+    m_connected = true;
+    return true;
 }
 
 void SimConnectManager::disconnect() {
-    if (m_hSimConnect) {
-        SimConnect_Close(m_hSimConnect);
-        m_hSimConnect = nullptr;
-        m_connected = false;
-    }
+    // Destroying the source closes the connection
+    setMessageSource(nullptr);
+    m_connected = false;
 }
 
-void SimConnectManager::setupDataDefinitions() {
-    // Define all the SimVars we want to receive
-    // Order MUST match SimConnectFlightData struct in FlightData.h
-
-    // Aircraft metadata (strings)
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "TITLE", nullptr, SIMCONNECT_DATATYPE_STRING256);
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "ATC TYPE", nullptr, SIMCONNECT_DATATYPE_STRING64);
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "ATC MODEL", nullptr, SIMCONNECT_DATATYPE_STRING64);
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "ATC ID", nullptr, SIMCONNECT_DATATYPE_STRING64);
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "ATC AIRLINE", nullptr, SIMCONNECT_DATATYPE_STRING64);
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "ATC FLIGHT NUMBER", nullptr, SIMCONNECT_DATATYPE_STRING64);
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "CATEGORY", nullptr, SIMCONNECT_DATATYPE_STRING256);
-
-    // Aircraft metadata (numeric)
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "ENGINE TYPE", "enum");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "NUMBER OF ENGINES", "number");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "MAX GROSS WEIGHT", "pounds");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "DESIGN CRUISE ALT", "knots");
-
-    // Position
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "PLANE LATITUDE", "degrees");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "PLANE LONGITUDE", "degrees");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "INDICATED ALTITUDE", "feet");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "PLANE ALTITUDE", "feet");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "PLANE ALT ABOVE GROUND", "feet");
-
-    // Speed
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "AIRSPEED INDICATED", "knots");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "AIRSPEED TRUE", "knots");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "GROUND VELOCITY", "knots");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "AIRSPEED MACH", "mach");
-
-    // Heading
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "HEADING INDICATOR", "degrees");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "PLANE HEADING DEGREES TRUE", "degrees");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "GPS GROUND TRUE TRACK", "degrees");
-
-    // Fuel & Weight
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "FUEL TOTAL QUANTITY", "gallons");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "FUEL WEIGHT PER GALLON", "pounds");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "TOTAL WEIGHT", "pounds");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "EMPTY WEIGHT", "pounds");
-
-    // Radios
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "COM ACTIVE FREQUENCY:1", "Hz");
-
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "COM ACTIVE FREQUENCY:2", "Hz");
+void SimConnectManager::setMessageSource(std::unique_ptr<SimMessageSource> source) {
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    m_messageSource = std::move(source);
+}
 
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "NAV ACTIVE FREQUENCY:1", "Hz");
+void SimConnectManager::setTelemetryRate(TelemetryRate rate) {
+    // Source calls stay on the dispatch thread; just flag the change here
+    m_telemetryRate = rate;
+    m_telemetryRateChanged = true;
+    wakeDispatchLoop();
+}
 
-    SimConnect_AddToDataDefinition(m_hSimConnect, DEFINITION_FLIGHT_DATA,
-        "NAV ACTIVE FREQUENCY:2", "Hz");
+const char* SimConnectManager::getTelemetryRateString(TelemetryRate rate) {
+    switch (rate) {
+        case TelemetryRate::Idle: return "idle";
+        case TelemetryRate::Cruise: return "cruise";
+        case TelemetryRate::SimFrame: return "simFrame";
+        case TelemetryRate::VisualFrame: return "visualFrame";
+        default: return "idle";
+    }
 }
 
-void SimConnectManager::requestPeriodicData() {
-    // Request data every 5 seconds
-    // SIMCONNECT_PERIOD_SECOND requests once per sim second
-    // We use interval of 5 to get data every 5 sim seconds
-    SimConnect_RequestDataOnSimObject(
-        m_hSimConnect,
-        REQUEST_FLIGHT_DATA,
-        DEFINITION_FLIGHT_DATA,
-        SIMCONNECT_OBJECT_ID_USER,
-        SIMCONNECT_PERIOD_SECOND,
-        SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT,
-        0,      // origin
-        5,      // interval (every 5 seconds)
-        0       // limit (0 = no limit)
-    );
+std::optional<TelemetryRate> SimConnectManager::parseTelemetryRate(const std::string& name) {
+    if (name == "idle") return TelemetryRate::Idle;
+    if (name == "cruise") return TelemetryRate::Cruise;
+    if (name == "simFrame") return TelemetryRate::SimFrame;
+    if (name == "visualFrame") return TelemetryRate::VisualFrame;
+    return std::nullopt;
 }
 
 void SimConnectManager::startDispatchLoop() {
@@ -170,42 +81,70 @@ void SimConnectManager::startDispatchLoop() {
 
 void SimConnectManager::stopDispatchLoop() {
     m_running = false;
+    wakeDispatchLoop();
     if (m_dispatchThread.joinable()) {
         m_dispatchThread.join();
     }
 }
 
-void SimConnectManager::dispatchLoop() {
-    while (m_running && m_connected) {
-        SimConnect_CallDispatch(m_hSimConnect, dispatchProc, this);
-        Sleep(10); // Small delay to prevent CPU spinning
+void SimConnectManager::wakeDispatchLoop() {
+    std::lock_guard<std::mutex> lock(m_sourceMutex);
+    if (m_messageSource) {
+        m_messageSource->wake();
     }
 }
 
-void CALLBACK SimConnectManager::dispatchProc(
-    SIMCONNECT_RECV* pData,
-    DWORD cbData,
-    void* pContext
-) {
-    SimConnectManager* self = static_cast<SimConnectManager*>(pContext);
+void SimConnectManager::dispatchLoop() {
+    // The source is only replaced while the loop is stopped, so it is safe to use unlocked here
+    SimMessageSource* source = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_sourceMutex);
+        source = m_messageSource.get();
+    }
+    if (!source) {
+        return;
+    }
+
+    // Runs until stopped, even after the sim quits; only a failed wait ends it early
+    while (m_running) {
+        if (m_telemetryRateChanged.exchange(false)) {
+            source->requestTelemetryRate(m_telemetryRate);
+        }
+
+        // Block until the source signals queued messages (or we are woken up)
+        SimWaitResult result = source->waitForMessages(DISPATCH_WAIT_TIMEOUT);
+        if (result == SimWaitResult::Timeout) {
+            continue;
+        }
+        if (result == SimWaitResult::Failed) {
+            handleConnectionError("Waiting for simulator messages failed");
+            return;
+        }
+
+        // Drain everything that is queued before waiting again
+        SimMessage message;
+        while (m_running && source->nextMessage(&message)) {
+            dispatchMessage(message);
+        }
+    }
+}
 
-    switch (pData->dwID) {
-        case SIMCONNECT_RECV_ID_OPEN:
-            self->handleOpen(reinterpret_cast<SIMCONNECT_RECV_OPEN*>(pData));
+void SimConnectManager::dispatchMessage(const SimMessage& message) {
+    switch (message.type) {
+        case SimMessageType::Open:
+            handleOpen(message);
             break;
 
-        case SIMCONNECT_RECV_ID_QUIT:
-            self->handleQuit();
+        case SimMessageType::Quit:
+            handleQuit();
             break;
 
-        case SIMCONNECT_RECV_ID_SIMOBJECT_DATA:
-            self->handleSimObjectData(
-                reinterpret_cast<SIMCONNECT_RECV_SIMOBJECT_DATA*>(pData));
+        case SimMessageType::SimObjectData:
+            handleSimObjectData(message);
             break;
 
-        case SIMCONNECT_RECV_ID_EXCEPTION:
-            self->handleException(
-                reinterpret_cast<SIMCONNECT_RECV_EXCEPTION*>(pData));
+        case SimMessageType::Exception:
+            handleException(message);
             break;
 
         default:
@@ -213,22 +152,32 @@ void CALLBACK SimConnectManager::dispatchProc(
     }
 }
 
-void SimConnectManager::handleSimObjectData(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData) {
-    if (pObjData->dwRequestID == REQUEST_FLIGHT_DATA) {
-        SimConnectFlightData* pFlightData =
-            reinterpret_cast<SimConnectFlightData*>(&pObjData->dwData);
+void SimConnectManager::handleSimObjectData(const SimMessage& message) {
+    uint32_t requestId = message.requestId;
+    if (requestId >= SIM_VAR_VOLATILITY_COUNT) {
+        return;
+    }
 
-        if (m_flightDataCallback) {
-            FlightDataJson jsonData = FlightDataJson::fromSimConnect(*pFlightData, m_simulatorVersion);
-            m_flightDataCallback(jsonData);
-        }
+    // Merge the block into its range of the snapshot
+    const SimVarBlock& block = SIM_VAR_BLOCKS[requestId];
+    if (message.size < block.size) {
+        std::cerr << "Short SimConnect data block for request " << requestId << std::endl;
+        return;
+    }
+    std::memcpy(m_snapshot.bytes + block.offset, message.data, block.size);
+    m_receivedBlocks |= 1u << requestId;
+
+    // Fast data drives the stream; slower blocks are picked up by the next fast sample.
+    // Nothing is published until every block has arrived, so samples are never partial.
+    if (requestId == REQUEST_FLIGHT_FAST && m_receivedBlocks == ALL_BLOCKS_RECEIVED && m_flightDataCallback) {
+        m_flightDataCallback(m_snapshot, m_simulatorVersion);
     }
 }
 
-void SimConnectManager::handleOpen(SIMCONNECT_RECV_OPEN* pOpen) {
-    std::cout << "Connected to: " << pOpen->szApplicationName << std::endl;
-    std::cout << "SimConnect version: " << pOpen->dwSimConnectVersionMajor
-              << "." << pOpen->dwSimConnectVersionMinor << std::endl;
+void SimConnectManager::handleOpen(const SimMessage& message) {
+    std::cout << "Connected to: " << message.applicationName << std::endl;
+    std::cout << "SimConnect version: " << message.simConnectVersionMajor
+              << "." << message.simConnectVersionMinor << std::endl;
 
     if (m_statusCallback) {
         SimulatorStatus status;
@@ -253,8 +202,22 @@ void SimConnectManager::handleQuit() {
     }
 }
 
-void SimConnectManager::handleException(SIMCONNECT_RECV_EXCEPTION* pException) {
-    std::cerr << "SimConnect Exception: " << pException->dwException
-              << " (SendID: " << pException->dwSendID
-              << ", Index: " << pException->dwIndex << ")" << std::endl;
+void SimConnectManager::handleConnectionError(const std::string& error) {
+    std::cerr << "SimConnect connection lost: " << error << std::endl;
+    m_connected = false;
+
+    if (m_statusCallback) {
+        SimulatorStatus status;
+        status.isConnected = false;
+        status.isSimRunning = false;
+        status.simulatorVersion = m_simulatorVersion;
+        status.connectionError = error;
+        m_statusCallback(status);
+    }
+}
+
+void SimConnectManager::handleException(const SimMessage& message) {
+    std::cerr << "SimConnect Exception: " << message.exception
+              << " (SendID: " << message.sendId
+              << ", Index: " << message.index << ")" << std::endl;
 }
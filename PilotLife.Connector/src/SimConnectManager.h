@@ -1,24 +1,26 @@
 #pragma once
 
-// Must include winsock2.h before windows.h
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <winsock2.h>
-#include <windows.h>
-#include <SimConnect.h>
 #include <functional>
 #include <atomic>
 #include <thread>
 #include <string>
+#include <optional>
+#include <memory>
+#include <mutex>
 #include "FlightData.h"
+#include "SimMessageSource.h"
 
 class SimConnectManager {
 public:
-    using FlightDataCallback = std::function<void(const FlightDataJson&)>;
+    // Receives the raw packed SimConnect data; serialize it with FlightDataEncoder
+    using FlightDataCallback = std::function<void(const SimConnectFlightData&, const std::string& simulatorVersion)>;
     using StatusCallback = std::function<void(const SimulatorStatus&)>;
 
-    SimConnectManager();
+    // Opens the connection for connect(); returns nullptr if the simulator is not available
+    using MessageSourceFactory = std::function<std::unique_ptr<SimMessageSource>(const std::string& appName)>;
+
+    // openSource is SimConnectMessageSource::open in the connector, a scripted source in tests
+    explicit SimConnectManager(MessageSourceFactory openSource);
     ~SimConnectManager();
 
     // Connect to SimConnect
@@ -41,33 +43,49 @@ public:
     void startDispatchLoop();
     void stopDispatchLoop();
 
+    // Change the telemetry rate; re-issued on the dispatch thread without reconnecting
+    void setTelemetryRate(TelemetryRate rate);
+    TelemetryRate getTelemetryRate() const { return m_telemetryRate; }
+
+    // Convert telemetry rate to/from its protocol name ("idle", "cruise", "simFrame", "visualFrame")
+    static const char* getTelemetryRateString(TelemetryRate rate);
+    static std::optional<TelemetryRate> parseTelemetryRate(const std::string& name);
+
 private:
-    // SimConnect handle
-    HANDLE m_hSimConnect = nullptr;
+    MessageSourceFactory m_openSource;
     std::atomic<bool> m_connected{false};
     std::atomic<bool> m_running{false};
     std::thread m_dispatchThread;
     std::string m_simulatorVersion;
 
+    // Where the dispatch loop reads messages from; guarded so wake() from other
+    // threads never races a disconnect
+    std::unique_ptr<SimMessageSource> m_messageSource;
+    mutable std::mutex m_sourceMutex;
+
+    // Requested telemetry rate and whether it still needs to be sent to the source
+    std::atomic<TelemetryRate> m_telemetryRate{TelemetryRate::Idle};
+    std::atomic<bool> m_telemetryRateChanged{false};
+
+    // Snapshot merged from the per-volatility data blocks (dispatch thread only)
+    SimConnectFlightData m_snapshot{};
+    uint32_t m_receivedBlocks = 0;
+    static constexpr uint32_t ALL_BLOCKS_RECEIVED = (1u << SIM_VAR_VOLATILITY_COUNT) - 1;
+
     // Callbacks
     FlightDataCallback m_flightDataCallback;
     StatusCallback m_statusCallback;
 
     // Internal methods
-    void setupDataDefinitions();
-    void requestPeriodicData();
+    void setMessageSource(std::unique_ptr<SimMessageSource> source);
     void dispatchLoop();
-
-    // Static dispatch callback
-    static void CALLBACK dispatchProc(
-        SIMCONNECT_RECV* pData,
-        DWORD cbData,
-        void* pContext
-    );
+    void wakeDispatchLoop();
+    void dispatchMessage(const SimMessage& message);
 
     // Handle specific message types
-    void handleSimObjectData(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData);
-    void handleOpen(SIMCONNECT_RECV_OPEN* pOpen);
+    void handleSimObjectData(const SimMessage& message);
+    void handleOpen(const SimMessage& message);
     void handleQuit();
-    void handleException(SIMCONNECT_RECV_EXCEPTION* pException);
+    void handleConnectionError(const std::string& error);
+    void handleException(const SimMessage& message);
 };
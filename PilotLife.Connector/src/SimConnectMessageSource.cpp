@@ -0,0 +1,208 @@
+#include "SimConnectMessageSource.h"
+#include "FlightData.h"
+#include <iostream>
+
+std::unique_ptr<SimMessageSource> SimConnectMessageSource::open(const std::string& appName) {
+    // Auto-reset events: SimConnect signals the first whenever messages are queued,
+    // wake() the second. Without them the dispatch thread could not block.
+    HANDLE messageEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    HANDLE wakeEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (!messageEvent || !wakeEvent) {
+        std::cerr << "Failed to create SimConnect dispatch events. Error: " << GetLastError() << std::endl;
+        if (messageEvent) {
+            CloseHandle(messageEvent);
+        }
+        if (wakeEvent) {
+            CloseHandle(wakeEvent);
+        }
+        return nullptr;
+    }
+
+    HANDLE hSimConnect = nullptr;
+    HRESULT hr = SimConnect_Open(
+        &hSimConnect,
+        appName.c_str(),
+        nullptr,        // hWnd - not using window messages
+        0,              // UserEventWin32
+        messageEvent,   // hEventHandle - signalled when messages arrive
+        0               // ConfigIndex - use default
+    );
+
+    if (FAILED(hr)) {
+        CloseHandle(messageEvent);
+        CloseHandle(wakeEvent);
+        std::cerr << "Failed to connect to SimConnect. HRESULT: " << hr << std::endl;
+        return nullptr;
+    }
+
+    auto source = std::make_unique<SimConnectMessageSource>(hSimConnect, messageEvent, wakeEvent);
+    source->setupDataDefinitions();
+    source->requestChangeTrackedData();
+    return source;
+}
+
+SimConnectMessageSource::SimConnectMessageSource(HANDLE hSimConnect, HANDLE messageEvent, HANDLE wakeEvent)
+    : m_hSimConnect(hSimConnect)
+    , m_messageEvent(messageEvent)
+    , m_wakeEvent(wakeEvent)
+{
+}
+
+SimConnectMessageSource::~SimConnectMessageSource() {
+    if (m_hSimConnect) {
+        SimConnect_Close(m_hSimConnect);
+    }
+    if (m_wakeEvent) {
+        CloseHandle(m_wakeEvent);
+    }
+    if (m_messageEvent) {
+        CloseHandle(m_messageEvent);
+    }
+}
+
+// SimConnect datatype for a registry entry
+static SIMCONNECT_DATATYPE toSimConnectDatatype(SimVarType type) {
+    switch (type) {
+        case SimVarType::String64: return SIMCONNECT_DATATYPE_STRING64;
+        case SimVarType::String256: return SIMCONNECT_DATATYPE_STRING256;
+        default: return SIMCONNECT_DATATYPE_FLOAT64;
+    }
+}
+
+static_assert(DEFINITION_AIRCRAFT_STATIC == static_cast<int>(SimVarVolatility::Static) &&
+              DEFINITION_AIRCRAFT_SLOW == static_cast<int>(SimVarVolatility::Slow) &&
+              DEFINITION_FLIGHT_FAST == static_cast<int>(SimVarVolatility::Fast),
+              "Data definitions are indexed by volatility");
+
+void SimConnectMessageSource::setupDataDefinitions() {
+    // One definition per volatility; SimVars are added in registry order so each
+    // returned block lines up with its range of the snapshot (SIM_VAR_BLOCKS)
+    for (const auto& simVar : SIM_VARS) {
+        auto definition = static_cast<DATA_DEFINE_ID>(simVar.volatility);
+        SimConnect_AddToDataDefinition(m_hSimConnect, definition,
+            simVar.name, simVar.unit, toSimConnectDatatype(simVar.type));
+    }
+}
+
+void SimConnectMessageSource::requestChangeTrackedData() {
+    // Identity, weights and radios are checked once a second but only sent when a
+    // value changes (and once initially), so they cost no IPC while steady
+    const DATA_DEFINE_ID definitions[] = { DEFINITION_AIRCRAFT_STATIC, DEFINITION_AIRCRAFT_SLOW };
+    const DATA_REQUEST_ID requests[] = { REQUEST_AIRCRAFT_STATIC, REQUEST_AIRCRAFT_SLOW };
+    for (size_t i = 0; i < 2; i++) {
+        SimConnect_RequestDataOnSimObject(
+            m_hSimConnect,
+            requests[i],
+            definitions[i],
+            SIMCONNECT_OBJECT_ID_USER,
+            SIMCONNECT_PERIOD_SECOND,
+            SIMCONNECT_DATA_REQUEST_FLAG_CHANGED
+        );
+    }
+}
+
+void SimConnectMessageSource::requestTelemetryRate(TelemetryRate rate) {
+    // Only the fast kinematics follow the telemetry rate.
+    // Re-issuing the request with the same request ID replaces the previous period
+    SIMCONNECT_PERIOD period = SIMCONNECT_PERIOD_SECOND;
+    DWORD interval = 0;
+
+    switch (rate) {
+        case TelemetryRate::Idle:
+            // SIMCONNECT_PERIOD_SECOND with interval 5 to get data every 5 sim seconds
+            period = SIMCONNECT_PERIOD_SECOND;
+            interval = 5;
+            break;
+        case TelemetryRate::Cruise:
+            period = SIMCONNECT_PERIOD_SECOND;
+            interval = 0;
+            break;
+        case TelemetryRate::SimFrame:
+            period = SIMCONNECT_PERIOD_SIM_FRAME;
+            interval = 0;
+            break;
+        case TelemetryRate::VisualFrame:
+            period = SIMCONNECT_PERIOD_VISUAL_FRAME;
+            interval = 0;
+            break;
+    }
+
+    SimConnect_RequestDataOnSimObject(
+        m_hSimConnect,
+        REQUEST_FLIGHT_FAST,
+        DEFINITION_FLIGHT_FAST,
+        SIMCONNECT_OBJECT_ID_USER,
+        period,
+        SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT,
+        0,          // origin
+        interval,   // periods to skip between transmissions
+        0           // limit (0 = no limit)
+    );
+}
+
+SimWaitResult SimConnectMessageSource::waitForMessages(std::chrono::milliseconds timeout) {
+    HANDLE handles[] = { m_messageEvent, m_wakeEvent };
+    DWORD result = WaitForMultipleObjects(2, handles, FALSE, static_cast<DWORD>(timeout.count()));
+    if (result == WAIT_TIMEOUT) {
+        return SimWaitResult::Timeout;
+    }
+    if (result == WAIT_FAILED) {
+        // Retrying would return immediately again and spin the dispatch thread
+        std::cerr << "Waiting for SimConnect messages failed. Error: " << GetLastError() << std::endl;
+        return SimWaitResult::Failed;
+    }
+    return SimWaitResult::Messages;
+}
+
+bool SimConnectMessageSource::nextMessage(SimMessage* message) {
+    SIMCONNECT_RECV* pData = nullptr;
+    DWORD cbData = 0;
+    if (FAILED(SimConnect_GetNextDispatch(m_hSimConnect, &pData, &cbData))) {
+        return false;
+    }
+
+    *message = SimMessage();
+    switch (pData->dwID) {
+        case SIMCONNECT_RECV_ID_OPEN: {
+            auto* pOpen = reinterpret_cast<SIMCONNECT_RECV_OPEN*>(pData);
+            message->type = SimMessageType::Open;
+            message->applicationName = pOpen->szApplicationName;
+            message->simConnectVersionMajor = pOpen->dwSimConnectVersionMajor;
+            message->simConnectVersionMinor = pOpen->dwSimConnectVersionMinor;
+            break;
+        }
+
+        case SIMCONNECT_RECV_ID_QUIT:
+            message->type = SimMessageType::Quit;
+            break;
+
+        case SIMCONNECT_RECV_ID_SIMOBJECT_DATA: {
+            auto* pObjData = reinterpret_cast<SIMCONNECT_RECV_SIMOBJECT_DATA*>(pData);
+            // The values start at dwData and run to the end of the message
+            const auto* data = reinterpret_cast<const unsigned char*>(&pObjData->dwData);
+            size_t headerSize = data - reinterpret_cast<const unsigned char*>(pObjData);
+            message->type = SimMessageType::SimObjectData;
+            message->requestId = pObjData->dwRequestID;
+            message->data = data;
+            message->size = cbData > headerSize ? cbData - headerSize : 0;
+            break;
+        }
+
+        case SIMCONNECT_RECV_ID_EXCEPTION: {
+            auto* pException = reinterpret_cast<SIMCONNECT_RECV_EXCEPTION*>(pData);
+            message->type = SimMessageType::Exception;
+            message->exception = pException->dwException;
+            message->sendId = pException->dwSendID;
+            message->index = pException->dwIndex;
+            break;
+        }
+
+        default:
+            break;
+    }
+    return true;
+}
+
+void SimConnectMessageSource::wake() {
+    SetEvent(m_wakeEvent);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+// Must include winsock2.h before windows.h
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <windows.h>
+#include <SimConnect.h>
+#include <memory>
+#include <string>
+#include "SimMessageSource.h"
+
+// Message source backed by a live SimConnect connection.
+// SimConnect signals the event handle passed to SimConnect_Open whenever
+// messages are queued, so waiting costs no CPU while the sim is quiet.
+class SimConnectMessageSource : public SimMessageSource {
+public:
+    // Open a connection, register the SIM_VARS data definitions and request the
+    // change-tracked blocks. Returns nullptr if SimConnect is not available.
+    static std::unique_ptr<SimMessageSource> open(const std::string& appName);
+
+    // Takes ownership of hSimConnect and both events; messageEvent is the
+    // hEventHandle given to SimConnect_Open
+    SimConnectMessageSource(HANDLE hSimConnect, HANDLE messageEvent, HANDLE wakeEvent);
+    ~SimConnectMessageSource() override;
+
+    SimConnectMessageSource(const SimConnectMessageSource&) = delete;
+    SimConnectMessageSource& operator=(const SimConnectMessageSource&) = delete;
+
+    SimWaitResult waitForMessages(std::chrono::milliseconds timeout) override;
+    bool nextMessage(SimMessage* message) override;
+    void requestTelemetryRate(TelemetryRate rate) override;
+    void wake() override;
+
+private:
+    HANDLE m_hSimConnect;
+    HANDLE m_messageEvent;
+    HANDLE m_wakeEvent;
+
+    void setupDataDefinitions();
+    void requestChangeTrackedData();
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Telemetry request rate profiles
+enum class TelemetryRate {
+    Idle,           // Every 5 sim seconds (default)
+    Cruise,         // Once per sim second
+    SimFrame,       // Every simulation frame (approach/takeoff, landing-rate capture)
+    VisualFrame     // Every rendered frame
+};
+
+enum class SimWaitResult {
+    Messages,   // Messages may be queued, or wake() was called
+    Timeout,
+    Failed      // The wait itself failed; the connection is unusable
+};
+
+enum class SimMessageType {
+    Open,
+    Quit,
+    SimObjectData,
+    Exception,
+    Other
+};
+
+// A message from the simulator, decoded from the SDK's SIMCONNECT_RECV_* structs so
+// neither SimConnectManager nor test doubles need the SimConnect headers.
+// Pointers stay valid until the next nextMessage() call.
+struct SimMessage {
+    SimMessageType type = SimMessageType::Other;
+
+    // SimObjectData: the request it answers and the packed values of its data definition
+    uint32_t requestId = 0;
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+    // Open
+    const char* applicationName = "";
+    uint32_t simConnectVersionMajor = 0;
+    uint32_t simConnectVersionMinor = 0;
+
+    // Exception
+    uint32_t exception = 0;
+    uint32_t sendId = 0;
+    uint32_t index = 0;
+};
+
+// Connection to the simulator driven by SimConnectManager's dispatch thread.
+// The dispatch thread blocks in waitForMessages() and then drains every
+// queued message with nextMessage() before waiting again. All calls except
+// wake() are made on the dispatch thread.
+class SimMessageSource {
+public:
+    virtual ~SimMessageSource() = default;
+
+    // Block until messages may be available, wake() is called, or the timeout elapses
+    virtual SimWaitResult waitForMessages(std::chrono::milliseconds timeout) = 0;
+
+    // Fetch the next queued message. Returns false when the queue is empty.
+    virtual bool nextMessage(SimMessage* message) = 0;
+
+    // (Re-)issue the periodic request for the fast data block at the given rate.
+    // Replaces the previous period without reconnecting.
+    virtual void requestTelemetryRate(TelemetryRate rate) = 0;
+
+    // Unblock a thread waiting in waitForMessages() (shutdown, rate changes)
+    virtual void wake() = 0;
+};
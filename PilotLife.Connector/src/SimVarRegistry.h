@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+// Field groups a client can subscribe to (bit flags)
+enum FieldGroup : uint32_t {
+    FIELD_GROUP_NONE = 0x00,       // Read from the sim but not sent as-is (only feeds derived fields)
+    FIELD_GROUP_METADATA = 0x01,   // Aircraft identity and specs, simulatorVersion
+    FIELD_GROUP_POSITION = 0x02,
+    FIELD_GROUP_SPEED = 0x04,
+    FIELD_GROUP_HEADING = 0x08,
+    FIELD_GROUP_WEIGHT = 0x10,     // Weight & fuel
+    FIELD_GROUP_RADIOS = 0x20,
+    FIELD_GROUP_ALL = 0x3F
+};
+
+// How a field is written to the wire
+enum class FieldKind {
+    Text,       // JSON string
+    Integer,    // Number truncated to an integer
+    Number,     // Number at fixed precision
+    Frequency   // Number in Hz, written as a "118.700" MHz string
+};
+
+// Layout of a SimVar in the SimConnect receive buffer
+enum class SimVarType {
+    Float64,
+    String64,
+    String256
+};
+
+// How often a SimVar changes; each volatility is a separate SimConnect data
+// definition and request, so rarely changing values are not resent every frame
+enum class SimVarVolatility {
+    Static,     // Aircraft identity and specs; sent only when they change
+    Slow,       // Weight, fuel, radios; checked once a second, sent when changed
+    Fast        // Kinematics; sent at the telemetry rate
+};
+
+constexpr size_t SIM_VAR_VOLATILITY_COUNT = 3;
+
+constexpr size_t simVarSize(SimVarType type) {
+    switch (type) {
+        case SimVarType::String64: return 64;
+        case SimVarType::String256: return 256;
+        default: return sizeof(double);
+    }
+}
+
+// One SimVar requested from the simulator
+struct SimVarDef {
+    const char* name;       // SimConnect variable name
+    const char* unit;       // SimConnect unit; nullptr for strings
+    SimVarType type;
+    SimVarVolatility volatility;
+    const char* key;        // flightData JSON key; nullptr if only used by derived fields
+    FieldGroup group;
+    FieldKind kind;
+    int precision;          // Decimal places for FieldKind::Number
+    double epsilon;         // Smallest change worth sending in a delta
+};
+
+// Every SimVar the connector reads. This table is the only place a SimVar is listed:
+// the SimConnect data definition, the receive buffer offsets and the flightData
+// serializer are all generated from it, so adding a SimVar is one line here.
+// Its volatility picks the data definition (and so the request period) it is
+// read with. Entries are in flightData wire order; derived fields (engineTypeStr, fuel and
+// payload weights, kg conversions) are added by FlightDataEncoder.
+inline constexpr SimVarDef SIM_VARS[] = {
+    // Aircraft metadata
+    { "TITLE", nullptr, SimVarType::String256, SimVarVolatility::Static, "aircraftTitle", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "ATC TYPE", nullptr, SimVarType::String64, SimVarVolatility::Static, "atcType", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "ATC MODEL", nullptr, SimVarType::String64, SimVarVolatility::Static, "atcModel", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "ATC ID", nullptr, SimVarType::String64, SimVarVolatility::Static, "atcId", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "ATC AIRLINE", nullptr, SimVarType::String64, SimVarVolatility::Static, "atcAirline", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "ATC FLIGHT NUMBER", nullptr, SimVarType::String64, SimVarVolatility::Static, "atcFlightNumber", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "CATEGORY", nullptr, SimVarType::String256, SimVarVolatility::Static, "category", FIELD_GROUP_METADATA, FieldKind::Text, 0, 0.0 },
+    { "ENGINE TYPE", "enum", SimVarType::Float64, SimVarVolatility::Static, "engineType", FIELD_GROUP_METADATA, FieldKind::Integer, 0, 0.5 },
+    { "NUMBER OF ENGINES", "number", SimVarType::Float64, SimVarVolatility::Static, "numberOfEngines", FIELD_GROUP_METADATA, FieldKind::Integer, 0, 0.5 },
+    { "MAX GROSS WEIGHT", "pounds", SimVarType::Float64, SimVarVolatility::Static, "maxGrossWeightLbs", FIELD_GROUP_METADATA, FieldKind::Number, 1, 1.0 },
+    { "DESIGN CRUISE ALT", "knots", SimVarType::Float64, SimVarVolatility::Static, "cruiseSpeedKts", FIELD_GROUP_METADATA, FieldKind::Number, 1, 1.0 },
+    { "EMPTY WEIGHT", "pounds", SimVarType::Float64, SimVarVolatility::Static, "emptyWeightLbs", FIELD_GROUP_METADATA, FieldKind::Number, 1, 1.0 },
+    // Position
+    { "PLANE LATITUDE", "degrees", SimVarType::Float64, SimVarVolatility::Fast, "latitude", FIELD_GROUP_POSITION, FieldKind::Number, 6, 0.000001 },
+    { "PLANE LONGITUDE", "degrees", SimVarType::Float64, SimVarVolatility::Fast, "longitude", FIELD_GROUP_POSITION, FieldKind::Number, 6, 0.000001 },
+    { "INDICATED ALTITUDE", "feet", SimVarType::Float64, SimVarVolatility::Fast, "altitudeIndicated", FIELD_GROUP_POSITION, FieldKind::Number, 1, 0.5 },
+    { "PLANE ALTITUDE", "feet", SimVarType::Float64, SimVarVolatility::Fast, "altitudeTrue", FIELD_GROUP_POSITION, FieldKind::Number, 1, 0.5 },
+    { "PLANE ALT ABOVE GROUND", "feet", SimVarType::Float64, SimVarVolatility::Fast, "altitudeAGL", FIELD_GROUP_POSITION, FieldKind::Number, 1, 0.5 },
+    // Speed
+    { "AIRSPEED INDICATED", "knots", SimVarType::Float64, SimVarVolatility::Fast, "airspeedIndicated", FIELD_GROUP_SPEED, FieldKind::Number, 1, 0.1 },
+    { "AIRSPEED TRUE", "knots", SimVarType::Float64, SimVarVolatility::Fast, "airspeedTrue", FIELD_GROUP_SPEED, FieldKind::Number, 1, 0.1 },
+    { "GROUND VELOCITY", "knots", SimVarType::Float64, SimVarVolatility::Fast, "groundSpeed", FIELD_GROUP_SPEED, FieldKind::Number, 1, 0.1 },
+    { "AIRSPEED MACH", "mach", SimVarType::Float64, SimVarVolatility::Fast, "machNumber", FIELD_GROUP_SPEED, FieldKind::Number, 3, 0.001 },
+    // Heading
+    { "HEADING INDICATOR", "degrees", SimVarType::Float64, SimVarVolatility::Fast, "headingMagnetic", FIELD_GROUP_HEADING, FieldKind::Number, 1, 0.1 },
+    { "PLANE HEADING DEGREES TRUE", "degrees", SimVarType::Float64, SimVarVolatility::Fast, "headingTrue", FIELD_GROUP_HEADING, FieldKind::Number, 1, 0.1 },
+    { "GPS GROUND TRUE TRACK", "degrees", SimVarType::Float64, SimVarVolatility::Fast, "track", FIELD_GROUP_HEADING, FieldKind::Number, 1, 0.1 },
+    // Weight & Fuel
+    { "FUEL TOTAL QUANTITY", "gallons", SimVarType::Float64, SimVarVolatility::Slow, nullptr, FIELD_GROUP_NONE, FieldKind::Number, 0, 0.0 },
+    { "FUEL WEIGHT PER GALLON", "pounds", SimVarType::Float64, SimVarVolatility::Slow, nullptr, FIELD_GROUP_NONE, FieldKind::Number, 0, 0.0 },
+    { "TOTAL WEIGHT", "pounds", SimVarType::Float64, SimVarVolatility::Slow, "totalWeightLbs", FIELD_GROUP_WEIGHT, FieldKind::Number, 1, 1.0 },
+    // Radios
+    { "COM ACTIVE FREQUENCY:1", "Hz", SimVarType::Float64, SimVarVolatility::Slow, "com1Frequency", FIELD_GROUP_RADIOS, FieldKind::Frequency, 3, 500.0 },
+    { "COM ACTIVE FREQUENCY:2", "Hz", SimVarType::Float64, SimVarVolatility::Slow, "com2Frequency", FIELD_GROUP_RADIOS, FieldKind::Frequency, 3, 500.0 },
+    { "NAV ACTIVE FREQUENCY:1", "Hz", SimVarType::Float64, SimVarVolatility::Slow, "nav1Frequency", FIELD_GROUP_RADIOS, FieldKind::Frequency, 3, 500.0 },
+    { "NAV ACTIVE FREQUENCY:2", "Hz", SimVarType::Float64, SimVarVolatility::Slow, "nav2Frequency", FIELD_GROUP_RADIOS, FieldKind::Frequency, 3, 500.0 },
+};
+
+constexpr size_t SIM_VAR_COUNT = std::size(SIM_VARS);
+
+// Byte offset of each SimVar in the merged snapshot. SimVars are laid out grouped
+// by volatility (registry order within a group), so the block SimConnect returns
+// for one volatility's definition is a single contiguous range of the snapshot.
+constexpr std::array<size_t, SIM_VAR_COUNT> computeSimVarOffsets() {
+    std::array<size_t, SIM_VAR_COUNT> offsets{};
+    size_t offset = 0;
+    for (size_t volatility = 0; volatility < SIM_VAR_VOLATILITY_COUNT; volatility++) {
+        for (size_t i = 0; i < SIM_VAR_COUNT; i++) {
+            if (static_cast<size_t>(SIM_VARS[i].volatility) == volatility) {
+                offsets[i] = offset;
+                offset += simVarSize(SIM_VARS[i].type);
+            }
+        }
+    }
+    return offsets;
+}
+
+inline constexpr std::array<size_t, SIM_VAR_COUNT> SIM_VAR_OFFSETS = computeSimVarOffsets();
+
+// Where one volatility's data block sits in the snapshot
+struct SimVarBlock {
+    size_t offset;
+    size_t size;
+};
+
+constexpr std::array<SimVarBlock, SIM_VAR_VOLATILITY_COUNT> computeSimVarBlocks() {
+    std::array<SimVarBlock, SIM_VAR_VOLATILITY_COUNT> blocks{};
+    size_t offset = 0;
+    for (size_t volatility = 0; volatility < SIM_VAR_VOLATILITY_COUNT; volatility++) {
+        blocks[volatility].offset = offset;
+        for (size_t i = 0; i < SIM_VAR_COUNT; i++) {
+            if (static_cast<size_t>(SIM_VARS[i].volatility) == volatility) {
+                blocks[volatility].size += simVarSize(SIM_VARS[i].type);
+            }
+        }
+        offset += blocks[volatility].size;
+    }
+    return blocks;
+}
+
+inline constexpr std::array<SimVarBlock, SIM_VAR_VOLATILITY_COUNT> SIM_VAR_BLOCKS = computeSimVarBlocks();
+
+constexpr size_t SIM_VAR_BLOCK_SIZE =
+    SIM_VAR_BLOCKS[SIM_VAR_VOLATILITY_COUNT - 1].offset + SIM_VAR_BLOCKS[SIM_VAR_VOLATILITY_COUNT - 1].size;
+
+// Registry index of a SimVar by name. Used as a constant expression, an unknown
+// name is a compile error.
+constexpr size_t simVarIndex(std::string_view name) {
+    for (size_t i = 0; i < SIM_VAR_COUNT; i++) {
+        if (name == SIM_VARS[i].name) {
+            return i;
+        }
+    }
+    throw std::logic_error("Unknown SimVar");
+}
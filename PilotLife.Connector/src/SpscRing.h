@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What to do when the producer outruns the consumer
+enum class OverflowPolicy {
+    DropOldest,     // Discard the oldest queued item to make room; consumer sees every remaining item in order
+    CoalesceLatest  // Consumer always jumps to the newest item; everything older is discarded
+};
+
+// Counters describing how the ring has behaved so far
+struct RingStats {
+    uint64_t pushed = 0;      // Items accepted by push()
+    uint64_t popped = 0;      // Items handed to the consumer
+    uint64_t dropped = 0;     // Items discarded because the ring was full
+    uint64_t coalesced = 0;   // Items skipped by a CoalesceLatest pop
+    uint64_t depth = 0;       // Items currently queued
+    uint64_t maxDepth = 0;    // Highest depth observed
+};
+
+// Bounded single-producer/single-consumer ring that never blocks the producer.
+//
+// Indices grow monotonically; slot = index % m_slots.size(). The producer owns
+// m_head. m_tail is advanced with CAS by the consumer (claiming an item) and by
+// the producer (dropping the oldest item on overflow), so a claim and a drop
+// can never both take the same item. Before claiming, the consumer publishes
+// the index it is about to copy in m_reading. The producer never writes a slot
+// that is still being copied, even when the consumer stalls mid-copy.
+template <typename T>
+class SpscRing {
+public:
+    SpscRing(size_t capacity, OverflowPolicy policy)
+        : m_slots(capacity + 1)  // One spare slot for the item being copied out
+        , m_capacity(capacity)
+        , m_policy(policy)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: enqueue a copy of item. Never blocks; returns false if item itself was dropped.
+    bool push(const T& item) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t tail = m_tail.load(std::memory_order_seq_cst);
+
+        // Make room by discarding the oldest unclaimed item
+        while (head - tail >= m_capacity) {
+            if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_seq_cst)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                tail++;
+            }
+        }
+
+        // The target slot may still be copied out by a stalled consumer; drop the new item instead
+        uint64_t reading = m_reading.load(std::memory_order_seq_cst);
+        if (reading != NOT_READING && head - reading >= m_slots.size()) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_slots[head % m_slots.size()] = item;
+        m_head.store(head + 1, std::memory_order_seq_cst);
+        m_pushed.fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t depth = head + 1 - tail;
+        if (depth > m_maxDepth.load(std::memory_order_relaxed)) {
+            m_maxDepth.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Consumer: copy the next item (or the newest, under CoalesceLatest) into out.
+    // Returns false if the ring is empty.
+    bool pop(T& out) {
+        uint64_t tail = m_tail.load(std::memory_order_seq_cst);
+        for (;;) {
+            uint64_t head = m_head.load(std::memory_order_seq_cst);
+            if (tail == head) {
+                return false;
+            }
+
+            uint64_t index = (m_policy == OverflowPolicy::CoalesceLatest) ? head - 1 : tail;
+
+            // Announce the slot before claiming it so the producer will not overwrite it
+            m_reading.store(index, std::memory_order_seq_cst);
+            if (m_tail.compare_exchange_strong(tail, index + 1, std::memory_order_seq_cst)) {
+                out = m_slots[index % m_slots.size()];
+                m_reading.store(NOT_READING, std::memory_order_seq_cst);
+
+                m_popped.fetch_add(1, std::memory_order_relaxed);
+                if (index > tail) {
+                    m_coalesced.fetch_add(index - tail, std::memory_order_relaxed);
+                }
+                return true;
+            }
+            // The producer dropped the item we wanted; tail now holds the new value, retry
+        }
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_seq_cst) == m_tail.load(std::memory_order_seq_cst);
+    }
+
+    size_t capacity() const { return m_capacity; }
+    OverflowPolicy policy() const { return m_policy; }
+
+    RingStats getStats() const {
+        RingStats stats;
+        stats.pushed = m_pushed.load(std::memory_order_relaxed);
+        stats.popped = m_popped.load(std::memory_order_relaxed);
+        stats.dropped = m_dropped.load(std::memory_order_relaxed);
+        stats.coalesced = m_coalesced.load(std::memory_order_relaxed);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+        stats.depth = head > tail ? head - tail : 0;
+        stats.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr uint64_t NOT_READING = UINT64_MAX;
+
+    std::vector<T> m_slots;
+    const size_t m_capacity;
+    const OverflowPolicy m_policy;
+
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+    alignas(64) std::atomic<uint64_t> m_reading{NOT_READING};
+
+    std::atomic<uint64_t> m_pushed{0};
+    std::atomic<uint64_t> m_popped{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_coalesced{0};
+    std::atomic<uint64_t> m_maxDepth{0};
+};
@@ -0,0 +1,288 @@
+#include "TelemetryBinary.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Little-endian writers (explicit byte order so the format does not depend on the host)
+static void appendU8(std::string& out, uint8_t value) {
+    out.push_back(static_cast<char>(value));
+}
+
+static void appendU16(std::string& out, uint16_t value) {
+    char bytes[2] = { static_cast<char>(value), static_cast<char>(value >> 8) };
+    out.append(bytes, 2);
+}
+
+static void appendU32(std::string& out, uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; i++) bytes[i] = static_cast<char>(value >> (8 * i));
+    out.append(bytes, 4);
+}
+
+static void appendU64(std::string& out, uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; i++) bytes[i] = static_cast<char>(value >> (8 * i));
+    out.append(bytes, 8);
+}
+
+static void appendF64(std::string& out, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    appendU64(out, bits);
+}
+
+// Little-endian reader over a frame
+class FrameReader {
+public:
+    explicit FrameReader(std::string_view data) : m_data(data) {}
+
+    bool readU8(uint8_t& value) { return read(value, 1); }
+    bool readU16(uint16_t& value) { return read(value, 2); }
+    bool readU32(uint32_t& value) { return read(value, 4); }
+    bool readU64(uint64_t& value) { return read(value, 8); }
+
+    bool readF64(double& value) {
+        uint64_t bits;
+        if (!readU64(bits)) return false;
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    bool readBytes(size_t length, std::string_view& value) {
+        if (m_data.size() - m_pos < length) return false;
+        value = m_data.substr(m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+private:
+    template <typename T>
+    bool read(T& value, size_t size) {
+        if (m_data.size() - m_pos < size) return false;
+        uint64_t result = 0;
+        for (size_t i = 0; i < size; i++) {
+            result |= static_cast<uint64_t>(static_cast<unsigned char>(m_data[m_pos + i])) << (8 * i);
+        }
+        value = static_cast<T>(result);
+        m_pos += size;
+        return true;
+    }
+
+    std::string_view m_data;
+    size_t m_pos = 0;
+};
+
+static bool isNumeric(const FlightDataField& field) {
+    return field.kind != FlightDataField::Kind::Text;
+}
+
+TelemetryBinaryEncoder::TelemetryBinaryEncoder() {
+    // One slot per text field plus the simulator version
+    size_t slots = 1;
+    for (const auto& field : FlightDataEncoder::getFields()) {
+        if (!isNumeric(field)) slots++;
+    }
+    m_slotText.resize(slots);
+    m_slotIds.resize(slots);
+    m_slotValid.resize(slots, false);
+}
+
+uint32_t TelemetryBinaryEncoder::intern(size_t slot, std::string_view text) {
+    // Unchanged since last frame - no lookup or allocation
+    if (m_slotValid[slot] && m_slotText[slot] == text) {
+        return m_slotIds[slot];
+    }
+
+    m_slotText[slot].assign(text.data(), text.size());
+    auto it = m_stringIds.find(m_slotText[slot]);
+    uint32_t id;
+    if (it != m_stringIds.end()) {
+        id = it->second;
+    } else {
+        id = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(m_slotText[slot]);
+        m_stringIds.emplace(m_slotText[slot], id);
+        m_newStrings.push_back(id);
+    }
+
+    m_slotIds[slot] = id;
+    m_slotValid[slot] = true;
+    return id;
+}
+
+void TelemetryBinaryEncoder::writeHeader(std::string& buffer, uint8_t frameType, uint8_t flags) {
+    appendU32(buffer, TelemetryBinary::MAGIC);
+    appendU16(buffer, TelemetryBinary::VERSION);
+    appendU8(buffer, frameType);
+    appendU8(buffer, flags);
+    appendU64(buffer, ++m_sequence);
+}
+
+bool TelemetryBinaryEncoder::writeFrames(const SimConnectFlightData& data, std::string_view simVersion,
+                                         std::string& stringTableBuffer, std::string& frameBuffer) {
+    const auto& fields = FlightDataEncoder::getFields();
+
+    bool fullTable = m_fullTableRequested.exchange(false);
+    if (m_strings.size() >= MAX_INTERNED_STRINGS) {
+        // Start over rather than grow without bound; clients are told to drop their table
+        m_stringIds.clear();
+        m_strings.clear();
+        std::fill(m_slotValid.begin(), m_slotValid.end(), false);
+        fullTable = true;
+    }
+    m_newStrings.clear();
+
+    // Intern strings first so the table frame can precede the data frame
+    size_t slot = 0;
+    for (const auto& field : fields) {
+        if (!isNumeric(field)) {
+            intern(slot++, field.text(data));
+        }
+    }
+    intern(slot, simVersion);
+
+    bool hasStringTable = fullTable || !m_newStrings.empty();
+    if (hasStringTable) {
+        stringTableBuffer.clear();
+        writeHeader(stringTableBuffer, TelemetryBinary::FRAME_STRING_TABLE,
+                    fullTable ? TelemetryBinary::FLAG_RESET_STRINGS : 0);
+
+        size_t count = fullTable ? m_strings.size() : m_newStrings.size();
+        appendU16(stringTableBuffer, static_cast<uint16_t>(count));
+        for (size_t i = 0; i < count; i++) {
+            uint32_t id = fullTable ? static_cast<uint32_t>(i) : m_newStrings[i];
+            const std::string& text = m_strings[id];
+            size_t length = std::min<size_t>(text.size(), UINT16_MAX);
+            appendU32(stringTableBuffer, id);
+            appendU16(stringTableBuffer, static_cast<uint16_t>(length));
+            stringTableBuffer.append(text.data(), length);
+        }
+    }
+
+    // Flight data frame
+    auto now = std::chrono::system_clock::now();
+    uint64_t timestampMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
+
+    frameBuffer.clear();
+    writeHeader(frameBuffer, TelemetryBinary::FRAME_FLIGHT_DATA, 0);
+    appendU64(frameBuffer, timestampMs);
+
+    uint16_t numberCount = 0;
+    for (const auto& field : fields) {
+        if (isNumeric(field)) numberCount++;
+    }
+    appendU16(frameBuffer, numberCount);
+    for (const auto& field : fields) {
+        if (isNumeric(field)) {
+            appendF64(frameBuffer, field.number(data));
+        }
+    }
+
+    appendU16(frameBuffer, static_cast<uint16_t>(m_slotIds.size()));
+    for (uint32_t id : m_slotIds) {
+        appendU32(frameBuffer, id);
+    }
+
+    return hasStringTable;
+}
+
+void TelemetryBinaryEncoder::writeSchema(JsonWriter& writer) {
+    const auto& fields = FlightDataEncoder::getFields();
+
+    auto kindName = [](FlightDataField::Kind kind) {
+        switch (kind) {
+            case FlightDataField::Kind::Integer: return "integer";
+            case FlightDataField::Kind::Number: return "number";
+            case FlightDataField::Kind::Frequency: return "frequencyHz";
+            default: return "text";
+        }
+    };
+
+    writer.beginObject();
+    writer.field("magic", "PLTB");
+    writer.field("version", static_cast<int>(TelemetryBinary::VERSION));
+    writer.field("byteOrder", "little");
+    writer.key("numbers");
+    writer.beginArray();
+    for (const auto& field : fields) {
+        if (isNumeric(field)) {
+            writer.beginObject();
+            writer.field("key", field.key);
+            writer.field("kind", kindName(field.kind));
+            writer.field("type", "f64");
+            writer.endObject();
+        }
+    }
+    writer.endArray();
+    writer.key("strings");
+    writer.beginArray();
+    for (const auto& field : fields) {
+        if (!isNumeric(field)) {
+            writer.value(field.key);
+        }
+    }
+    writer.value("simulatorVersion");
+    writer.endArray();
+    writer.endObject();
+}
+
+bool TelemetryBinaryDecoder::decode(std::string_view frame, DecodedFlightData& out) {
+    m_needsResync = false;
+    FrameReader reader(frame);
+
+    uint32_t magic;
+    uint16_t version;
+    uint8_t frameType, flags;
+    uint64_t sequence;
+    if (!reader.readU32(magic) || magic != TelemetryBinary::MAGIC) return false;
+    if (!reader.readU16(version) || version != TelemetryBinary::VERSION) return false;
+    if (!reader.readU8(frameType) || !reader.readU8(flags) || !reader.readU64(sequence)) return false;
+
+    if (frameType == TelemetryBinary::FRAME_STRING_TABLE) {
+        if (flags & TelemetryBinary::FLAG_RESET_STRINGS) {
+            m_strings.clear();
+            m_resetSequence = sequence;
+        }
+        uint16_t count;
+        if (!reader.readU16(count)) return false;
+        for (uint16_t i = 0; i < count; i++) {
+            uint32_t id;
+            uint16_t length;
+            std::string_view text;
+            if (!reader.readU32(id) || !reader.readU16(length) || !reader.readBytes(length, text)) return false;
+            m_strings[id] = std::string(text);
+        }
+        return false;
+    }
+
+    if (frameType != TelemetryBinary::FRAME_FLIGHT_DATA) return false;
+
+    // Sent before the reset, so its string IDs may now name other strings
+    if (sequence < m_resetSequence) return false;
+
+    out.sequence = sequence;
+    if (!reader.readU64(out.timestampMs)) return false;
+
+    uint16_t numberCount;
+    if (!reader.readU16(numberCount)) return false;
+    out.numbers.resize(numberCount);
+    for (auto& number : out.numbers) {
+        if (!reader.readF64(number)) return false;
+    }
+
+    uint16_t stringCount;
+    if (!reader.readU16(stringCount)) return false;
+    out.strings.resize(stringCount);
+    for (auto& text : out.strings) {
+        uint32_t id;
+        if (!reader.readU32(id)) return false;
+        auto it = m_strings.find(id);
+        if (it == m_strings.end()) {
+            m_needsResync = true;
+            return false;
+        }
+        text = it->second;
+    }
+    return true;
+}
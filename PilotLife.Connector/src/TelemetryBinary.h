@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "FlightData.h"
+
+// Binary flight data wire format (version 1) for high-rate consumers.
+//
+// Every frame is a WebSocket binary message, little-endian throughout:
+//
+//   Header (16 bytes)
+//     u32  magic        "PLTB" (0x42544C50)
+//     u16  version      1
+//     u8   frameType    1 = flight data, 2 = string table
+//     u8   flags        string table: bit 0 = discard all previously received strings
+//     u64  sequence     increases by one per frame of either type
+//
+//   Flight data frame
+//     u64  timestamp    Unix time in milliseconds
+//     u16  numberCount  followed by numberCount f64 values
+//     u16  stringCount  followed by stringCount u32 string IDs
+//
+//   String table frame
+//     u16  count        followed by count entries of { u32 id, u16 length, length bytes UTF-8 }
+//
+// Numbers and strings appear in FlightDataEncoder::getFields() order (numeric kinds
+// and text kinds respectively); frequencies are sent in Hz. The last string ID is
+// the simulator version. The exact field list is published to each client as
+// the "schema" of its telemetryFormatResponse (see writeSchema), so decoders
+// never hard-code it. A string table frame always precedes the first flight
+// data frame that references its IDs. A reset table reuses IDs, so a flight
+// data frame with a lower sequence than the last reset table refers to the
+// previous table and is dropped.
+namespace TelemetryBinary {
+    constexpr uint32_t MAGIC = 0x42544C50;
+    constexpr uint16_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = 16;
+
+    constexpr uint8_t FRAME_FLIGHT_DATA = 1;
+    constexpr uint8_t FRAME_STRING_TABLE = 2;
+
+    constexpr uint8_t FLAG_RESET_STRINGS = 0x01;
+}
+
+class TelemetryBinaryEncoder {
+public:
+    TelemetryBinaryEncoder();
+
+    // Resend the whole string table with the next frame (new subscriber). Thread-safe.
+    void requestFullStringTable() { m_fullTableRequested = true; }
+
+    // Encode one sample. If strings were added (or a full table was requested) a string
+    // table frame is written to stringTableBuffer and true is returned; it must be sent
+    // before frameBuffer. Both buffers are reused between calls.
+    bool writeFrames(const SimConnectFlightData& data, std::string_view simVersion,
+                     std::string& stringTableBuffer, std::string& frameBuffer);
+
+    // Write the schema object describing the frame layout
+    static void writeSchema(JsonWriter& writer);
+
+private:
+    uint32_t intern(size_t slot, std::string_view text);
+    void writeHeader(std::string& buffer, uint8_t frameType, uint8_t flags);
+
+    // Cap on distinct strings before the table is reset
+    static constexpr size_t MAX_INTERNED_STRINGS = 4096;
+
+    std::atomic<bool> m_fullTableRequested{true};
+    uint64_t m_sequence = 0;
+
+    std::unordered_map<std::string, uint32_t> m_stringIds;
+    std::vector<std::string> m_strings;
+    std::vector<uint32_t> m_newStrings;
+
+    // Last value seen per text slot so unchanged strings skip the hash lookup
+    std::vector<std::string> m_slotText;
+    std::vector<uint32_t> m_slotIds;
+    std::vector<bool> m_slotValid;
+};
+
+// Decoded flight data frame
+struct DecodedFlightData {
+    uint64_t sequence = 0;
+    uint64_t timestampMs = 0;
+    std::vector<double> numbers;
+    std::vector<std::string> strings;
+};
+
+// Reference decoder for the binary format; keeps the string table between frames
+class TelemetryBinaryDecoder {
+public:
+    // Feed one binary message. Returns true (and fills out) for a complete flight data
+    // frame. Returns false for string tables, malformed input, frames older than the
+    // last string table reset, or frames that reference unknown string IDs (the client
+    // should request a resync).
+    bool decode(std::string_view frame, DecodedFlightData& out);
+
+    // Whether the last decode failed because of an unknown string ID
+    bool needsResync() const { return m_needsResync; }
+
+private:
+    std::unordered_map<uint32_t, std::string> m_strings;
+    uint64_t m_resetSequence = 0;  // Sequence of the last reset string table
+    bool m_needsResync = false;
+};
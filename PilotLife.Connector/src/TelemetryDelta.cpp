@@ -0,0 +1,47 @@
+#include "TelemetryDelta.h"
+
+TelemetryDeltaEncoder::TelemetryDeltaEncoder(std::chrono::seconds keyframeInterval)
+    : m_keyframeInterval(keyframeInterval)
+{
+}
+
+bool TelemetryDeltaEncoder::writeMessage(const SimConnectFlightData& data, std::string_view simVersion, std::string& buffer) {
+    auto now = std::chrono::steady_clock::now();
+    bool keyframe = m_keyframeRequested.exchange(false) ||
+                    m_keyframeSequence == 0 ||
+                    now - m_lastKeyframeTime >= m_keyframeInterval;
+
+    m_sequence++;
+
+    JsonWriter writer(buffer);
+    writer.reset();
+    writer.beginObject();
+
+    if (keyframe) {
+        m_keyframe = data;
+        m_keyframeSequence = m_sequence;
+        m_lastKeyframeTime = now;
+
+        writer.field("type", "flightDataKeyframe");
+        writer.field("seq", static_cast<int64_t>(m_sequence));
+        writer.key("data");
+        FlightDataEncoder::writeJson(data, simVersion, writer);
+    } else {
+        writer.field("type", "flightDataDelta");
+        writer.field("seq", static_cast<int64_t>(m_sequence));
+        writer.field("keyframeSeq", static_cast<int64_t>(m_keyframeSequence));
+        writer.key("data");
+        writer.beginObject();
+        for (const auto& field : FlightDataEncoder::getFields()) {
+            if (FlightDataEncoder::hasChanged(field, data, m_keyframe)) {
+                FlightDataEncoder::writeField(field, data, writer);
+            }
+        }
+        // Always stamp deltas so clients know the sample time
+        FlightDataEncoder::writeTimestamp(writer);
+        writer.endObject();
+    }
+
+    writer.endObject();
+    return keyframe;
+}
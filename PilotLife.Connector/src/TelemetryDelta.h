@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include "FlightData.h"
+
+// Opt-in delta encoding of the flight data stream.
+//
+// A keyframe ({"type":"flightDataKeyframe"}) carries every field. The deltas that
+// follow ({"type":"flightDataDelta"}) carry only the fields that differ from that
+// keyframe by more than the field's epsilon. Deltas are cumulative against the
+// keyframe rather than the previous delta, so a client that misses coalesced
+// deltas still has the latest state from the keyframe plus the newest delta.
+// Every message carries "seq"; deltas also carry "keyframeSeq". A client that
+// sees a keyframeSeq it never received asks for a resync, and drops any message
+// whose seq is lower than the last keyframe's.
+class TelemetryDeltaEncoder {
+public:
+    explicit TelemetryDeltaEncoder(std::chrono::seconds keyframeInterval);
+
+    // Force the next message to be a keyframe (new subscriber, resync request). Thread-safe.
+    void requestKeyframe() { m_keyframeRequested = true; }
+
+    // Write the next keyframe or delta into a reusable buffer. Returns true for a keyframe.
+    bool writeMessage(const SimConnectFlightData& data, std::string_view simVersion, std::string& buffer);
+
+private:
+    std::chrono::seconds m_keyframeInterval;
+    std::atomic<bool> m_keyframeRequested{true};
+
+    SimConnectFlightData m_keyframe{};
+    std::chrono::steady_clock::time_point m_lastKeyframeTime;
+    uint64_t m_sequence = 0;
+    uint64_t m_keyframeSequence = 0;
+};
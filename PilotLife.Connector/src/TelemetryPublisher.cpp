@@ -0,0 +1,77 @@
+#include "TelemetryPublisher.h"
+
+TelemetryPublisher::TelemetryPublisher(size_t capacity, OverflowPolicy policy)
+    : m_ring(capacity, policy)
+{
+}
+
+TelemetryPublisher::~TelemetryPublisher() {
+    stop();
+}
+
+void TelemetryPublisher::start() {
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    m_thread = std::thread(&TelemetryPublisher::publishLoop, this);
+}
+
+void TelemetryPublisher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void TelemetryPublisher::enqueue(const SimConnectFlightData& data) {
+    m_ring.push(data);
+
+    // Only pay for the mutex/notify when the publisher is parked
+    if (m_consumerWaiting.load()) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+        }
+        m_wakeCondition.notify_one();
+    }
+}
+
+void TelemetryPublisher::publishLoop() {
+    // Frames are copied out of the ring into this reused slot
+    SimConnectFlightData frame;
+
+    while (m_running) {
+        if (m_ring.pop(frame)) {
+            if (m_publishCallback) {
+                m_publishCallback(frame);
+            }
+            continue;
+        }
+
+        // Ring is empty - sleep until the producer pushes or we are stopped
+        m_consumerWaiting = true;
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCondition.wait(lock, [this] { return !m_running || !m_ring.empty(); });
+        }
+        m_consumerWaiting = false;
+    }
+}
+
+std::optional<OverflowPolicy> TelemetryPublisher::parseOverflowPolicy(const std::string& name) {
+    if (name == "drop-oldest") return OverflowPolicy::DropOldest;
+    if (name == "coalesce") return OverflowPolicy::CoalesceLatest;
+    return std::nullopt;
+}
+
+const char* TelemetryPublisher::getOverflowPolicyString(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DropOldest: return "drop-oldest";
+        case OverflowPolicy::CoalesceLatest: return "coalesce";
+        default: return "unknown";
+    }
+}
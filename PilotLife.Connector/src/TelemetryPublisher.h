@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include "FlightData.h"
+#include "SpscRing.h"
+
+// Hands raw SimConnect frames from the dispatch thread to a dedicated publisher
+// thread through a bounded SPSC ring, so serialization and WebSocket sends never
+// stall ingestion from the simulator.
+class TelemetryPublisher {
+public:
+    using PublishCallback = std::function<void(const SimConnectFlightData&)>;
+
+    TelemetryPublisher(size_t capacity, OverflowPolicy policy);
+    ~TelemetryPublisher();
+
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+    // Set the callback run on the publisher thread for each frame
+    void setPublishCallback(PublishCallback callback) { m_publishCallback = callback; }
+
+    // Start/stop the publisher thread
+    void start();
+    void stop();
+
+    // Producer side (SimConnect dispatch thread). Never blocks on the consumer.
+    void enqueue(const SimConnectFlightData& data);
+
+    // Queue counters (drops, coalesced frames, depth)
+    RingStats getStats() const { return m_ring.getStats(); }
+
+    // Parse overflow policy names used on the command line ("drop-oldest", "coalesce")
+    static std::optional<OverflowPolicy> parseOverflowPolicy(const std::string& name);
+    static const char* getOverflowPolicyString(OverflowPolicy policy);
+
+private:
+    void publishLoop();
+
+    SpscRing<SimConnectFlightData> m_ring;
+    PublishCallback m_publishCallback;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    // Only used to park the publisher thread while the ring is empty;
+    // the producer touches it only when the consumer is actually asleep
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<bool> m_consumerWaiting{false};
+};
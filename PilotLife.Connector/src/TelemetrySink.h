@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// How a broadcast message behaves when a client falls behind
+enum class DeliveryPolicy {
+    Reliable,   // Always delivered, in order (status, responses)
+    LatestWins  // Only the newest pending message is kept; older ones are coalesced (telemetry)
+};
+
+// WebSocket frame type a payload is sent as
+enum class PayloadFormat {
+    Text,
+    Binary
+};
+
+// Telemetry channels as seen by the code that publishes to them, so publishers
+// need neither ixwebsocket nor a running server (WebSocketServer in the connector,
+// a recording fake in tests). Every client is on exactly one channel.
+class TelemetrySink {
+public:
+    // Immutable, ref-counted message shared by every client it is sent to
+    using Payload = std::shared_ptr<const std::string>;
+
+    virtual ~TelemetrySink() = default;
+
+    // Send a payload only to clients on the given telemetry channel
+    virtual void publish(const std::string& channel, const Payload& payload, DeliveryPolicy policy,
+                         PayloadFormat format = PayloadFormat::Text) = 0;
+
+    // Fill channels with every telemetry channel that has at least one client
+    virtual void getActiveTelemetryChannels(std::vector<std::string>& channels) const = 0;
+};
@@ -0,0 +1,119 @@
+#include "TelemetrySubscription.h"
+#include <charconv>
+
+static constexpr std::string_view CHANNEL_PREFIX = "fields:";
+
+static const FieldGroup ALL_GROUPS[] = {
+    FIELD_GROUP_METADATA, FIELD_GROUP_POSITION, FIELD_GROUP_SPEED,
+    FIELD_GROUP_HEADING, FIELD_GROUP_WEIGHT, FIELD_GROUP_RADIOS
+};
+
+std::optional<TelemetrySubscription> TelemetrySubscription::fromRequest(const std::vector<std::string>& groupNames,
+                                                                        int maxRateHz, std::string& error) {
+    TelemetrySubscription subscription;
+    subscription.groups = 0;
+    for (const auto& name : groupNames) {
+        auto group = FlightDataEncoder::parseFieldGroup(name);
+        if (!group.has_value()) {
+            error = "Unknown field group: " + name;
+            return std::nullopt;
+        }
+        subscription.groups |= group.value();
+    }
+    if (subscription.groups == 0) {
+        error = "No field groups given";
+        return std::nullopt;
+    }
+    if (maxRateHz < 0 || maxRateHz > MAX_RATE_HZ) {
+        error = "maxRate out of range";
+        return std::nullopt;
+    }
+    subscription.maxRateHz = maxRateHz;
+    return subscription;
+}
+
+std::string TelemetrySubscription::channelName() const {
+    char buf[32];
+    char* end = std::to_chars(buf, buf + sizeof(buf), groups & FIELD_GROUP_ALL, 16).ptr;
+    *end++ = '@';
+    end = std::to_chars(end, buf + sizeof(buf), maxRateHz).ptr;
+
+    std::string name(CHANNEL_PREFIX);
+    name.append(buf, end - buf);
+    return name;
+}
+
+std::optional<TelemetrySubscription> TelemetrySubscription::fromChannel(std::string_view channel) {
+    if (channel.substr(0, CHANNEL_PREFIX.size()) != CHANNEL_PREFIX) {
+        return std::nullopt;
+    }
+    channel.remove_prefix(CHANNEL_PREFIX.size());
+
+    size_t at = channel.find('@');
+    if (at == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    TelemetrySubscription subscription;
+    const char* groupsEnd = channel.data() + at;
+    const char* rateEnd = channel.data() + channel.size();
+    auto groupsResult = std::from_chars(channel.data(), groupsEnd, subscription.groups, 16);
+    auto rateResult = std::from_chars(groupsEnd + 1, rateEnd, subscription.maxRateHz);
+    if (groupsResult.ec != std::errc() || groupsResult.ptr != groupsEnd ||
+        rateResult.ec != std::errc() || rateResult.ptr != rateEnd ||
+        subscription.maxRateHz < 0) {
+        return std::nullopt;
+    }
+    return subscription;
+}
+
+void TelemetrySubscription::writeGroups(JsonWriter& writer) const {
+    writer.beginArray();
+    for (FieldGroup group : ALL_GROUPS) {
+        if (groups & group) {
+            writer.value(FlightDataEncoder::getFieldGroupString(group));
+        }
+    }
+    writer.endArray();
+}
+
+void TelemetrySubscriptionPublisher::publish(const SimConnectFlightData& data, std::string_view simVersion,
+                                             TelemetrySink& sink) {
+    sink.getActiveTelemetryChannels(m_activeChannels);
+
+    // Forget channels nobody is on any more
+    for (auto it = m_channels.begin(); it != m_channels.end();) {
+        bool active = false;
+        for (const auto& channel : m_activeChannels) {
+            if (channel == it->first) {
+                active = true;
+                break;
+            }
+        }
+        it = active ? std::next(it) : m_channels.erase(it);
+    }
+
+    auto now = Clock::now();
+    for (const auto& channel : m_activeChannels) {
+        auto it = m_channels.find(channel);
+        if (it == m_channels.end()) {
+            auto subscription = TelemetrySubscription::fromChannel(channel);
+            if (!subscription.has_value()) {
+                continue;  // Another wire format's channel
+            }
+            it = m_channels.emplace(channel, ChannelState{ subscription.value(), Clock::time_point{} }).first;
+        }
+
+        ChannelState& state = it->second;
+        if (state.subscription.maxRateHz > 0 &&
+            now - state.lastSent < std::chrono::microseconds(1000000 / state.subscription.maxRateHz)) {
+            continue;
+        }
+        state.lastSent = now;
+
+        // Serialized once, shared by every client on the channel
+        auto payload = state.payloads.acquire();
+        FlightDataEncoder::writeMessage(data, simVersion, state.subscription.groups, *payload);
+        sink.publish(channel, std::move(payload), DeliveryPolicy::LatestWins);
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "FlightData.h"
+#include "PayloadPool.h"
+#include "TelemetrySink.h"
+
+// A client's choice of field groups and maximum update rate.
+//
+// Each distinct subscription maps to one telemetry channel, so every client with
+// the same groups and rate shares a single serialized buffer per sample; encoding
+// cost grows with the number of distinct subscriptions, not with client count.
+struct TelemetrySubscription {
+    uint32_t groups = FIELD_GROUP_ALL;
+    int maxRateHz = 0;  // 0 = every sample the simulator delivers
+
+    static constexpr int MAX_RATE_HZ = 1000;
+
+    // Build a subscription from a subscribeTelemetry request (group names in any order);
+    // nullopt with error set for unknown or missing groups or a rate out of range
+    static std::optional<TelemetrySubscription> fromRequest(const std::vector<std::string>& groupNames, int maxRateHz,
+                                                            std::string& error);
+
+    // Canonical channel name, e.g. "fields:a@10" (equal subscriptions give equal names)
+    std::string channelName() const;
+
+    // Parse a channel produced by channelName(); nullopt for any other channel
+    static std::optional<TelemetrySubscription> fromChannel(std::string_view channel);
+
+    // Write the groups as an array of names
+    void writeGroups(JsonWriter& writer) const;
+};
+
+// Encodes and publishes the flightData stream for every active subscription channel
+class TelemetrySubscriptionPublisher {
+public:
+    // Publish one sample to each subscription channel that is due under its rate limit.
+    // Call from the telemetry publisher thread only.
+    void publish(const SimConnectFlightData& data, std::string_view simVersion, TelemetrySink& sink);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ChannelState {
+        TelemetrySubscription subscription;
+        Clock::time_point lastSent;
+        PayloadPool payloads{4};  // Serialized samples shared with the channel's clients
+    };
+
+    // Parsed channels, kept while they have subscribers
+    std::unordered_map<std::string, ChannelState> m_channels;
+
+    // Reused between samples
+    std::vector<std::string> m_activeChannels;
+};
@@ -0,0 +1,95 @@
+#include "TitleIndex.h"
+
+void TitleIndex::insert(std::string_view key, const IndexedAircraft* aircraft) {
+    if ((m_entries.size() + 1) * 2 > m_slots.size()) {
+        grow();
+    }
+
+    uint32_t hash = hashKey(key);
+    size_t slot = findSlot(key, hash);
+    if (m_slots[slot] != 0) {
+        m_entries[m_slots[slot] - 1].aircraft = aircraft;
+        return;
+    }
+
+    m_entries.push_back({ static_cast<uint32_t>(m_keys.size()), static_cast<uint32_t>(key.size()), hash, aircraft });
+    m_keys.append(key.data(), key.size());
+    m_slots[slot] = static_cast<uint32_t>(m_entries.size());
+}
+
+const IndexedAircraft* TitleIndex::find(std::string_view title) const {
+    if (m_entries.empty()) {
+        return nullptr;
+    }
+
+    // Normalizing never lengthens a title, so it fits a buffer of the same size
+    char stackBuffer[MAX_STACK_TITLE];
+    std::string heapBuffer;
+    char* buffer = stackBuffer;
+    if (title.size() > sizeof(stackBuffer)) {
+        heapBuffer.resize(title.size());
+        buffer = &heapBuffer[0];
+    }
+    std::string_view key(buffer, normalize(title, buffer));
+
+    uint32_t slot = m_slots[findSlot(key, hashKey(key))];
+    return slot != 0 ? m_entries[slot - 1].aircraft : nullptr;
+}
+
+std::string_view TitleIndex::key(size_t id) const {
+    const Entry& entry = m_entries[id];
+    return std::string_view(m_keys.data() + entry.offset, entry.length);
+}
+
+size_t TitleIndex::normalize(std::string_view title, char* out) {
+    size_t length = 0;
+    for (char ch : title) {
+        if (ch == ' ' && length > 0 && out[length - 1] == ' ') {
+            continue;
+        }
+        // ASCII only, like tolower() in the "C" locale the connector runs in
+        out[length++] = (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+    }
+    return length;
+}
+
+std::string TitleIndex::normalize(std::string_view title) {
+    std::string normalized(title.size(), '\0');
+    normalized.resize(normalize(title, &normalized[0]));
+    return normalized;
+}
+
+uint32_t TitleIndex::hashKey(std::string_view key) {
+    // FNV-1a; titles are short, so a simple byte-wise hash is as fast as anything fancier
+    uint32_t hash = 2166136261u;
+    for (char ch : key) {
+        hash = (hash ^ static_cast<unsigned char>(ch)) * 16777619u;
+    }
+    return hash;
+}
+
+size_t TitleIndex::findSlot(std::string_view key, uint32_t hash) const {
+    size_t mask = m_slots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t id = m_slots[slot];
+        if (id == 0) {
+            return slot;
+        }
+        const Entry& entry = m_entries[id - 1];
+        if (entry.hash == hash && this->key(id - 1) == key) {
+            return slot;
+        }
+    }
+}
+
+void TitleIndex::grow() {
+    m_slots.assign(m_slots.empty() ? 16 : m_slots.size() * 2, 0);
+    size_t mask = m_slots.size() - 1;
+    for (size_t id = 0; id < m_entries.size(); id++) {
+        size_t slot = m_entries[id].hash & mask;
+        while (m_slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = static_cast<uint32_t>(id + 1);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct IndexedAircraft;
+
+// Exact lookup of normalized titles. Keys are normalized once when the index
+// is built and stored back to back in one string; an open-addressing table
+// (linear probing, at most half full) maps each key to its entry, so a lookup
+// is one hash plus, usually, one key compare against contiguous memory.
+//
+// Entries keep the order in which their keys were first inserted; ids
+// (0..size()-1) are stable for the life of the index. Built once per index
+// snapshot and read-only afterwards.
+class TitleIndex {
+public:
+    // Longest title normalized on the stack by find(); SimConnect titles are at most 256 bytes
+    static constexpr size_t MAX_STACK_TITLE = 256;
+
+    // Map a key that is already normalized to an aircraft; a later insert of the same key replaces the aircraft
+    void insert(std::string_view key, const IndexedAircraft* aircraft);
+
+    // Aircraft for a title (normalized here, without allocating); nullptr if absent
+    const IndexedAircraft* find(std::string_view title) const;
+
+    size_t size() const { return m_entries.size(); }
+    std::string_view key(size_t id) const;
+    const IndexedAircraft* aircraft(size_t id) const { return m_entries[id].aircraft; }
+
+    // Lowercase and collapse runs of spaces. Writes at most title.size() chars to out
+    // and returns how many were written.
+    static size_t normalize(std::string_view title, char* out);
+    static std::string normalize(std::string_view title);
+
+private:
+    struct Entry {
+        uint32_t offset;    // Into m_keys
+        uint32_t length;
+        uint32_t hash;
+        const IndexedAircraft* aircraft;
+    };
+
+    static uint32_t hashKey(std::string_view key);
+
+    // Slot holding key, or the empty slot where it would go
+    size_t findSlot(std::string_view key, uint32_t hash) const;
+
+    void grow();
+
+    std::string m_keys;
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_slots;  // Entry id + 1; 0 = empty. Size is a power of two.
+};
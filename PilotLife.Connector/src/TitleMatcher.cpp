@@ -0,0 +1,123 @@
+#include "TitleMatcher.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+void TitleMatcher::add(std::string_view title) {
+    uint32_t id = static_cast<uint32_t>(m_trigramCounts.size());
+
+    std::vector<uint32_t> trigrams;
+    collectTrigrams(title, trigrams);
+    for (uint32_t trigram : trigrams) {
+        m_postings[trigram].push_back(id);
+    }
+    m_trigramCounts.push_back(static_cast<uint16_t>(
+        std::min<size_t>(trigrams.size(), std::numeric_limits<uint16_t>::max())));
+}
+
+std::vector<TitleMatcher::Match> TitleMatcher::find(std::string_view title, size_t limit, const TieBreak& tieBreak) const {
+    std::vector<Match> matches;
+    if (limit == 0 || m_trigramCounts.empty()) {
+        return matches;
+    }
+
+    // Per-thread scratch space, so queries stop allocating once it has grown to the index size
+    thread_local std::vector<uint32_t> queryTrigrams;
+    thread_local std::vector<uint16_t> shared;      // Trigrams each title shares with the query
+    thread_local std::vector<uint32_t> touched;     // Titles with a non-zero entry in 'shared'
+    thread_local std::vector<Match> candidates;
+
+    collectTrigrams(title, queryTrigrams);
+    if (queryTrigrams.empty()) {
+        return matches;
+    }
+    if (shared.size() < m_trigramCounts.size()) {
+        shared.resize(m_trigramCounts.size(), 0);
+    }
+
+    touched.clear();
+    for (uint32_t trigram : queryTrigrams) {
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end()) continue;
+        for (uint32_t id : it->second) {
+            if (shared[id]++ == 0) {
+                touched.push_back(id);
+            }
+        }
+    }
+
+    candidates.clear();
+    double queryCount = static_cast<double>(queryTrigrams.size());
+    for (uint32_t id : touched) {
+        double common = shared[id];
+        double titleCount = m_trigramCounts[id];
+        double dice = 2.0 * common / (queryCount + titleCount);
+        double overlap = common / std::min(queryCount, titleCount);
+        candidates.push_back({ id, (dice + overlap) / 2.0 });
+        shared[id] = 0;
+    }
+
+    // Keep the best 'limit' scores plus anything tied with the last of them, so the
+    // tie-break decides between equal titles instead of the posting list order
+    auto byScore = [](const Match& a, const Match& b) { return a.score > b.score; };
+    auto end = candidates.end();
+    if (candidates.size() > limit) {
+        std::nth_element(candidates.begin(), candidates.begin() + (limit - 1), candidates.end(), byScore);
+        double cutoff = candidates[limit - 1].score;
+        end = std::partition(candidates.begin(), candidates.end(),
+                             [cutoff](const Match& match) { return match.score >= cutoff; });
+    }
+
+    std::vector<std::pair<Match, int>> ranked;
+    ranked.reserve(end - candidates.begin());
+    for (auto it = candidates.begin(); it != end; ++it) {
+        ranked.push_back({ *it, tieBreak ? tieBreak(it->id) : 0 });
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        if (a.first.score != b.first.score) return a.first.score > b.first.score;
+        if (a.second != b.second) return a.second > b.second;
+        return a.first.id < b.first.id;
+    });
+
+    size_t count = std::min(limit, ranked.size());
+    matches.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        matches.push_back(ranked[i].first);
+    }
+    return matches;
+}
+
+void TitleMatcher::collectTrigrams(std::string_view title, std::vector<uint32_t>& trigrams) {
+    trigrams.clear();
+
+    // Sliding window over " words of the title ", where any run of characters other
+    // than letters and digits counts as one space: "Cessna-172" and "cessna  172"
+    // look the same, and trigrams spanning a space keep word order ("7 l" in
+    // "aircraft 7 livery 3" is not in "aircraft 3 livery 7")
+    uint32_t window = static_cast<uint32_t>(' ');
+    size_t length = 1;
+    bool afterSpace = true;
+    auto push = [&](unsigned char c) {
+        window = ((window << 8) | c) & 0xFFFFFF;
+        if (++length >= 3) {
+            trigrams.push_back(window);
+        }
+    };
+
+    for (char ch : title) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (std::isalnum(c) || c >= 0x80) {   // UTF-8 sequences stay part of their word
+            push(static_cast<unsigned char>(std::tolower(c)));
+            afterSpace = false;
+        } else if (!afterSpace) {
+            push(' ');
+            afterSpace = true;
+        }
+    }
+    if (!afterSpace) {
+        push(' ');
+    }
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
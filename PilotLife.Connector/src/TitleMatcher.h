@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Approximate matching of aircraft titles. Each title is broken into character
+// trigrams (padded with a space at each end, so word starts and ends count), and
+// an inverted index maps every trigram to the titles that contain it. A query
+// only touches the posting lists of its own trigrams, so its cost depends on how
+// many titles share trigrams with it, not on how many titles there are.
+//
+// Scores are in [0, 1]: the average of the Dice coefficient (penalizes extra
+// words on either side) and the overlap coefficient (1.0 when one title is
+// contained in the other, e.g. a livery name added or left off). Built once per
+// index snapshot and read-only afterwards, so concurrent queries need no lock.
+class TitleMatcher {
+public:
+    struct Match {
+        uint32_t id;        // Order in which the title was added
+        double score;
+    };
+
+    // Prefers one of several equally scored titles; higher wins
+    using TieBreak = std::function<int(uint32_t id)>;
+
+    // Add a title; its id is the number of titles added before it
+    void add(std::string_view title);
+
+    size_t size() const { return m_trigramCounts.size(); }
+
+    // Up to limit titles sharing trigrams with the query, best first. Equal scores
+    // are ordered by tieBreak (if given), then by id.
+    std::vector<Match> find(std::string_view title, size_t limit, const TieBreak& tieBreak) const;
+
+private:
+    // Distinct trigrams of a title, each packed into the low 24 bits
+    static void collectTrigrams(std::string_view title, std::vector<uint32_t>& trigrams);
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;   // Trigram -> ids of titles containing it
+    std::vector<uint16_t> m_trigramCounts;                            // Distinct trigrams per title
+};
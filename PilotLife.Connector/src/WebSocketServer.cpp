@@ -1,6 +1,11 @@
 #include "WebSocketServer.h"
+#include "JsonWriter.h"
+#include <algorithm>
 #include <iostream>
 
+// How often held-back messages are retried while a client's socket is full
+constexpr std::chrono::milliseconds RETRY_INTERVAL{50};
+
 WebSocketServer::WebSocketServer(int port)
     : m_port(port)
     , m_server(port, "127.0.0.1")
@@ -14,6 +19,8 @@ WebSocketServer::WebSocketServer(int port)
                 std::cout << "Client connected from: "
                           << connectionState->getRemoteIp() << std::endl;
 
+                this->addSession(webSocket, *connectionState);
+
                 // Notify callback of new client connection
                 if (this->m_clientConnectedCallback) {
                     this->m_clientConnectedCallback(webSocket);
@@ -21,21 +28,16 @@ WebSocketServer::WebSocketServer(int port)
             }
             else if (msg->type == ix::WebSocketMessageType::Close) {
                 std::cout << "Client disconnected" << std::endl;
+                this->removeSession(webSocket);
             }
             else if (msg->type == ix::WebSocketMessageType::Error) {
                 std::cerr << "WebSocket error: " << msg->errorInfo.reason << std::endl;
             }
             else if (msg->type == ix::WebSocketMessageType::Message) {
                 std::cout << "Received message: " << msg->str << std::endl;
-                // Handle incoming messages via message handler
+                // The handler replies through sendTo, so a slow request never blocks this socket thread
                 if (this->m_messageHandler) {
-                    std::string response = this->m_messageHandler(msg->str, webSocket);
-                    if (!response.empty()) {
-                        std::cout << "Sending response (" << response.length() << " bytes)" << std::endl;
-                        webSocket.send(response);
-                    } else {
-                        std::cout << "No response to send (empty)" << std::endl;
-                    }
+                    this->m_messageHandler(msg->str, this->getClientId(webSocket));
                 } else {
                     std::cout << "No message handler set" << std::endl;
                 }
@@ -58,31 +60,382 @@ bool WebSocketServer::start() {
 
     m_server.start();
     m_running = true;
+    m_fanOutThread = std::thread(&WebSocketServer::fanOutLoop, this);
     std::cout << "WebSocket server started on ws://127.0.0.1:" << m_port << std::endl;
     return true;
 }
 
 void WebSocketServer::stop() {
     if (m_running) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+        m_fanOutCondition.notify_one();
+        if (m_fanOutThread.joinable()) {
+            m_fanOutThread.join();
+        }
+
         m_server.stop();
-        m_running = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_sessions.clear();
+            m_channelSubscribers.clear();
+        }
         std::cout << "WebSocket server stopped" << std::endl;
     }
 }
 
-void WebSocketServer::broadcast(const std::string& message) {
+WebSocketServer::Payload WebSocketServer::makePayload(std::string message) {
+    return std::make_shared<const std::string>(std::move(message));
+}
+
+void WebSocketServer::broadcast(const std::string& message, DeliveryPolicy policy) {
+    broadcast(makePayload(message), policy);
+}
+
+void WebSocketServer::broadcast(std::string&& message, DeliveryPolicy policy) {
+    broadcast(makePayload(std::move(message)), policy);
+}
+
+void WebSocketServer::broadcast(const Payload& payload, DeliveryPolicy policy) {
+    enqueue(payload, policy, PayloadFormat::Text, nullptr);
+}
+
+void WebSocketServer::publish(const std::string& channel, const Payload& payload, DeliveryPolicy policy,
+                              PayloadFormat format) {
+    enqueue(payload, policy, format, &channel);
+}
+
+void WebSocketServer::sendTo(const std::string& clientId, const Payload& payload) {
+    enqueue(payload, DeliveryPolicy::Reliable, PayloadFormat::Text, nullptr, &clientId);
+}
+
+void WebSocketServer::sendTo(const std::string& clientId, const std::string& message) {
+    sendTo(clientId, makePayload(message));
+}
+
+void WebSocketServer::sendTo(const std::string& clientId, std::string&& message) {
+    sendTo(clientId, makePayload(std::move(message)));
+}
+
+std::string WebSocketServer::getClientId(ix::WebSocket& client) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_sessions.find(&client);
+    return it != m_sessions.end() ? it->second->id : std::string();
+}
+
+void WebSocketServer::enqueue(const Payload& payload, DeliveryPolicy policy, PayloadFormat format, const std::string* channel,
+                              const std::string* clientId) {
+    // Clients that overflowed their reliable queue; closed outside the locks
+    std::vector<std::shared_ptr<ix::WebSocket>> slowClients;
+    auto now = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_sessions.empty()) {
+            return;
+        }
+
+        // Each client only gets a reference to the shared payload
+        for (auto& [socket, session] : m_sessions) {
+            if (channel && session->telemetryChannel != *channel) continue;
+            if (clientId && session->id != *clientId) continue;
+
+            std::lock_guard<std::mutex> sessionLock(session->mutex);
+            if (session->closing) continue;
+
+            if (policy == DeliveryPolicy::LatestWins) {
+                // Replace any unsent frame but keep its queue time so lag reflects the oldest undelivered data
+                if (session->latestTelemetry.payload) {
+                    session->telemetryCoalesced++;
+                    session->latestTelemetry.payload = payload;
+                    session->latestTelemetry.format = format;
+                } else {
+                    session->latestTelemetry = { payload, now, format };
+                }
+                continue;
+            }
+
+            // Reliable messages are never dropped; a client that cannot keep up with them is disconnected
+            if (session->reliable.size() >= m_limits.maxQueuedMessages ||
+                session->reliableBytes + payload->size() > m_limits.maxQueuedBytes) {
+                session->closing = true;
+                session->reliable.clear();
+                session->reliableBytes = 0;
+                session->latestTelemetry = {};
+                slowClients.push_back(session->socket);
+                continue;
+            }
+            session->reliable.push_back({ payload, now, format });
+            session->reliableBytes += payload->size();
+
+            // Reliable messages go out ahead of telemetry, so a frame published before this one
+            // (e.g. a delta older than a new keyframe) would reach the client after it; drop it
+            if (channel && session->latestTelemetry.payload) {
+                session->telemetryCoalesced++;
+                session->latestTelemetry = {};
+            }
+        }
+        m_fanOutPending = true;
+    }
+    m_fanOutCondition.notify_one();
+
+    for (auto& socket : slowClients) {
+        std::cerr << "Disconnecting slow client: outbound queue limit exceeded" << std::endl;
+        socket->close();
+    }
+}
+
+void WebSocketServer::addSession(ix::WebSocket& webSocket, ix::ConnectionState& connectionState) {
+    // Hold the server's shared_ptr so the socket outlives any queued sends
+    std::shared_ptr<ix::WebSocket> socket;
+    for (auto&& client : m_server.getClients()) {
+        if (client.get() == &webSocket) {
+            socket = client;
+            break;
+        }
+    }
+    if (!socket) {
+        return;
+    }
+
+    auto session = std::make_shared<ClientSession>();
+    session->socket = socket;
+    session->id = connectionState.getId();
+    session->remoteIp = connectionState.getRemoteIp();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sessions[&webSocket] = session;
+    m_channelSubscribers[session->telemetryChannel]++;
+}
+
+void WebSocketServer::removeSession(ix::WebSocket& webSocket) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_sessions.find(&webSocket);
+    if (it == m_sessions.end()) {
+        return;
+    }
+    releaseChannel(it->second->telemetryChannel);
+    m_sessions.erase(it);
+}
+
+void WebSocketServer::releaseChannel(const std::string& channel) {
+    // Drop empty channels so one-off subscriptions do not accumulate
+    auto it = m_channelSubscribers.find(channel);
+    if (it != m_channelSubscribers.end() && --it->second == 0) {
+        m_channelSubscribers.erase(it);
+    }
+}
+
+void WebSocketServer::setTelemetryChannel(const std::string& clientId, const std::string& channel) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_sessions.begin(), m_sessions.end(),
+                           [&clientId](const auto& entry) { return entry.second->id == clientId; });
+    if (it == m_sessions.end() || it->second->telemetryChannel == channel) {
+        return;
+    }
+
+    releaseChannel(it->second->telemetryChannel);
+    m_channelSubscribers[channel]++;
+    it->second->telemetryChannel = channel;
+
+    // Frames already pending were encoded for the old channel
+    std::lock_guard<std::mutex> sessionLock(it->second->mutex);
+    it->second->latestTelemetry = {};
+}
+
+bool WebSocketServer::hasSubscribers(const std::string& channel) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_channelSubscribers.find(channel);
+    return it != m_channelSubscribers.end() && it->second > 0;
+}
+
+void WebSocketServer::getActiveTelemetryChannels(std::vector<std::string>& channels) const {
+    channels.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [channel, count] : m_channelSubscribers) {
+        if (count > 0) {
+            channels.push_back(channel);
+        }
+    }
+}
+
+void WebSocketServer::setBackpressureLimits(const BackpressureLimits& limits) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    m_limits = limits;
+}
+
+void WebSocketServer::fanOutLoop() {
+    // Reused between wake-ups so steady-state fan-out does not allocate
+    std::vector<std::shared_ptr<ClientSession>> sessions;
+    bool heldBack = false;
+
+    while (true) {
+        size_t maxSocketBufferedBytes;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ready = [this] { return m_fanOutPending || !m_running; };
+            if (heldBack) {
+                // Retry held-back messages even if nothing new is broadcast
+                m_fanOutCondition.wait_for(lock, RETRY_INTERVAL, ready);
+            } else {
+                m_fanOutCondition.wait(lock, ready);
+            }
+            if (!m_running) {
+                break;
+            }
+            m_fanOutPending = false;
+            maxSocketBufferedBytes = m_limits.maxSocketBufferedBytes;
 
-    auto clients = m_server.getClients();
-    for (auto&& client : clients) {
-        if (client->getReadyState() == ix::ReadyState::Open) {
-            client->send(message);
+            sessions.clear();
+            for (auto& [socket, session] : m_sessions) {
+                sessions.push_back(session);
+            }
         }
+
+        // Send outside the server lock so broadcasts and connects never wait on a socket
+        heldBack = false;
+        for (auto& session : sessions) {
+            if (flushSession(*session, maxSocketBufferedBytes)) {
+                heldBack = true;
+            }
+        }
+        sessions.clear();
+    }
+}
+
+bool WebSocketServer::flushSession(ClientSession& session, size_t maxSocketBufferedBytes) {
+    ix::WebSocket& socket = *session.socket;
+    if (socket.getReadyState() != ix::ReadyState::Open) {
+        std::lock_guard<std::mutex> sessionLock(session.mutex);
+        session.reliable.clear();
+        session.reliableBytes = 0;
+        session.latestTelemetry = {};
+        return false;
+    }
+
+    // Hand the socket only what it can take: while it still has a backlog, messages
+    // stay in the client's queue, where they count toward its limits and a client
+    // that stops reading is disconnected instead of growing the socket buffer
+    bool heldBack = false;
+    for (;;) {
+        bool socketFull = socket.bufferedAmount() > maxSocketBufferedBytes;
+
+        QueuedPayload queued;
+        bool isTelemetry = false;
+        {
+            std::lock_guard<std::mutex> sessionLock(session.mutex);
+            if (session.closing) {
+                return false;
+            }
+
+            if (!session.reliable.empty()) {
+                // Reliable messages go out in order, ahead of telemetry that may depend on them
+                if (socketFull) {
+                    heldBack = true;
+                    break;
+                }
+                queued = std::move(session.reliable.front());
+                session.reliable.pop_front();
+                session.reliableBytes -= queued.payload->size();
+            } else if (session.latestTelemetry.payload) {
+                // A newer frame replaces held-back telemetry meanwhile
+                if (socketFull) {
+                    session.telemetryDeferred++;
+                    heldBack = true;
+                    break;
+                }
+                queued = std::move(session.latestTelemetry);
+                session.latestTelemetry = {};
+                isTelemetry = true;
+            } else {
+                break;
+            }
+        }
+
+        socket.send(*queued.payload, queued.format == PayloadFormat::Binary);
+
+        std::lock_guard<std::mutex> sessionLock(session.mutex);
+        session.messagesSent++;
+        session.bytesSent += queued.payload->size();
+        if (isTelemetry) {
+            break;
+        }
+    }
+    return heldBack;
+}
+
+std::vector<ClientStats> WebSocketServer::getClientStats() const {
+    std::vector<ClientStats> result;
+    auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    result.reserve(m_sessions.size());
+    for (const auto& [socket, session] : m_sessions) {
+        ClientStats stats;
+        std::lock_guard<std::mutex> sessionLock(session->mutex);
+        stats.id = session->id;
+        stats.remoteIp = session->remoteIp;
+        stats.telemetryChannel = session->telemetryChannel;
+        stats.messagesSent = session->messagesSent;
+        stats.bytesSent = session->bytesSent;
+        stats.telemetryCoalesced = session->telemetryCoalesced;
+        stats.telemetryDeferred = session->telemetryDeferred;
+        stats.queuedMessages = session->reliable.size() + (session->latestTelemetry.payload ? 1 : 0);
+        stats.queuedBytes = session->reliableBytes +
+            (session->latestTelemetry.payload ? session->latestTelemetry.payload->size() : 0);
+        stats.socketBufferedBytes = session->socket->bufferedAmount();
+
+        // Lag is the age of the oldest message still waiting for the socket
+        Clock::time_point oldest = now;
+        if (!session->reliable.empty()) {
+            oldest = std::min(oldest, session->reliable.front().queuedAt);
+        }
+        if (session->latestTelemetry.payload) {
+            oldest = std::min(oldest, session->latestTelemetry.queuedAt);
+        }
+        stats.lagMs = std::chrono::duration<double, std::milli>(now - oldest).count();
+
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+std::string WebSocketServer::toClientStatsResponse(const std::string& requestId) const {
+    auto clients = getClientStats();
+
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "clientStats");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.key("clients");
+    json.beginArray();
+    for (const auto& client : clients) {
+        json.beginObject();
+        json.field("id", client.id);
+        json.field("remoteIp", client.remoteIp);
+        json.field("telemetryChannel", client.telemetryChannel);
+        json.field("messagesSent", static_cast<int64_t>(client.messagesSent));
+        json.field("bytesSent", static_cast<int64_t>(client.bytesSent));
+        json.field("telemetryCoalesced", static_cast<int64_t>(client.telemetryCoalesced));
+        json.field("telemetryDeferred", static_cast<int64_t>(client.telemetryDeferred));
+        json.field("queuedMessages", client.queuedMessages);
+        json.field("queuedBytes", client.queuedBytes);
+        json.field("socketBufferedBytes", client.socketBufferedBytes);
+        json.field("lagMs", client.lagMs, 1);
+        json.endObject();
     }
+    json.endArray();
+    json.endObject();
+    json.endObject();
+    return buffer;
 }
 
 size_t WebSocketServer::getClientCount() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    // getClients() is non-const, so cast away const (safe for read-only access)
-    return const_cast<ix::WebSocketServer&>(m_server).getClients().size();
+    return m_sessions.size();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#ifdef _WIN32
 // Must include winsock2.h before any other Windows headers
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -7,6 +8,7 @@
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #include <windows.h>
+#endif
 
 #include <IXWebSocketServer.h>
 #include <string>
@@ -14,12 +16,43 @@
 #include <atomic>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include "TelemetrySink.h"
+
+// Per-client outbound limits
+struct BackpressureLimits {
+    size_t maxQueuedMessages = 256;             // Reliable messages waiting for the fan-out thread
+    size_t maxQueuedBytes = 8 * 1024 * 1024;    // Bytes of reliable messages waiting for the fan-out thread
+    size_t maxSocketBufferedBytes = 1024 * 1024;  // Unsent bytes in the socket before messages are held in the queue
+};
 
-class WebSocketServer {
+// Lag metrics for one connected client
+struct ClientStats {
+    std::string id;
+    std::string remoteIp;
+    std::string telemetryChannel;
+    uint64_t messagesSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t telemetryCoalesced = 0;  // Telemetry frames replaced by a newer one before being sent
+    uint64_t telemetryDeferred = 0;   // Fan-out passes that held telemetry back because the socket was full
+    size_t queuedMessages = 0;
+    size_t queuedBytes = 0;
+    size_t socketBufferedBytes = 0;
+    double lagMs = 0.0;               // Age of the oldest message not yet handed to the socket
+};
+
+class WebSocketServer : public TelemetrySink {
 public:
     using ClientConnectedCallback = std::function<void(ix::WebSocket&)>;
-    // Message handler receives the message string and the client WebSocket, returns response to send
-    using MessageHandler = std::function<std::string(const std::string& message, ix::WebSocket& client)>;
+    // Message handler receives the message string and the sender's connection id; it runs on
+    // the client's socket thread, so it should hand real work off and reply with sendTo
+    using MessageHandler = std::function<void(const std::string& message, const std::string& clientId)>;
 
     explicit WebSocketServer(int port);
     ~WebSocketServer();
@@ -31,8 +64,44 @@ public:
     // Check if server is running
     bool isRunning() const { return m_running; }
 
-    // Broadcast message to all connected clients
-    void broadcast(const std::string& message);
+    // Broadcast message to all connected clients.
+    // The payload is queued by reference on every client and sent from the fan-out thread,
+    // so the caller never waits on a client socket.
+    void broadcast(const Payload& payload, DeliveryPolicy policy = DeliveryPolicy::Reliable);
+    void broadcast(const std::string& message, DeliveryPolicy policy = DeliveryPolicy::Reliable);
+    void broadcast(std::string&& message, DeliveryPolicy policy = DeliveryPolicy::Reliable);
+
+    // Wrap a serialized message so it can be shared between clients without copying
+    static Payload makePayload(std::string message);
+
+    // Telemetry channels: every client receives telemetry on exactly one channel
+    // (its chosen wire format), starting on DEFAULT_TELEMETRY_CHANNEL.
+    static constexpr const char* DEFAULT_TELEMETRY_CHANNEL = "json";
+
+    // Send a payload only to clients on the given telemetry channel. A Reliable payload
+    // (keyframe, string table) discards the channel's pending LatestWins frame, which was
+    // published before it and would otherwise be sent after it.
+    void publish(const std::string& channel, const Payload& payload, DeliveryPolicy policy,
+                 PayloadFormat format = PayloadFormat::Text) override;
+
+    // Queue a reliable message for one client, e.g. a response that is ready after the
+    // request handler returned; dropped if that client has disconnected.
+    // Pass the message as an rvalue (or a Payload) to queue it without copying.
+    void sendTo(const std::string& clientId, const Payload& payload);
+    void sendTo(const std::string& clientId, const std::string& message);
+    void sendTo(const std::string& clientId, std::string&& message);
+
+    // Connection id of a client (stays unique after the socket is gone, unlike its address)
+    std::string getClientId(ix::WebSocket& client) const;
+
+    // Move a client (by id) to another telemetry channel; ignored if it has disconnected
+    void setTelemetryChannel(const std::string& clientId, const std::string& channel);
+
+    // Whether any client is on the channel (lets publishers skip unused encodings)
+    bool hasSubscribers(const std::string& channel) const;
+
+    // Fill channels with every telemetry channel that has at least one client
+    void getActiveTelemetryChannels(std::vector<std::string>& channels) const override;
 
     // Get connected client count
     size_t getClientCount() const;
@@ -40,6 +109,15 @@ public:
     // Get the port the server is running on
     int getPort() const { return m_port; }
 
+    // Set per-client outbound limits (applies to new and existing clients)
+    void setBackpressureLimits(const BackpressureLimits& limits);
+
+    // Per-client lag metrics
+    std::vector<ClientStats> getClientStats() const;
+
+    // Create a JSON response with per-client lag metrics
+    std::string toClientStatsResponse(const std::string& requestId) const;
+
     // Set callback for when a client connects
     void setClientConnectedCallback(ClientConnectedCallback callback) {
         m_clientConnectedCallback = callback;
@@ -51,10 +129,63 @@ public:
     }
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct QueuedPayload {
+        Payload payload;
+        Clock::time_point queuedAt;
+        PayloadFormat format = PayloadFormat::Text;
+    };
+
+    // Outbound state for one connected client; guarded by its own mutex
+    struct ClientSession {
+        std::shared_ptr<ix::WebSocket> socket;
+        std::string id;
+        std::string remoteIp;
+        std::string telemetryChannel = DEFAULT_TELEMETRY_CHANNEL;
+        std::mutex mutex;
+
+        std::deque<QueuedPayload> reliable;
+        size_t reliableBytes = 0;
+        QueuedPayload latestTelemetry;
+        bool closing = false;
+
+        uint64_t messagesSent = 0;
+        uint64_t bytesSent = 0;
+        uint64_t telemetryCoalesced = 0;
+        uint64_t telemetryDeferred = 0;
+    };
+
+    void addSession(ix::WebSocket& webSocket, ix::ConnectionState& connectionState);
+    void removeSession(ix::WebSocket& webSocket);
+    void fanOutLoop();
+
+    // Decrement a channel's subscriber count; caller holds m_mutex
+    void releaseChannel(const std::string& channel);
+
+    // Queue a payload on every client, or only on one channel's clients / one client (by id)
+    void enqueue(const Payload& payload, DeliveryPolicy policy, PayloadFormat format, const std::string* channel,
+                 const std::string* clientId = nullptr);
+
+    // Send whatever the client can take right now; returns true if anything was held back
+    bool flushSession(ClientSession& session, size_t maxSocketBufferedBytes);
+
     int m_port;
     ix::WebSocketServer m_server;
     std::atomic<bool> m_running{false};
     mutable std::mutex m_mutex;
+
+    // Connected clients keyed by their socket; guarded by m_mutex
+    std::unordered_map<ix::WebSocket*, std::shared_ptr<ClientSession>> m_sessions;
+
+    // Number of clients on each telemetry channel; guarded by m_mutex
+    std::unordered_map<std::string, size_t> m_channelSubscribers;
+
+    // Fan-out thread sends queued payloads to each client
+    std::thread m_fanOutThread;
+    std::condition_variable m_fanOutCondition;
+    bool m_fanOutPending = false;
+    BackpressureLimits m_limits;
     ClientConnectedCallback m_clientConnectedCallback;
     MessageHandler m_messageHandler;
 };
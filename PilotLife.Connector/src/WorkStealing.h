@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Run fn(taskIndex) for every index in [0, taskCount) on up to workerCount threads
+// (the calling thread is one of them) and return once all tasks have finished.
+//
+// Each worker starts with a contiguous share of the indices and takes from the
+// front of its own queue; once that is empty it steals from the back of the
+// other workers' queues, so a few slow tasks do not leave threads idle. Tasks run
+// in no particular order: fn must be safe to call concurrently and must not throw.
+// Callers that need deterministic output write each task's result to its own slot
+// and merge the slots in index order afterwards.
+template <typename Fn>
+void parallelForEach(size_t taskCount, size_t workerCount, Fn fn) {
+    if (workerCount > taskCount) {
+        workerCount = taskCount;
+    }
+    if (workerCount <= 1) {
+        for (size_t i = 0; i < taskCount; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+    std::vector<WorkQueue> queues(workerCount);
+
+    size_t next = 0;
+    for (size_t w = 0; w < workerCount; w++) {
+        size_t share = taskCount / workerCount + (w < taskCount % workerCount ? 1 : 0);
+        for (size_t i = 0; i < share; i++) {
+            queues[w].tasks.push_back(next++);
+        }
+    }
+
+    auto takeOwn = [&](size_t self, size_t& task) {
+        std::lock_guard<std::mutex> lock(queues[self].mutex);
+        if (queues[self].tasks.empty()) return false;
+        task = queues[self].tasks.front();
+        queues[self].tasks.pop_front();
+        return true;
+    };
+
+    auto steal = [&](size_t self, size_t& task) {
+        for (size_t offset = 1; offset < workerCount; offset++) {
+            WorkQueue& victim = queues[(self + offset) % workerCount];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // No task is ever added once workers start, so a worker that finds every
+    // queue empty can stop
+    auto work = [&](size_t self) {
+        size_t task;
+        while (takeOwn(self, task) || steal(self, task)) {
+            fn(task);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    for (size_t w = 1; w < workerCount; w++) {
+        threads.emplace_back(work, w);
+    }
+    work(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
@@ -13,19 +13,44 @@
 #include <cstring>
 #include <csignal>
 #include <atomic>
+#include <optional>
+#include <vector>
 
 // Include WebSocketServer first (uses winsock2)
 #include "WebSocketServer.h"
 // Then SimConnect (which may include old winsock)
 #include "SimConnectManager.h"
+#include "SimConnectMessageSource.h"
 #include "ProcessDetector.h"
 #include "FlightData.h"
 #include "AircraftIndexer.h"
+#include "AircraftIndexWatcher.h"
+#include "TelemetryPublisher.h"
+#include "PayloadPool.h"
+#include "TelemetryDelta.h"
+#include "TelemetryBinary.h"
+#include "TelemetrySubscription.h"
+#include "CommandRegistry.h"
+#include "RequestExecutor.h"
 #include <IXNetSystem.h>
 
 // Configuration
 constexpr int DEFAULT_PORT = 5050;
 constexpr int PROCESS_CHECK_INTERVAL_MS = 10000;  // 10 seconds
+constexpr size_t TELEMETRY_QUEUE_CAPACITY = 256;   // Frames buffered between SimConnect and WebSocket threads
+constexpr OverflowPolicy DEFAULT_OVERFLOW_POLICY = OverflowPolicy::DropOldest;
+constexpr std::chrono::seconds DELTA_KEYFRAME_INTERVAL{5};   // Full keyframe cadence for delta subscribers
+constexpr std::chrono::milliseconds INDEX_WATCH_DEBOUNCE{2000};  // Quiet time before re-indexing changed packages
+constexpr int MAX_SCAN_THREADS = 256;                       // Upper bound for --scan-threads
+constexpr size_t MAX_MATCH_CANDIDATES = 5;                  // Closest titles reported when a lookup is not exact
+constexpr size_t REQUEST_WORKER_THREADS = 4;                // Threads running client requests
+constexpr size_t MAX_REQUESTS_IN_FLIGHT_PER_CLIENT = 32;    // Unanswered requests a client may have before it is turned away
+constexpr size_t MAX_QUEUED_REQUESTS = 1024;                // Requests waiting for a worker, across all clients
+
+// Telemetry wire formats a client can choose with setTelemetryFormat
+const std::string TELEMETRY_FORMAT_JSON = WebSocketServer::DEFAULT_TELEMETRY_CHANNEL;
+const std::string TELEMETRY_FORMAT_DELTA = "delta";
+const std::string TELEMETRY_FORMAT_BINARY = "binary";
 
 // Global flag for graceful shutdown
 std::atomic<bool> g_running{true};
@@ -52,10 +77,148 @@ int parsePort(int argc, char* argv[]) {
     return port;
 }
 
+OverflowPolicy parseOverflowPolicy(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--telemetry-overflow") == 0 && i + 1 < argc) {
+            auto policy = TelemetryPublisher::parseOverflowPolicy(argv[i + 1]);
+            if (policy.has_value()) {
+                return policy.value();
+            }
+            std::cerr << "Invalid telemetry overflow policy: " << argv[i + 1] << ". Using default: "
+                      << TelemetryPublisher::getOverflowPolicyString(DEFAULT_OVERFLOW_POLICY) << std::endl;
+            break;
+        }
+    }
+
+    return DEFAULT_OVERFLOW_POLICY;
+}
+
+// Aircraft scan threads; 0 means one per hardware thread
+size_t parseScanThreads(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scan-threads") == 0 && i + 1 < argc) {
+            int threads = std::atoi(argv[i + 1]);
+            if (threads < 0 || threads > MAX_SCAN_THREADS) {
+                std::cerr << "Invalid scan thread count: " << argv[i + 1] << ". Using one per CPU" << std::endl;
+                return 0;
+            }
+            return static_cast<size_t>(threads);
+        }
+    }
+
+    return 0;
+}
+
+// Parameters of the client commands registered in main()
+struct TelemetryRateParams {
+    std::string rate;
+};
+
+struct TelemetryFormatParams {
+    std::string format;
+};
+
+struct SubscribeTelemetryParams {
+    std::vector<std::string> groups;
+    int maxRate = 0;
+};
+
+struct AircraftDataParams {
+    std::string aircraftTitle;
+};
+
+struct NoParams {};
+
+// Commands are dispatched with the sender's connection id as their context
+using ClientCommands = CommandRegistry<const std::string>;
+
+// Acknowledge a setTelemetryRate request with the rate now in effect
+std::string telemetryRateResponse(const std::string& requestId, bool success, TelemetryRate rate) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "telemetryRateResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.field("success", success);
+    json.field("rate", SimConnectManager::getTelemetryRateString(rate));
+    json.endObject();
+    json.endObject();
+    return buffer;
+}
+
+// Acknowledge a setTelemetryFormat request
+std::string telemetryFormatResponse(const std::string& requestId, bool success, const std::string& format) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "telemetryFormatResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.field("success", success);
+    json.field("format", format);
+    if (success && format == TELEMETRY_FORMAT_BINARY) {
+        // Binary frames carry no field names; describe their layout once here
+        json.key("schema");
+        TelemetryBinaryEncoder::writeSchema(json);
+    }
+    json.endObject();
+    json.endObject();
+    return buffer;
+}
+
+// Acknowledge a subscribeTelemetry request with the subscription now in effect
+std::string subscribeTelemetryResponse(const std::string& requestId, const TelemetrySubscription* subscription,
+                                       const std::string& error) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "subscribeTelemetryResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.field("success", subscription != nullptr);
+    if (subscription) {
+        json.key("groups");
+        subscription->writeGroups(json);
+        json.field("maxRate", subscription->maxRateHz);
+    } else {
+        json.field("error", error);
+    }
+    json.endObject();
+    json.endObject();
+    return buffer;
+}
+
+// Latency per command type and the request queue's current depth
+std::string requestStatsResponse(const std::string& requestId, const ClientCommands& commands,
+                                 const RequestExecutor& executor) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("type", "requestStatsResponse");
+    json.field("requestId", requestId);
+    json.key("data");
+    json.beginObject();
+    json.field("queued", executor.getQueuedCount());
+    json.field("inFlight", executor.getInFlightCount());
+    json.key("latency");
+    commands.writeStats(json);
+    json.endObject();
+    json.endObject();
+    return buffer;
+}
+
 void printUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [options]" << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "  --port, -p <port>  WebSocket server port (default: " << DEFAULT_PORT << ")" << std::endl;
+    std::cout << "  --telemetry-overflow <policy>" << std::endl;
+    std::cout << "                     What to do when clients fall behind the simulator:" << std::endl;
+    std::cout << "                     drop-oldest (default) or coalesce (latest frame only)" << std::endl;
+    std::cout << "  --scan-threads <n> Threads used to scan aircraft packages (default: one per CPU)" << std::endl;
     std::cout << "  --help, -h         Show this help message" << std::endl;
 }
 
@@ -80,6 +243,8 @@ int main(int argc, char* argv[]) {
 
     // Parse command line arguments
     int port = parsePort(argc, argv);
+    OverflowPolicy overflowPolicy = parseOverflowPolicy(argc, argv);
+    size_t scanThreads = parseScanThreads(argc, argv);
 
     std::cout << "========================================" << std::endl;
     std::cout << "  PilotLife.Connector" << std::endl;
@@ -95,96 +260,265 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // Client requests run on these workers rather than the socket threads; each client's
+    // requests run in order, and ones it sends past its in-flight limit are rejected
+    RequestExecutor requestExecutor(REQUEST_WORKER_THREADS, MAX_REQUESTS_IN_FLIGHT_PER_CLIENT, MAX_QUEUED_REQUESTS);
+
+    // Client commands, by request "type". Each names the fields it reads; dispatch rejects
+    // malformed requests and wrongly typed fields before a handler runs. Declared ahead of
+    // the services whose threads reply to requests, so it outlives them.
+    ClientCommands commands;
+
     // Initialize Aircraft Indexer for file data
     std::cout << "Scanning for aircraft packages..." << std::endl;
     AircraftIndexer aircraftIndexer;
+    aircraftIndexer.setScanWorkerCount(scanThreads);
     if (aircraftIndexer.initialize()) {
         std::cout << "Indexed " << aircraftIndexer.getIndexedCount() << " aircraft variants" << std::endl;
     } else {
         std::cout << "Warning: Could not index aircraft packages. File data will not be available." << std::endl;
     }
 
-    // Set up message handler for aircraft data requests
-    wsServer.setMessageHandler([&aircraftIndexer](const std::string& message, ix::WebSocket& client) -> std::string {
-        std::cout << "Received: " << message << std::endl;
-
-        // Simple JSON parsing for incoming requests
-        // Looking for: {"type":"getAircraftData","requestId":"...","aircraftTitle":"..."}
+    // Re-index packages as they are installed, updated or removed, and tell clients what changed
+    AircraftIndexWatcher indexWatcher(aircraftIndexer, DirectoryWatcher::create(), INDEX_WATCH_DEBOUNCE);
+    indexWatcher.setUpdateCallback([&aircraftIndexer, &wsServer](const AircraftIndexDelta& delta) {
+        wsServer.broadcast(AircraftIndexer::toIndexUpdatedMessage(delta, aircraftIndexer.getIndexedCount()));
+    });
+    if (indexWatcher.start()) {
+        std::cout << "Watching aircraft folders for changes" << std::endl;
+    }
 
-        size_t typePos = message.find("\"type\"");
-        if (typePos == std::string::npos) {
-            std::cout << "No type field found" << std::endl;
-            return "";
-        }
+    // Initialize SimConnect manager
+    SimConnectManager simConnect(SimConnectMessageSource::open);
+
+    // Shared delta stream for clients that opted into delta telemetry
+    TelemetryDeltaEncoder deltaEncoder(DELTA_KEYFRAME_INTERVAL);
+
+    // Shared binary stream for clients that opted into binary telemetry
+    TelemetryBinaryEncoder binaryEncoder;
+
+    // Aircraft currently loaded in the sim; its ATC type/model break ties between
+    // equally close titles when a client looks that aircraft up
+    std::string liveAircraftTitle;
+    AircraftMatchHints liveAircraftHints;
+    std::mutex liveAircraftMutex;
+
+    // Switch telemetry rate without reconnecting
+    // {"type":"setTelemetryRate","requestId":"...","rate":"simFrame"}
+    commands.add<TelemetryRateParams>("setTelemetryRate", { { "rate", &TelemetryRateParams::rate, true } },
+        [&simConnect](const TelemetryRateParams& params, const std::string& requestId, const std::string&) {
+            auto rate = SimConnectManager::parseTelemetryRate(params.rate);
+            if (rate.has_value()) {
+                std::cout << "Telemetry rate set to: " << params.rate << std::endl;
+                simConnect.setTelemetryRate(rate.value());
+            } else {
+                std::cout << "Unknown telemetry rate: " << params.rate << std::endl;
+            }
+            return telemetryRateResponse(requestId, rate.has_value(), simConnect.getTelemetryRate());
+        });
+
+    // Choose the telemetry wire format for this client
+    // {"type":"setTelemetryFormat","requestId":"...","format":"json|delta|binary"}
+    commands.add<TelemetryFormatParams>("setTelemetryFormat", { { "format", &TelemetryFormatParams::format, true } },
+        [&wsServer, &deltaEncoder, &binaryEncoder](const TelemetryFormatParams& params, const std::string& requestId,
+                                                   const std::string& clientId) {
+            const std::string& format = params.format;
+            if (format != TELEMETRY_FORMAT_JSON && format != TELEMETRY_FORMAT_DELTA &&
+                format != TELEMETRY_FORMAT_BINARY) {
+                std::cout << "Unknown telemetry format: " << format << std::endl;
+                return telemetryFormatResponse(requestId, false, format);
+            }
+            wsServer.setTelemetryChannel(clientId, format);
+            if (format == TELEMETRY_FORMAT_DELTA) {
+                // New delta subscribers need a keyframe to start from
+                deltaEncoder.requestKeyframe();
+            } else if (format == TELEMETRY_FORMAT_BINARY) {
+                // New binary subscribers need every string ID before the next frame
+                binaryEncoder.requestFullStringTable();
+            }
+            return telemetryFormatResponse(requestId, true, format);
+        });
+
+    // Delta or binary client lost state - send a fresh keyframe and string table
+    // {"type":"resyncTelemetry"}
+    commands.add<NoParams>("resyncTelemetry", {},
+        [&deltaEncoder, &binaryEncoder](const NoParams&, const std::string&, const std::string&) {
+            deltaEncoder.requestKeyframe();
+            binaryEncoder.requestFullStringTable();
+            return std::string();
+        });
+
+    // Receive only the chosen field groups, at most maxRate times per second (0 = every sample)
+    // {"type":"subscribeTelemetry","requestId":"...","groups":["position","heading"],"maxRate":10}
+    commands.add<SubscribeTelemetryParams>("subscribeTelemetry",
+        { { "groups", &SubscribeTelemetryParams::groups, true }, { "maxRate", &SubscribeTelemetryParams::maxRate } },
+        [&wsServer](const SubscribeTelemetryParams& params, const std::string& requestId, const std::string& clientId) {
+            std::string error;
+            auto subscription = TelemetrySubscription::fromRequest(params.groups, params.maxRate, error);
+            if (!subscription.has_value()) {
+                return subscribeTelemetryResponse(requestId, nullptr, error);
+            }
 
-        // Extract type value
-        size_t typeValueStart = message.find("\"getAircraftData\"");
-        if (typeValueStart == std::string::npos) {
-            std::cout << "Not a getAircraftData request" << std::endl;
-            return "";
-        }
+            // Clients with identical subscriptions land on the same channel and share its payloads
+            wsServer.setTelemetryChannel(clientId, subscription->channelName());
+            std::cout << "Telemetry subscription: " << subscription->channelName() << std::endl;
+            return subscribeTelemetryResponse(requestId, &subscription.value(), "");
+        });
+
+    // Per-client outbound queue and lag metrics
+    // {"type":"getClientStats","requestId":"..."}
+    commands.add<NoParams>("getClientStats", {},
+        [&wsServer](const NoParams&, const std::string& requestId, const std::string&) {
+            return wsServer.toClientStatsResponse(requestId);
+        });
+
+    // Per-command latency (receipt to reply) and request queue depth
+    // {"type":"getRequestStats","requestId":"..."}
+    commands.add<NoParams>("getRequestStats", {},
+        [&commands, &requestExecutor](const NoParams&, const std::string& requestId, const std::string&) {
+            return requestStatsResponse(requestId, commands, requestExecutor);
+        });
+
+    // Aircraft file data for a title
+    // {"type":"getAircraftData","requestId":"...","aircraftTitle":"..."}
+    commands.addAsync<AircraftDataParams>("getAircraftData", { { "aircraftTitle", &AircraftDataParams::aircraftTitle, true } },
+        [&aircraftIndexer, &wsServer, &liveAircraftTitle, &liveAircraftHints, &liveAircraftMutex](
+            const AircraftDataParams& params, const std::string& requestId, const std::string&,
+            ClientCommands::Reply reply) {
+            const std::string& aircraftTitle = params.aircraftTitle;
+            std::cout << "AircraftTitle: " << aircraftTitle << std::endl;
+
+            if (aircraftTitle.empty()) {
+                std::cout << "Empty aircraft title, returning not found" << std::endl;
+                reply(AircraftIndexer::toNotFoundResponse(requestId));
+                return;
+            }
 
-        // Extract requestId
-        std::string requestId;
-        size_t requestIdPos = message.find("\"requestId\"");
-        if (requestIdPos != std::string::npos) {
-            size_t colonPos = message.find(':', requestIdPos);
-            size_t startQuote = message.find('"', colonPos);
-            size_t endQuote = message.find('"', startQuote + 1);
-            if (startQuote != std::string::npos && endQuote != std::string::npos) {
-                requestId = message.substr(startQuote + 1, endQuote - startQuote - 1);
+            // Look up the aircraft
+            std::cout << "Looking up aircraft..." << std::endl;
+            AircraftMatchHints hints;
+            {
+                std::lock_guard<std::mutex> lock(liveAircraftMutex);
+                if (aircraftTitle == liveAircraftTitle) {
+                    hints = liveAircraftHints;
+                }
             }
-        }
-        std::cout << "RequestId: " << requestId << std::endl;
-
-        // Extract aircraftTitle
-        std::string aircraftTitle;
-        size_t titlePos = message.find("\"aircraftTitle\"");
-        if (titlePos != std::string::npos) {
-            size_t colonPos = message.find(':', titlePos);
-            size_t startQuote = message.find('"', colonPos);
-            size_t endQuote = message.find('"', startQuote + 1);
-            if (startQuote != std::string::npos && endQuote != std::string::npos) {
-                aircraftTitle = message.substr(startQuote + 1, endQuote - startQuote - 1);
+            auto result = aircraftIndexer.lookup(aircraftTitle, hints, MAX_MATCH_CANDIDATES);
+            if (result.aircraft) {
+                std::cout << "Found aircraft data for: " << aircraftTitle << std::endl;
+                reply(AircraftIndexer::toJsonResponse(result, requestId));
+                return;
+            }
+            if (result.knownMiss) {
+                std::cout << "Aircraft not found: " << aircraftTitle << std::endl;
+                reply(AircraftIndexer::toJsonResponse(result, requestId));
+                return;
             }
-        }
-        std::cout << "AircraftTitle: " << aircraftTitle << std::endl;
-
-        if (aircraftTitle.empty()) {
-            std::cout << "Empty aircraft title, returning not found" << std::endl;
-            return AircraftIndexer::toNotFoundResponse(requestId);
-        }
 
-        // Look up the aircraft
-        std::cout << "Looking up aircraft..." << std::endl;
-        auto result = aircraftIndexer.findByTitle(aircraftTitle);
-        if (result.has_value()) {
-            std::cout << "Found aircraft data for: " << aircraftTitle << std::endl;
-            return AircraftIndexer::toJsonResponse(result.value(), requestId);
-        } else {
-            std::cout << "Aircraft not found: " << aircraftTitle << std::endl;
-            return AircraftIndexer::toNotFoundResponse(requestId);
+            // Searching the package folders can take seconds; do it on the indexer's search
+            // thread so this worker is free for other clients, and reply when it is done
+            aircraftIndexer.searchInBackground(aircraftTitle, std::move(result),
+                [&aircraftIndexer, &wsServer, requestId, aircraftTitle, reply = std::move(reply)](
+                    const AircraftLookup& found, const AircraftIndexDelta& delta) {
+                    if (!delta.empty()) {
+                        wsServer.broadcast(AircraftIndexer::toIndexUpdatedMessage(delta, aircraftIndexer.getIndexedCount()));
+                    }
+                    std::cout << (found.aircraft ? "Found aircraft data for: " : "Aircraft not found: ") << aircraftTitle << std::endl;
+                    reply(AircraftIndexer::toJsonResponse(found, requestId));
+                });
+        });
+
+    // Requests are queued from the socket threads and answered through sendTo, so a slow
+    // one never holds up the connection it came in on
+    wsServer.setMessageHandler([&commands, &requestExecutor, &wsServer](const std::string& message,
+                                                                        const std::string& clientId) {
+        std::cout << "Received: " << message << std::endl;
+        auto receivedAt = ClientCommands::Clock::now();
+        bool accepted = requestExecutor.submit(clientId, [&commands, &requestExecutor, &wsServer, message, clientId, receivedAt]() {
+            commands.dispatch(message, clientId, receivedAt,
+                [&requestExecutor, &wsServer, clientId](std::string response) {
+                    if (!response.empty()) {
+                        wsServer.sendTo(clientId, std::move(response));
+                    }
+                    requestExecutor.complete(clientId);
+                });
+        });
+        if (!accepted) {
+            wsServer.sendTo(clientId, commands.reject(message, "Too many requests in flight"));
         }
     });
 
-    // Initialize SimConnect manager
-    SimConnectManager simConnect;
-
     // Track current sim status for sending to new clients
     std::atomic<bool> simIsConnected{false};
     std::atomic<bool> simIsRunning{false};
     std::string currentSimVersion;
     std::mutex simVersionMutex;
 
+    // Flight data is queued by the SimConnect thread and serialized/broadcast on the
+    // publisher thread, so slow clients never stall ingestion from the sim.
+    // Each stream serializes straight into a pooled payload buffer that is shared
+    // with the clients and reused once they have all released it, so ticks stop
+    // allocating once the buffers have grown to the message size.
+    TelemetryPublisher telemetryPublisher(TELEMETRY_QUEUE_CAPACITY, overflowPolicy);
+    PayloadPool jsonPayloads;
+    PayloadPool deltaPayloads;
+    PayloadPool binaryPayloads;
+    PayloadPool stringTablePayloads;
+    TelemetrySubscriptionPublisher subscriptionPublisher;
+    std::string publishedSimVersion;
+    telemetryPublisher.setPublishCallback([&](const SimConnectFlightData& data) {
+        {
+            std::lock_guard<std::mutex> lock(simVersionMutex);
+            publishedSimVersion = currentSimVersion;
+        }
+        {
+            // Static SimVars; only copied when the loaded aircraft changes
+            constexpr size_t SV_TITLE = simVarIndex("TITLE");
+            constexpr size_t SV_ATC_TYPE = simVarIndex("ATC TYPE");
+            constexpr size_t SV_ATC_MODEL = simVarIndex("ATC MODEL");
+            std::lock_guard<std::mutex> lock(liveAircraftMutex);
+            std::string_view title = data.text(SV_TITLE);
+            if (title != liveAircraftTitle) {
+                liveAircraftTitle = title;
+                liveAircraftHints.atcType = data.text(SV_ATC_TYPE);
+                liveAircraftHints.atcModel = data.text(SV_ATC_MODEL);
+            }
+        }
+        // Only encode formats somebody is listening to
+        if (wsServer.hasSubscribers(TELEMETRY_FORMAT_JSON)) {
+            auto payload = jsonPayloads.acquire();
+            FlightDataEncoder::writeMessage(data, publishedSimVersion, *payload);
+            wsServer.publish(TELEMETRY_FORMAT_JSON, std::move(payload), DeliveryPolicy::LatestWins);
+        }
+        if (wsServer.hasSubscribers(TELEMETRY_FORMAT_DELTA)) {
+            // Keyframes must arrive for deltas to be usable; deltas themselves are latest-wins
+            auto payload = deltaPayloads.acquire();
+            bool keyframe = deltaEncoder.writeMessage(data, publishedSimVersion, *payload);
+            wsServer.publish(TELEMETRY_FORMAT_DELTA, std::move(payload),
+                             keyframe ? DeliveryPolicy::Reliable : DeliveryPolicy::LatestWins);
+        }
+        if (wsServer.hasSubscribers(TELEMETRY_FORMAT_BINARY)) {
+            // String tables are reliable and queued ahead of the frame that references them
+            auto stringTable = stringTablePayloads.acquire();
+            auto frame = binaryPayloads.acquire();
+            if (binaryEncoder.writeFrames(data, publishedSimVersion, *stringTable, *frame)) {
+                wsServer.publish(TELEMETRY_FORMAT_BINARY, std::move(stringTable),
+                                 DeliveryPolicy::Reliable, PayloadFormat::Binary);
+            }
+            wsServer.publish(TELEMETRY_FORMAT_BINARY, std::move(frame),
+                             DeliveryPolicy::LatestWins, PayloadFormat::Binary);
+        }
+        subscriptionPublisher.publish(data, publishedSimVersion, wsServer);
+    });
+    telemetryPublisher.start();
+
     // Set up callbacks
-    simConnect.setFlightDataCallback([&wsServer](const FlightDataJson& data) {
-        std::string json = "{\"type\":\"flightData\",\"data\":" + data.toJson() + "}";
-        wsServer.broadcast(json);
+    simConnect.setFlightDataCallback([&telemetryPublisher](const SimConnectFlightData& data, const std::string&) {
+        telemetryPublisher.enqueue(data);
     });
 
     simConnect.setStatusCallback([&wsServer](const SimulatorStatus& status) {
-        std::string json = "{\"type\":\"status\",\"data\":" + status.toJson() + "}";
-        wsServer.broadcast(json);
+        wsServer.broadcast(status.toMessage());
     });
 
     // When a new client connects, send them the current status and MSFS paths info
@@ -197,8 +531,7 @@ int main(int argc, char* argv[]) {
             std::lock_guard<std::mutex> lock(simVersionMutex);
             status.simulatorVersion = currentSimVersion;
         }
-        std::string statusJson = "{\"type\":\"status\",\"data\":" + status.toJson() + "}";
-        client.send(statusJson);
+        client.send(status.toMessage());
 
         // Send MSFS paths info
         std::string pathsJson = aircraftIndexer.toPathsInfoResponse();
@@ -226,6 +559,9 @@ int main(int argc, char* argv[]) {
                 wasConnected = true;
                 lastDetectedType = simType;
 
+                // Delta subscribers need a fresh keyframe for the new session
+                deltaEncoder.requestKeyframe();
+
                 // Update tracked state
                 simIsConnected = true;
                 simIsRunning = true;
@@ -239,7 +575,7 @@ int main(int argc, char* argv[]) {
                 status.isConnected = true;
                 status.isSimRunning = true;
                 status.simulatorVersion = simVersion;
-                wsServer.broadcast("{\"type\":\"status\",\"data\":" + status.toJson() + "}");
+                wsServer.broadcast(status.toMessage());
             } else {
                 std::cerr << "Failed to connect to SimConnect" << std::endl;
             }
@@ -259,7 +595,7 @@ int main(int argc, char* argv[]) {
             status.isConnected = false;
             status.isSimRunning = false;
             status.simulatorVersion = ProcessDetector::getSimulatorTypeString(lastDetectedType);
-            wsServer.broadcast("{\"type\":\"status\",\"data\":" + status.toJson() + "}");
+            wsServer.broadcast(status.toMessage());
 
             std::cout << "Waiting for Microsoft Flight Simulator..." << std::endl;
         }
@@ -274,7 +610,19 @@ int main(int argc, char* argv[]) {
     std::cout << "Shutting down..." << std::endl;
     simConnect.stopDispatchLoop();
     simConnect.disconnect();
+    telemetryPublisher.stop();
+    indexWatcher.stop();
+
+    RingStats telemetryStats = telemetryPublisher.getStats();
+    std::cout << "Telemetry frames: " << telemetryStats.pushed << " queued, "
+              << telemetryStats.popped << " published, "
+              << telemetryStats.dropped << " dropped, "
+              << telemetryStats.coalesced << " coalesced (max queue depth "
+              << telemetryStats.maxDepth << ")" << std::endl;
+    // Requests still queued or waiting on a background search are abandoned; the
+    // server goes first, so their clients are already disconnected
     wsServer.stop();
+    requestExecutor.stop();
 
     // Cleanup network system
     ix::uninitNetSystem();
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "AircraftIndexWatcher.h"
+#include "SyntheticPackageTree.h"
+
+namespace {
+
+constexpr std::chrono::milliseconds DEBOUNCE{200};
+
+// Records every update the watcher publishes
+class UpdateLog {
+public:
+    void add(const AircraftIndexDelta& delta) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_deltas.push_back(delta);
+        m_condition.notify_all();
+    }
+
+    // Wait for the next update; nullopt if none arrives in time
+    std::optional<AircraftIndexDelta> next(std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_condition.wait_for(lock, timeout, [&] { return m_taken < m_deltas.size(); })) {
+            return std::nullopt;
+        }
+        return m_deltas[m_taken++];
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<AircraftIndexDelta> m_deltas;
+    size_t m_taken = 0;
+};
+
+bool contains(const std::vector<std::string>& titles, const std::string& title) {
+    return std::find(titles.begin(), titles.end(), title) != titles.end();
+}
+
+class AircraftIndexWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SyntheticTreeOptions options;
+        options.packages = 20;
+        options.variationsPerPackage = 4;
+        tree = std::make_unique<SyntheticPackageTree>(options);
+        ASSERT_TRUE(indexer.initialize({ tree->communityPath() }, ""));
+
+        auto directoryWatcher = DirectoryWatcher::create();
+        if (!directoryWatcher) {
+            GTEST_SKIP() << "No filesystem notifications on this platform";
+        }
+        watcher = std::make_unique<AircraftIndexWatcher>(indexer, std::move(directoryWatcher), DEBOUNCE);
+        watcher->setUpdateCallback([this](const AircraftIndexDelta& delta) { updates.add(delta); });
+        ASSERT_TRUE(watcher->start());
+    }
+
+    void TearDown() override {
+        if (watcher) {
+            watcher->stop();
+        }
+    }
+
+    bool hasExactTitle(const std::string& title) const {
+        return indexer.lookup(title, {}, 1).exact;
+    }
+
+    std::unique_ptr<SyntheticPackageTree> tree;
+    AircraftIndexer indexer;
+    std::unique_ptr<AircraftIndexWatcher> watcher;
+    UpdateLog updates;
+};
+
+} // namespace
+
+TEST_F(AircraftIndexWatcherTest, EditedCfgIsReindexed) {
+    tree->writePackage(3, 1, true);
+
+    auto delta = updates.next();
+    ASSERT_TRUE(delta);
+    EXPECT_EQ(delta->added.size(), 4u);
+    EXPECT_EQ(delta->removed.size(), 4u);
+    EXPECT_TRUE(contains(delta->added, tree->title(3, 0) + " Renamed"));
+    EXPECT_TRUE(contains(delta->removed, tree->title(3, 0)));
+    EXPECT_TRUE(hasExactTitle(tree->title(3, 0) + " Renamed"));
+    EXPECT_FALSE(hasExactTitle(tree->title(3, 0)));
+}
+
+TEST_F(AircraftIndexWatcherTest, RemovedPackageIsDropped) {
+    tree->removePackage(7);
+
+    auto delta = updates.next();
+    ASSERT_TRUE(delta);
+    EXPECT_TRUE(delta->added.empty());
+    EXPECT_TRUE(contains(delta->removed, tree->title(7, 2)));
+    EXPECT_FALSE(hasExactTitle(tree->title(7, 2)));
+    EXPECT_TRUE(hasExactTitle(tree->title(8, 2)));
+}
+
+TEST_F(AircraftIndexWatcherTest, AddedPackageIsIndexed) {
+    tree->writePackage(20);
+
+    auto delta = updates.next();
+    ASSERT_TRUE(delta);
+    EXPECT_TRUE(delta->removed.empty());
+    EXPECT_TRUE(contains(delta->added, tree->title(20, 3)));
+    EXPECT_TRUE(hasExactTitle(tree->title(20, 3)));
+}
+
+TEST_F(AircraftIndexWatcherTest, BurstOfWritesBecomesOneRefresh) {
+    // Like an installer: many writes across packages, each well inside the debounce interval
+    for (size_t revision = 1; revision <= 5; revision++) {
+        for (size_t package = 10; package < 13; package++) {
+            tree->writePackage(package, revision, revision == 5);
+        }
+    }
+
+    auto delta = updates.next();
+    ASSERT_TRUE(delta);
+    EXPECT_EQ(delta->added.size(), 12u);
+    EXPECT_EQ(delta->removed.size(), 12u);
+    EXPECT_FALSE(updates.next(DEBOUNCE * 3));
+}
@@ -0,0 +1,371 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AircraftIndexer.h"
+#include "SyntheticPackageTree.h"
+
+namespace {
+
+SyntheticTreeOptions smallTree() {
+    SyntheticTreeOptions options;
+    options.packages = 60;
+    options.variationsPerPackage = 4;
+    options.liveryEvery = 5;
+    options.sharedTitleEvery = 7;
+    return options;
+}
+
+// The aircraftDataResponse for every title (empty where nothing was found)
+std::vector<std::string> responses(const AircraftIndexer& indexer, const std::vector<std::string>& titles) {
+    std::vector<std::string> result;
+    for (const auto& title : titles) {
+        AircraftHandle aircraft = indexer.findByTitle(title);
+        result.push_back(aircraft ? AircraftIndexer::toJsonResponse(*aircraft, "r") : std::string());
+    }
+    return result;
+}
+
+// True if the title is indexed as such (findByTitle also takes close matches)
+bool hasExactTitle(const AircraftIndexer& indexer, const std::string& title) {
+    return indexer.lookup(title, {}, 1).exact;
+}
+
+struct SearchOutcome {
+    AircraftLookup lookup;
+    AircraftIndexDelta delta;
+};
+
+// Run a background search and wait for its callback
+SearchOutcome searchAndWait(AircraftIndexer& indexer, const std::string& title) {
+    auto promise = std::make_shared<std::promise<SearchOutcome>>();
+    auto outcome = promise->get_future();
+    indexer.searchInBackground(title, indexer.lookup(title, {}, 1),
+        [promise](const AircraftLookup& lookup, const AircraftIndexDelta& delta) {
+            promise->set_value({ lookup, delta });
+        });
+    EXPECT_EQ(outcome.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    return outcome.get();
+}
+
+bool contains(const std::vector<std::string>& titles, const std::string& title) {
+    return std::find(titles.begin(), titles.end(), title) != titles.end();
+}
+
+// A file in the temp directory, removed again at the end of the test
+class TempFile {
+public:
+    TempFile(const std::string& name, const std::string& content)
+        : m_path(std::filesystem::temp_directory_path() / ("pilotlife-" + name)) {
+        std::ofstream(m_path, std::ios::binary) << content;
+    }
+    ~TempFile() {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+    const std::filesystem::path& path() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+};
+
+} // namespace
+
+TEST(AircraftIndexerTests, IndexesEveryVariation) {
+    SyntheticPackageTree tree(smallTree());
+    AircraftIndexer indexer;
+    ASSERT_TRUE(indexer.initialize({ tree.communityPath() }, ""));
+
+    for (const auto& title : tree.titles()) {
+        AircraftHandle aircraft = indexer.findByTitle(title);
+        ASSERT_TRUE(aircraft) << title;
+        EXPECT_EQ(aircraft->config.title, title);
+    }
+
+    // A livery takes what it leaves out from the aircraft it names
+    AircraftHandle livery = indexer.findByTitle(tree.title(5, 1));
+    ASSERT_TRUE(livery);
+    EXPECT_EQ(livery->config.generalAtcType, "SYNTHETIC");
+    EXPECT_EQ(livery->config.uiType, "Synthetic Jet");
+    EXPECT_EQ(livery->config.atcId, "N5SY1");
+}
+
+TEST(AircraftIndexerTests, VariationsShareTheirFilesAndManifest) {
+    SyntheticPackageTree tree(smallTree());
+    AircraftIndexer indexer;
+    ASSERT_TRUE(indexer.initialize({ tree.communityPath() }, ""));
+
+    AircraftHandle first = indexer.findByTitle(tree.title(1, 0));
+    ASSERT_TRUE(first && first->config.rawContent && first->manifest);
+    for (size_t variation = 1; variation < tree.options().variationsPerPackage; variation++) {
+        AircraftHandle other = indexer.findByTitle(tree.title(1, variation));
+        ASSERT_TRUE(other);
+        EXPECT_EQ(other->config.rawContent, first->config.rawContent);
+        EXPECT_EQ(other->manifest, first->manifest);
+    }
+}
+
+TEST(AircraftIndexerTests, ParallelScanMatchesTheSerialScan) {
+    SyntheticPackageTree tree(smallTree());
+    std::vector<std::string> titles = tree.titles();
+
+    AircraftIndexer serial;
+    serial.setScanWorkerCount(1);
+    ASSERT_TRUE(serial.initialize({ tree.communityPath() }, ""));
+    std::vector<std::string> expected = responses(serial, titles);
+
+    for (size_t workers : { 2, 4, 8 }) {
+        AircraftIndexer parallel;
+        parallel.setScanWorkerCount(workers);
+        ASSERT_TRUE(parallel.initialize({ tree.communityPath() }, ""));
+        EXPECT_EQ(parallel.getIndexedCount(), serial.getIndexedCount()) << workers;
+        EXPECT_EQ(responses(parallel, titles), expected) << workers;
+    }
+}
+
+TEST(AircraftIndexerTests, WarmStartFromTheCacheMatchesAColdScan) {
+    SyntheticPackageTree tree(smallTree());
+    std::vector<std::string> titles = tree.titles();
+
+    AircraftIndexer cold;
+    ASSERT_TRUE(cold.initialize({ tree.communityPath() }, tree.cacheDirectory()));
+    ASSERT_TRUE(std::filesystem::exists(std::filesystem::path(tree.cacheDirectory()) / "aircraft_index.bin"));
+
+    AircraftIndexer warm;
+    ASSERT_TRUE(warm.initialize({ tree.communityPath() }, tree.cacheDirectory()));
+    EXPECT_EQ(warm.getIndexedCount(), cold.getIndexedCount());
+    EXPECT_EQ(responses(warm, titles), responses(cold, titles));
+
+    // Variations of one cfg still share its contents after a round trip through the cache
+    AircraftHandle first = warm.findByTitle(tree.title(1, 0));
+    AircraftHandle second = warm.findByTitle(tree.title(1, 1));
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(first->config.rawContent, second->config.rawContent);
+    EXPECT_EQ(first->manifest, second->manifest);
+}
+
+TEST(AircraftIndexerTests, WarmStartReparsesChangedAndDropsRemovedPackages) {
+    SyntheticPackageTree tree(smallTree());
+    {
+        AircraftIndexer cold;
+        ASSERT_TRUE(cold.initialize({ tree.communityPath() }, tree.cacheDirectory()));
+    }
+
+    tree.writePackage(3, 1, true);
+    tree.removePackage(4);
+
+    AircraftIndexer warm;
+    ASSERT_TRUE(warm.initialize({ tree.communityPath() }, tree.cacheDirectory()));
+    EXPECT_FALSE(hasExactTitle(warm, tree.title(3, 0)));
+    EXPECT_TRUE(hasExactTitle(warm, tree.title(3, 0) + " Renamed"));
+    EXPECT_FALSE(hasExactTitle(warm, tree.title(4, 0)));
+    EXPECT_TRUE(hasExactTitle(warm, tree.title(2, 0)));
+}
+
+TEST(AircraftIndexerTests, DamagedCacheFallsBackToAFullScan) {
+    SyntheticPackageTree tree(smallTree());
+    std::filesystem::path cacheFile = std::filesystem::path(tree.cacheDirectory()) / "aircraft_index.bin";
+    {
+        AircraftIndexer cold;
+        ASSERT_TRUE(cold.initialize({ tree.communityPath() }, tree.cacheDirectory()));
+    }
+    std::filesystem::resize_file(cacheFile, std::filesystem::file_size(cacheFile) / 2);
+
+    AircraftIndexer warm;
+    ASSERT_TRUE(warm.initialize({ tree.communityPath() }, tree.cacheDirectory()));
+    for (const auto& title : tree.titles()) {
+        EXPECT_TRUE(hasExactTitle(warm, title)) << title;
+    }
+}
+
+TEST(AircraftIndexerTests, LookupsDuringRefreshesAlwaysSeeACompleteIndex) {
+    SyntheticPackageTree tree(smallTree());
+    AircraftIndexer indexer;
+    ASSERT_TRUE(indexer.initialize({ tree.communityPath() }, ""));
+    std::vector<std::string> titles = tree.titles();
+
+    std::atomic<bool> writing{true};
+    std::thread writer([&] {
+        for (size_t package = 0; package < 100; package++) {
+            indexer.refreshPackages({ tree.packagePath(package % tree.options().packages).string() });
+        }
+        writing = false;
+    });
+
+    std::atomic<size_t> misses{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&] {
+            while (writing) {
+                for (const auto& title : titles) {
+                    if (!hasExactTitle(indexer, title)) {
+                        misses++;
+                    }
+                }
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(misses.load(), 0u);
+    EXPECT_EQ(indexer.getIndexedCount(), titles.size() + tree.options().packages);
+}
+
+TEST(AircraftIndexerTests, ParsesEveryFltsimSection) {
+    TempFile cfg("aircraft.cfg",
+        "; comment\r\n"
+        "[GENERAL]\r\n"
+        "atc_type = \"TT:ATCCOM.ATC_NAME CESSNA.0.text\"\r\n"
+        "Category = airplane ; inline comment\r\n"
+        "\r\n"
+        "[FLTSIM.0]\r\n"
+        "title = \"Cessna Skyhawk Asobo\"\r\n"
+        "   atc_id=N172SP\r\n"
+        "# another comment\r\n"
+        "[fltsim.1]\r\n"
+        "title=\"Cessna Skyhawk G1000 Asobo\"\t\r\n"
+        "ui_variation = \"G1000\"\r\n"
+        "[FLTSIM.2]\r\n"
+        "atc_id = \"untitled variations are skipped\"\r\n");
+
+    auto variations = AircraftIndexer::parseAllAircraftCfgVariations(cfg.path());
+    ASSERT_EQ(variations.size(), 2u);
+    EXPECT_EQ(variations[0].title, "Cessna Skyhawk Asobo");
+    EXPECT_EQ(variations[0].atcId, "N172SP");
+    EXPECT_EQ(variations[1].title, "Cessna Skyhawk G1000 Asobo");
+    EXPECT_EQ(variations[1].uiVariation, "G1000");
+    for (const auto& variation : variations) {
+        EXPECT_EQ(variation.generalAtcType, "TT:ATCCOM.ATC_NAME CESSNA.0.text");
+        EXPECT_EQ(variation.category, "airplane");
+        EXPECT_EQ(variation.rawContent, variations[0].rawContent);
+    }
+}
+
+TEST(AircraftIndexerTests, ReadsOnlyTopLevelManifestKeys) {
+    TempFile manifest("manifest.json",
+        "\xEF\xBB\xBF{\n"
+        "  \"dependencies\": [ { \"name\": \"fs-base\", \"title\": \"Nested\", \"package_version\": \"0.1\" } ],\n"
+        "  \"content_type\": \"AIRCRAFT\",\n"
+        "  \"title\": \"The \\\"Caf\\u00e9\\\" Jet\",\n"
+        "  \"release_notes\": { \"neutral\": { \"title\": \"Also nested\" } },\n"
+        "  \"package_version\": \"1.2.3\",\n"
+        "  \"total_package_size\": 1234\n"
+        "}\n");
+
+    AircraftManifest parsed = AircraftIndexer::parseManifestJson(manifest.path());
+    EXPECT_EQ(parsed.contentType, "AIRCRAFT");
+    EXPECT_EQ(parsed.title, "The \"Caf\xC3\xA9\" Jet");
+    EXPECT_EQ(parsed.packageVersion, "1.2.3");
+    EXPECT_EQ(parsed.totalPackageSize, "");
+    ASSERT_TRUE(parsed.rawJson);
+}
+
+TEST(AircraftIndexerTests, BackgroundSearchIndexesPackagesInstalledSinceTheScan) {
+    SyntheticPackageTree tree(smallTree());
+    tree.removePackage(12);
+    AircraftIndexer indexer;
+    ASSERT_TRUE(indexer.initialize({ tree.communityPath() }, ""));
+    std::string title = tree.title(12, 1);
+    ASSERT_FALSE(hasExactTitle(indexer, title));
+
+    // Installed without a rescan (no watcher running)
+    tree.writePackage(12);
+    SearchOutcome found = searchAndWait(indexer, title);
+    ASSERT_TRUE(found.lookup.aircraft);
+    EXPECT_TRUE(found.lookup.exact);
+    EXPECT_EQ(found.lookup.aircraft->config.title, title);
+
+    // The whole package joins the index, and clients are told which titles appeared
+    for (size_t variation = 0; variation < tree.options().variationsPerPackage; variation++) {
+        EXPECT_TRUE(contains(found.delta.added, tree.title(12, variation))) << variation;
+        EXPECT_TRUE(hasExactTitle(indexer, tree.title(12, variation))) << variation;
+    }
+    std::string message = AircraftIndexer::toIndexUpdatedMessage(found.delta, indexer.getIndexedCount());
+    EXPECT_NE(message.find("\"type\":\"aircraftIndexUpdated\""), std::string::npos);
+    EXPECT_NE(message.find(title), std::string::npos);
+}
+
+TEST(AircraftIndexerTests, RepeatedMissesAreAnsweredFromMemoryUntilTheyExpire) {
+    SyntheticPackageTree tree(smallTree());
+    tree.removePackage(12);
+    AircraftIndexer indexer;
+    ASSERT_TRUE(indexer.initialize({ tree.communityPath() }, ""));
+    indexer.setMissCacheTtl(std::chrono::milliseconds(300));
+    std::string title = tree.title(12, 0);
+
+    SearchOutcome miss = searchAndWait(indexer, title);
+    EXPECT_TRUE(miss.lookup.knownMiss);
+    EXPECT_FALSE(miss.lookup.exact);
+    EXPECT_TRUE(miss.delta.empty());
+
+    // The package appears on disk, but a known miss is not looked for again: lookup()
+    // answers from the cache and never reads the folders
+    tree.writePackage(12);
+    AircraftLookup cached = indexer.lookup(title, {}, 1);
+    EXPECT_TRUE(cached.knownMiss);
+    EXPECT_FALSE(cached.exact);
+
+    // Once it expires the title is searched for again, and found
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    AircraftLookup expired = indexer.lookup(title, {}, 1);
+    EXPECT_FALSE(expired.knownMiss);
+    EXPECT_FALSE(expired.exact);
+    SearchOutcome found = searchAndWait(indexer, title);
+    EXPECT_TRUE(found.lookup.exact);
+    EXPECT_FALSE(found.lookup.knownMiss);
+}
+
+TEST(AircraftIndexerTests, ConcurrentSearchesForOneTitleShareOneSearch) {
+    SyntheticPackageTree tree(smallTree());
+    tree.removePackage(12);
+    AircraftIndexer indexer;
+    ASSERT_TRUE(indexer.initialize({ tree.communityPath() }, ""));
+    tree.writePackage(12);
+    std::string title = tree.title(12, 0);
+
+    // Callbacks run on the search thread, so blocking in one holds every later search
+    // in the queue while the requests below arrive
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> blocking;
+    indexer.searchInBackground("Not An Aircraft", {}, [&](const AircraftLookup&, const AircraftIndexDelta&) {
+        blocking.set_value();
+        released.wait();
+    });
+    blocking.get_future().wait();
+
+    constexpr int CLIENTS = 8;
+    std::mutex mutex;
+    std::vector<SearchOutcome> outcomes;
+    std::vector<std::thread> clients;
+    for (int i = 0; i < CLIENTS; i++) {
+        clients.emplace_back([&] {
+            indexer.searchInBackground(title, {}, [&](const AircraftLookup& lookup, const AircraftIndexDelta& delta) {
+                std::lock_guard<std::mutex> lock(mutex);
+                outcomes.push_back({ lookup, delta });
+            });
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    release.set_value();
+
+    // Wait for the merged search behind the blocker
+    searchAndWait(indexer, "Also Not An Aircraft");
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(outcomes.size(), static_cast<size_t>(CLIENTS));
+    for (const auto& outcome : outcomes) {
+        EXPECT_TRUE(outcome.lookup.exact);
+        // A second search would have found the title indexed already and changed nothing
+        EXPECT_TRUE(contains(outcome.delta.added, title));
+    }
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "CommandRegistry.h"
+
+namespace {
+
+// Same shapes as the connector's setTelemetryRate and subscribeTelemetry
+struct RateParams {
+    std::string rate;
+};
+
+struct SubscribeParams {
+    std::vector<std::string> groups;
+    int maxRate = 0;
+};
+
+using TestCommands = CommandRegistry<const std::string>;
+
+class CommandRegistryTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        commands.add<RateParams>("setTelemetryRate", { { "rate", &RateParams::rate, true } },
+            [this](const RateParams& params, const std::string& requestId, const std::string&) {
+                handled++;
+                return "rate:" + requestId + ":" + params.rate;
+            });
+        commands.add<SubscribeParams>("subscribeTelemetry",
+            { { "groups", &SubscribeParams::groups, true }, { "maxRate", &SubscribeParams::maxRate } },
+            [this](const SubscribeParams& params, const std::string&, const std::string&) {
+                handled++;
+                std::string response = "groups:";
+                for (const auto& group : params.groups) response += group + ",";
+                return response + "@" + std::to_string(params.maxRate);
+            });
+    }
+
+    // The single reply a message gets
+    std::string dispatch(std::string_view message) {
+        std::vector<std::string> replies;
+        const std::string client = "client";
+        commands.dispatch(message, client, TestCommands::Clock::now(),
+                          [&replies](std::string response) { replies.push_back(std::move(response)); });
+        EXPECT_EQ(replies.size(), 1u) << message;
+        return replies.empty() ? std::string() : replies.front();
+    }
+
+    TestCommands commands;
+    int handled = 0;
+};
+
+} // namespace
+
+TEST_F(CommandRegistryTests, RunsHandlersWithTypedParameters) {
+    EXPECT_EQ(dispatch(R"({"type":"setTelemetryRate","requestId":"1","rate":"simFrame"})"), "rate:1:simFrame");
+    EXPECT_EQ(dispatch(R"({"maxRate":10,"groups":["position","heading"],"type":"subscribeTelemetry","extra":[1]})"),
+              "groups:position,heading,@10");
+    EXPECT_EQ(handled, 2);
+}
+
+TEST_F(CommandRegistryTests, OptionalFieldsKeepTheirDefault) {
+    EXPECT_EQ(dispatch(R"({"type":"subscribeTelemetry","groups":["radios"]})"), "groups:radios,@0");
+    EXPECT_EQ(dispatch(R"({"type":"subscribeTelemetry","groups":["radios"],"maxRate":null})"), "groups:radios,@0");
+}
+
+TEST_F(CommandRegistryTests, RejectsMissingRequiredFields) {
+    EXPECT_EQ(dispatch(R"({"type":"setTelemetryRate","requestId":"7"})"),
+              TestCommands::toErrorResponse("setTelemetryRate", "7", "Missing field: rate"));
+    EXPECT_EQ(dispatch(R"({"type":"setTelemetryRate","requestId":"8","rate":null})"),
+              TestCommands::toErrorResponse("setTelemetryRate", "8", "Missing field: rate"));
+    EXPECT_EQ(dispatch(R"({"type":"subscribeTelemetry","maxRate":10})"),
+              TestCommands::toErrorResponse("subscribeTelemetry", "", "Missing field: groups"));
+    EXPECT_EQ(handled, 0);
+}
+
+TEST_F(CommandRegistryTests, RejectsFieldsOfTheWrongType) {
+    EXPECT_EQ(dispatch(R"({"type":"setTelemetryRate","requestId":"1","rate":5})"),
+              TestCommands::toErrorResponse("setTelemetryRate", "1", "Field rate must be a string"));
+    EXPECT_EQ(dispatch(R"({"type":"subscribeTelemetry","groups":"position"})"),
+              TestCommands::toErrorResponse("subscribeTelemetry", "", "Field groups must be an array of strings"));
+    EXPECT_EQ(dispatch(R"({"type":"subscribeTelemetry","groups":["position",1]})"),
+              TestCommands::toErrorResponse("subscribeTelemetry", "", "Field groups must be an array of strings"));
+    EXPECT_EQ(dispatch(R"({"type":"subscribeTelemetry","groups":[],"maxRate":"10"})"),
+              TestCommands::toErrorResponse("subscribeTelemetry", "", "Field maxRate must be an integer"));
+    EXPECT_EQ(dispatch(R"({"type":"setTelemetryRate","requestId":2,"rate":"cruise"})"),
+              TestCommands::toErrorResponse("", "", "Field requestId must be a string"));
+    EXPECT_EQ(handled, 0);
+}
+
+TEST_F(CommandRegistryTests, RejectsUnknownCommandsAndMalformedMessages) {
+    EXPECT_EQ(dispatch(R"({"type":"selfDestruct","requestId":"3"})"),
+              TestCommands::toErrorResponse("selfDestruct", "3", "Unknown command"));
+    EXPECT_EQ(dispatch(R"({"requestId":"4"})"),
+              TestCommands::toErrorResponse("", "4", "Field type must be a string"));
+    EXPECT_NE(dispatch(R"({"type":"setTelemetryRate",)").find("\"type\":\"errorResponse\""), std::string::npos);
+    EXPECT_EQ(handled, 0);
+
+    std::string stats;
+    JsonWriter json(stats);
+    commands.writeStats(json);
+    EXPECT_NE(stats.find("\"rejected\":3"), std::string::npos) << stats;
+}
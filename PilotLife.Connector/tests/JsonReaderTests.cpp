@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+#include "JsonReader.h"
+#include "JsonWriter.h"
+
+namespace {
+
+// Re-serializes the events it receives as compact JSON, and checks every number
+// against the RFC 8259 grammar independently of the reader
+class CanonicalWriter : public JsonReader::Handler {
+public:
+    bool beginObject() override { separator(); m_out += '{'; m_first.push_back(true); return true; }
+    bool endObject() override { m_out += '}'; m_first.pop_back(); return true; }
+    bool beginArray() override { separator(); m_out += '['; m_first.push_back(true); return true; }
+    bool endArray() override { m_out += ']'; m_first.pop_back(); return true; }
+
+    bool key(std::string_view name) override {
+        separator();
+        quoted(name);
+        m_out += ':';
+        m_afterKey = true;
+        return true;
+    }
+
+    bool string(std::string_view value) override { separator(); quoted(value); return true; }
+
+    bool number(std::string_view text) override {
+        static const std::regex grammar("-?(0|[1-9][0-9]*)(\\.[0-9]+)?([eE][-+]?[0-9]+)?");
+        if (!std::regex_match(text.begin(), text.end(), grammar)) {
+            m_badNumbers.emplace_back(text);
+        }
+        separator();
+        m_out.append(text.data(), text.size());
+        return true;
+    }
+
+    bool boolean(bool value) override { separator(); m_out += value ? "true" : "false"; return true; }
+    bool null() override { separator(); m_out += "null"; return true; }
+
+    const std::string& str() const { return m_out; }
+    const std::vector<std::string>& badNumbers() const { return m_badNumbers; }
+
+private:
+    void separator() {
+        if (m_afterKey) {
+            m_afterKey = false;
+        } else if (!m_first.empty()) {
+            if (!m_first.back()) m_out += ',';
+            m_first.back() = false;
+        }
+    }
+
+    void quoted(std::string_view text) {
+        m_out += '"';
+        JsonWriter::appendEscaped(m_out, text);
+        m_out += '"';
+    }
+
+    std::string m_out;
+    std::vector<bool> m_first;
+    bool m_afterKey = false;
+    std::vector<std::string> m_badNumbers;
+};
+
+bool accepts(std::string_view json) {
+    CanonicalWriter writer;
+    return JsonReader::parse(json, writer);
+}
+
+std::string canonical(std::string_view json) {
+    CanonicalWriter writer;
+    EXPECT_TRUE(JsonReader::parse(json, writer)) << json;
+    return writer.str();
+}
+
+// Checks that hold for any input: numbers the reader accepts follow the grammar, and
+// an accepted document reads back to the same events once re-serialized
+void checkDocument(std::string_view json) {
+    CanonicalWriter first;
+    if (!JsonReader::parse(json, first)) {
+        return;
+    }
+    EXPECT_TRUE(first.badNumbers().empty()) << json << " -> " << first.badNumbers()[0];
+
+    CanonicalWriter second;
+    ASSERT_TRUE(JsonReader::parse(first.str(), second)) << first.str();
+    EXPECT_EQ(second.str(), first.str());
+}
+
+} // namespace
+
+TEST(JsonReaderTests, AcceptsValidNumbers) {
+    for (const char* json : { "0", "-0", "1", "-1", "10", "1.5", "-0.25", "0e0", "1E+2", "1e-2", "1.0E10",
+                              "12345678901234567890", "[0,1]", "{\"a\":-0.0e-0}" }) {
+        EXPECT_TRUE(accepts(json)) << json;
+    }
+}
+
+TEST(JsonReaderTests, RejectsMalformedNumbers) {
+    for (const char* json : { "{\"a\":-}", "{\"a\":e}", "{\"a\":1-2+e.}", "[--]", "-", "+1", "01", "-01",
+                              ".5", "1.", "1.e5", "1e", "1e+", "1e-", "0x10", "1..2", "1ee2", "[1.2.3]",
+                              "Infinity", "-Infinity", "NaN", "[1 2]" }) {
+        EXPECT_FALSE(accepts(json)) << json;
+    }
+}
+
+TEST(JsonReaderTests, DecodesEscapes) {
+    EXPECT_EQ(canonical("[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]"), "[\"\\\"\\\\/\\b\\f\\n\\r\\t\"]");
+    EXPECT_EQ(canonical("[\"\\u00e9\\u20AC\"]"), "[\"\xC3\xA9\xE2\x82\xAC\"]");
+    EXPECT_EQ(canonical("[\"\\ud83d\\ude00\"]"), "[\"\xF0\x9F\x98\x80\"]");
+}
+
+TEST(JsonReaderTests, RejectsUnpairedSurrogates) {
+    for (const char* json : { "[\"\\ud800\"]", "[\"\\udc00\"]", "[\"\\ud800x\"]", "[\"\\ud800\\u0041\"]",
+                              "[\"\\ud800\\ud800\"]", "[\"\\ude00\\ud83d\"]", "[\"\\ud800\\n\"]" }) {
+        EXPECT_FALSE(accepts(json)) << json;
+    }
+}
+
+TEST(JsonReaderTests, RejectsMalformedStructure) {
+    for (const char* json : { "", " ", "{", "}", "[", "[1,]", "[,1]", "{\"a\"}", "{\"a\":}", "{\"a\":1,}",
+                              "{a:1}", "{\"a\" 1}", "[1]x", "[1][2]", "tru", "nul", "\"abc", "[\"\\x\"]",
+                              "[\"\\u12\"]", "[\"\\u12G4\"]", "'a'" }) {
+        EXPECT_FALSE(accepts(json)) << json;
+    }
+}
+
+TEST(JsonReaderTests, AcceptsValidDocuments) {
+    EXPECT_EQ(canonical("\xEF\xBB\xBF { \"a\" : [ 1 , true , false , null , { } , [ ] ] , \"b\" : \"c\" } \r\n"),
+              "{\"a\":[1,true,false,null,{},[]],\"b\":\"c\"}");
+    EXPECT_EQ(canonical("\"top-level string\""), "\"top-level string\"");
+}
+
+TEST(JsonReaderTests, LimitsNesting) {
+    EXPECT_TRUE(accepts(std::string(64, '[') + std::string(64, ']')));
+    EXPECT_FALSE(accepts(std::string(65, '[') + std::string(65, ']')));
+    EXPECT_FALSE(accepts(std::string(100000, '[')));
+}
+
+TEST(JsonReaderTests, MutatedDocumentsKeepTheInvariants) {
+    // Seeds cover every token type; mutations splice in JSON fragments as well as random bytes
+    const std::vector<std::string> seeds = {
+        "{\"type\":\"getAircraftData\",\"requestId\":\"r-1\",\"title\":\"Cessna \\\"172\\\" \\u00e9\"}",
+        "{\"type\":\"subscribeTelemetry\",\"groups\":[\"position\",\"radios\"],\"maxRateHz\":10,\"binary\":false}",
+        "[0,-1.5e+3,12.25E-2,null,true,{\"a\":{\"b\":[[]]}},\"\\ud83d\\ude00\"]",
+        "{\"content_type\":\"AIRCRAFT\",\"title\":\"A\",\"release_notes\":{\"neutral\":{}},\"total_package_size\":\"00001\"}",
+    };
+    const std::vector<std::string> fragments = {
+        "-", "+", ".", "e", "E", "0", "1", "9", "\"", "\\", "\\u", "\\ud800", "\\udc00", "{", "}", "[", "]",
+        ":", ",", "true", "null", " ", "\xEF\xBB\xBF", std::string(1, '\0'),
+    };
+
+    std::mt19937 random(8259);
+    for (int i = 0; i < 200000; i++) {
+        std::string json = seeds[random() % seeds.size()];
+        int edits = 1 + static_cast<int>(random() % 4);
+        for (int edit = 0; edit < edits && !json.empty(); edit++) {
+            size_t at = random() % json.size();
+            switch (random() % 4) {
+                case 0: json[at] = static_cast<char>(random() & 0xFF); break;
+                case 1: json.erase(at, 1 + random() % 3); break;
+                case 2: json.insert(at, fragments[random() % fragments.size()]); break;
+                case 3: json.insert(at, json.substr(random() % json.size(), 1 + random() % 8)); break;
+            }
+        }
+        checkDocument(json);
+        if (::testing::Test::HasFailure()) {
+            break;
+        }
+    }
+}
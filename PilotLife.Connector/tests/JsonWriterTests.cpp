@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "AllocationCounter.h"
+#include "FlightData.h"
+#include "JsonWriter.h"
+#include "SampleFlightData.h"
+
+TEST(JsonWriterTests, SeparatesMembersAndElements) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("a", 1);
+    json.key("b");
+    json.beginArray();
+    json.value(true);
+    json.null();
+    json.beginObject();
+    json.endObject();
+    json.beginArray();
+    json.endArray();
+    json.endArray();
+    json.field("c", "x");
+    json.key("d");
+    json.rawValue("{\"e\":2}");
+    json.endObject();
+
+    EXPECT_EQ(buffer, "{\"a\":1,\"b\":[true,null,{},[]],\"c\":\"x\",\"d\":{\"e\":2}}");
+}
+
+TEST(JsonWriterTests, EscapesStrings) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.value(std::string_view("q\"b\\n\nr\rt\tb\bf\f\x01\x1f\x7f\xc3\xa9", 19));
+
+    EXPECT_EQ(buffer, "\"q\\\"b\\\\n\\nr\\rt\\tb\\bf\\f\\u0001\\u001f\x7f\xc3\xa9\"");
+}
+
+TEST(JsonWriterTests, EscapesKeys) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("k\"ey", false);
+    json.endObject();
+
+    EXPECT_EQ(buffer, "{\"k\\\"ey\":false}");
+}
+
+TEST(JsonWriterTests, FormatsNumbersAtFixedPrecision) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginArray();
+    json.value(47.4502497, 6);
+    json.value(-0.5, 0);
+    json.value(1.25, 1);
+    json.value(0.1, 3);
+    json.value(1e300, 2);
+    json.value(static_cast<int64_t>(-9007199254740993));
+    json.endArray();
+
+    // Values too long for fixed notation fall back to (still valid JSON) scientific notation
+    EXPECT_EQ(buffer, "[47.450250,-0,1.2,0.100,1.00e+300,-9007199254740993]");
+}
+
+TEST(JsonWriterTests, WritesNonFiniteNumbersAsNull) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginArray();
+    json.value(std::numeric_limits<double>::quiet_NaN(), 2);
+    json.value(std::numeric_limits<double>::infinity(), 2);
+    json.value(-std::numeric_limits<double>::infinity(), 2);
+    json.endArray();
+
+    EXPECT_EQ(buffer, "[null,null,null]");
+}
+
+TEST(JsonWriterTests, ResetKeepsCapacity) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    json.beginObject();
+    json.field("text", std::string(1000, 'x'));
+    json.endObject();
+    size_t capacity = buffer.capacity();
+
+    json.reset();
+    json.beginArray();
+    json.endArray();
+
+    EXPECT_EQ(buffer, "[]");
+    EXPECT_EQ(buffer.capacity(), capacity);
+}
+
+TEST(JsonWriterTests, WritesStatusMessage) {
+    SimulatorStatus status{ true, false, "MSFS2024", "" };
+    EXPECT_EQ(status.toMessage(),
+              "{\"type\":\"status\",\"data\":{\"isConnected\":true,\"isSimRunning\":false,\"simulatorVersion\":\"MSFS2024\"}}");
+
+    status.connectionError = "Simulator closed";
+    EXPECT_NE(status.toMessage().find(",\"connectionError\":\"Simulator closed\"}}"), std::string::npos);
+}
+
+TEST(JsonWriterTests, WritesFlightDataMessage) {
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+    FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+
+    EXPECT_EQ(buffer.rfind("{\"type\":\"flightData\",\"data\":{\"aircraftTitle\":\"Airbus A320 Neo FlyByWire \\\"House\\\" Livery\",", 0), 0u);
+    EXPECT_NE(buffer.find("\"latitude\":47.450250,"), std::string::npos);
+    EXPECT_NE(buffer.find("\"machNumber\":0.781,"), std::string::npos);
+    EXPECT_NE(buffer.find("\"com1Frequency\":\"118.700\""), std::string::npos);
+    EXPECT_NE(buffer.find("\"simulatorVersion\":\"MSFS2024\"}}"), std::string::npos);
+}
+
+TEST(JsonWriterTests, FlightDataMessageDoesNotAllocateOnceWarm) {
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+    FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+
+    uint64_t before = threadAllocationCount();
+    for (int i = 0; i < 100; i++) {
+        data.setNumber(simVarIndex("PLANE LATITUDE"), 47.45 + i * 0.001);
+        FlightDataEncoder::writeMessage(data, "MSFS2024", buffer);
+    }
+    EXPECT_EQ(threadAllocationCount() - before, 0u);
+}
+
+TEST(JsonWriterTests, FlightDataJsonMatchesTheEncoder) {
+    SimConnectFlightData data = makeSampleFlightData();
+    FlightDataJson json = FlightDataJson::fromSimConnect(data, "MSFS2024");
+    EXPECT_EQ(json.aircraftTitle, "Airbus A320 Neo FlyByWire \"House\" Livery");
+    EXPECT_EQ(json.engineType, 1);
+    EXPECT_EQ(json.engineTypeStr, "Jet");
+    EXPECT_DOUBLE_EQ(json.latitude, 47.4502497);
+    EXPECT_DOUBLE_EQ(json.fuelLbs, 4200.0 * 6.7);
+    EXPECT_EQ(json.com1Frequency, "118.700");
+    EXPECT_EQ(json.simulatorVersion, "MSFS2024");
+
+    // Same bytes as the telemetry path once both carry the same timestamp
+    std::string encoded;
+    FlightDataEncoder::writeMessage(data, "MSFS2024", encoded);
+    std::string marker = "\"timestamp\":\"";
+    size_t start = encoded.find(marker) + marker.size();
+    json.timestamp = encoded.substr(start, encoded.find('"', start) - start);
+
+    std::string message;
+    json.writeMessage(message);
+    EXPECT_EQ(message, encoded);
+    EXPECT_EQ("{\"type\":\"flightData\",\"data\":" + json.toJson() + "}", encoded);
+}
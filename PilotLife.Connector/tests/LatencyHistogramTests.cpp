@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+
+namespace {
+
+using std::chrono::microseconds;
+
+std::string toJson(const LatencyHistogram& histogram) {
+    std::string buffer;
+    JsonWriter json(buffer);
+    histogram.writeJson(json);
+    return buffer;
+}
+
+} // namespace
+
+TEST(LatencyHistogramTests, BucketsByPowersOfTwoMicroseconds) {
+    LatencyHistogram histogram;
+    histogram.record(microseconds(0));     // Bucket 0: under 1 us
+    histogram.record(std::chrono::nanoseconds(999));
+    histogram.record(microseconds(1));     // Bucket 1: [1, 2)
+    histogram.record(microseconds(2));     // Bucket 2: [2, 4)
+    histogram.record(microseconds(3));
+    histogram.record(microseconds(4));     // Bucket 3: [4, 8)
+    histogram.record(microseconds(7));
+
+    EXPECT_EQ(histogram.count(), 7u);
+    EXPECT_NE(toJson(histogram).find("\"buckets\":[2,1,2,2]"), std::string::npos) << toJson(histogram);
+}
+
+TEST(LatencyHistogramTests, LastBucketTakesEverythingAbove) {
+    LatencyHistogram histogram;
+    histogram.record(microseconds(1023));  // Bucket 10: [512, 1024)
+    histogram.record(microseconds(1024));  // Bucket 11
+    histogram.record(std::chrono::hours(24 * 365));
+    histogram.record(microseconds(-5));    // Clock skew counts as zero
+
+    std::string json = toJson(histogram);
+    std::string expected = "\"buckets\":[1,0,0,0,0,0,0,0,0,0,1,1";
+    for (size_t i = 12; i < LatencyHistogram::BUCKET_COUNT - 1; i++) expected += ",0";
+    expected += ",1]";
+    EXPECT_NE(json.find(expected), std::string::npos) << json;
+}
+
+TEST(LatencyHistogramTests, QuantilesReportTheirBucketsUpperBound) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.quantileMs(0.5), 0.0);
+
+    // 90 fast requests in [64, 128) us, 10 slow ones in [4096, 8192) us
+    for (int i = 0; i < 90; i++) histogram.record(microseconds(100));
+    for (int i = 0; i < 10; i++) histogram.record(microseconds(5000));
+
+    EXPECT_DOUBLE_EQ(histogram.quantileMs(0.0), 0.128);
+    EXPECT_DOUBLE_EQ(histogram.quantileMs(0.5), 0.128);
+    EXPECT_DOUBLE_EQ(histogram.quantileMs(0.9), 0.128);
+    EXPECT_DOUBLE_EQ(histogram.quantileMs(0.91), 8.192);
+    EXPECT_DOUBLE_EQ(histogram.quantileMs(0.99), 8.192);
+    EXPECT_DOUBLE_EQ(histogram.quantileMs(1.0), 8.192);
+
+    std::string json = toJson(histogram);
+    EXPECT_NE(json.find("\"count\":100,\"meanMs\":0.590,\"p50Ms\":0.128,\"p90Ms\":0.128,\"p99Ms\":8.192,\"maxMs\":5.000"),
+              std::string::npos) << json;
+}
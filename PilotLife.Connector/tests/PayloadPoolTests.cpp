@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include "AllocationCounter.h"
+#include "PayloadPool.h"
+
+using Payload = std::shared_ptr<const std::string>;
+
+TEST(PayloadPoolTests, ReusesABufferOnceEveryHolderReleasedIt) {
+    PayloadPool pool;
+    auto first = pool.acquire();
+    first->assign(100, 'x');
+    const std::string* address = first.get();
+    size_t capacity = first->capacity();
+
+    // A client still holds the first payload, so the next tick gets another buffer
+    Payload held = std::move(first);
+    auto second = pool.acquire();
+    EXPECT_NE(second.get(), address);
+    second.reset();
+
+    // Released everywhere: handed out again, empty but with its capacity
+    held.reset();
+    auto reused = pool.acquire();
+    EXPECT_EQ(reused.get(), address);
+    EXPECT_TRUE(reused->empty());
+    EXPECT_GE(reused->capacity(), capacity);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(PayloadPoolTests, FallsBackToUnpooledBuffersWhenAllAreHeld) {
+    PayloadPool pool(2);
+    Payload a = pool.acquire();
+    Payload b = pool.acquire();
+    Payload c = pool.acquire();
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_NE(c.get(), a.get());
+    EXPECT_NE(c.get(), b.get());
+
+    // Only pooled buffers come back
+    const std::string* pooled = a.get();
+    a.reset();
+    c.reset();
+    EXPECT_EQ(pool.acquire().get(), pooled);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(PayloadPoolTests, SteadyStreamDoesNotAllocate) {
+    PayloadPool pool;
+    Payload latest;       // What a latest-wins client queue holds between ticks
+    Payload sending;      // The frame the fan-out thread is sending
+
+    auto tick = [&](int i) {
+        auto buffer = pool.acquire();
+        buffer->assign("{\"type\":\"flightData\",\"data\":{\"tick\":");
+        buffer->append(std::to_string(i % 10));
+        buffer->append("}}");
+        sending = std::move(latest);
+        latest = std::move(buffer);
+    };
+
+    for (int i = 0; i < 10; i++) {
+        tick(i);
+    }
+    uint64_t allocations = threadAllocationCount();
+    for (int i = 0; i < 1000; i++) {
+        tick(i);
+    }
+    EXPECT_EQ(threadAllocationCount() - allocations, 0u);
+    EXPECT_LE(pool.size(), 3u);
+}
+
+TEST(PayloadPoolTests, BufferReleasedOnAnotherThreadIsReused) {
+    PayloadPool pool;
+    auto buffer = pool.acquire();
+    buffer->assign("frame");
+    const std::string* address = buffer.get();
+
+    Payload payload = std::move(buffer);
+    std::thread client([held = std::move(payload)]() mutable {
+        EXPECT_EQ(*held, "frame");
+        held.reset();
+    });
+    client.join();
+
+    EXPECT_EQ(pool.acquire().get(), address);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RequestExecutor.h"
+
+namespace {
+
+constexpr auto TIMEOUT = std::chrono::seconds(10);
+
+// Poll until a condition holds (workers run asynchronously)
+template <typename Condition>
+bool eventually(Condition condition) {
+    auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// A task that holds its worker until released
+class Blocker {
+public:
+    RequestExecutor::Task task() {
+        return [this] {
+            m_running.set_value();
+            m_released.wait();
+        };
+    }
+
+    void waitUntilRunning() { ASSERT_EQ(m_runningFuture.wait_for(TIMEOUT), std::future_status::ready); }
+    void release() { m_release.set_value(); }
+
+private:
+    std::promise<void> m_running;
+    std::future<void> m_runningFuture = m_running.get_future();
+    std::promise<void> m_release;
+    std::shared_future<void> m_released = m_release.get_future().share();
+};
+
+} // namespace
+
+TEST(RequestExecutorTests, RunsEachClientsTasksInOrder) {
+    RequestExecutor executor(4, 1000, 1000);
+    std::mutex mutex;
+    std::vector<int> order;
+
+    constexpr int TASKS = 200;
+    for (int i = 0; i < TASKS; i++) {
+        ASSERT_TRUE(executor.submit("client", [&, i] {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+            }
+            executor.complete("client");
+        }));
+    }
+
+    ASSERT_TRUE(eventually([&] { return executor.getInFlightCount() == 0; }));
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(order.size(), static_cast<size_t>(TASKS));
+    for (int i = 0; i < TASKS; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(RequestExecutorTests, RunsDifferentClientsInParallel) {
+    RequestExecutor executor(2, 8, 8);
+
+    // a's task only finishes once b's has run, so b must not wait behind it
+    std::promise<void> bRan;
+    std::future<void> bRanFuture = bRan.get_future();
+    std::atomic<bool> aSawB{false};
+    ASSERT_TRUE(executor.submit("a", [&] {
+        aSawB = bRanFuture.wait_for(TIMEOUT) == std::future_status::ready;
+        executor.complete("a");
+    }));
+    ASSERT_TRUE(executor.submit("b", [&] {
+        bRan.set_value();
+        executor.complete("b");
+    }));
+
+    ASSERT_TRUE(eventually([&] { return executor.getInFlightCount() == 0; }));
+    EXPECT_TRUE(aSawB);
+}
+
+TEST(RequestExecutorTests, LimitsRequestsInFlightPerClient) {
+    RequestExecutor executor(1, 2, 100);
+
+    // Tasks that hand their request off and leave it unanswered
+    ASSERT_TRUE(executor.submit("a", [] {}));
+    ASSERT_TRUE(executor.submit("a", [] {}));
+    ASSERT_TRUE(eventually([&] { return executor.getQueuedCount() == 0; }));
+    EXPECT_EQ(executor.getInFlightCount(), 2u);
+
+    EXPECT_FALSE(executor.submit("a", [] {}));
+    EXPECT_TRUE(executor.submit("b", [] {}));
+
+    // Answering one frees its slot
+    executor.complete("a");
+    EXPECT_TRUE(executor.submit("a", [] {}));
+    EXPECT_FALSE(executor.submit("a", [] {}));
+
+    // Unknown clients and extra completions are ignored
+    executor.complete("nobody");
+    executor.complete("b");
+    executor.complete("b");
+    EXPECT_EQ(executor.getInFlightCount(), 2u);
+}
+
+TEST(RequestExecutorTests, LimitsTasksWaitingForAWorker) {
+    RequestExecutor executor(1, 8, 3);
+    Blocker blocker;
+    ASSERT_TRUE(executor.submit("blocker", blocker.task()));
+    blocker.waitUntilRunning();
+
+    std::atomic<int> ran{0};
+    auto task = [&](const std::string& client) {
+        return [&executor, &ran, client] {
+            ran++;
+            executor.complete(client);
+        };
+    };
+    EXPECT_TRUE(executor.submit("a", task("a")));
+    EXPECT_TRUE(executor.submit("b", task("b")));
+    EXPECT_TRUE(executor.submit("a", task("a")));
+    EXPECT_EQ(executor.getQueuedCount(), 3u);
+    EXPECT_FALSE(executor.submit("c", task("c")));
+
+    blocker.release();
+    executor.complete("blocker");
+    ASSERT_TRUE(eventually([&] { return executor.getInFlightCount() == 0; }));
+    EXPECT_EQ(ran, 3);
+    EXPECT_TRUE(executor.submit("c", task("c")));
+    ASSERT_TRUE(eventually([&] { return ran == 4; }));
+}
+
+TEST(RequestExecutorTests, StopDropsQueuedTasksAndRefusesNewOnes) {
+    RequestExecutor executor(1, 1000, 1000);
+    Blocker blocker;
+    ASSERT_TRUE(executor.submit("blocker", blocker.task()));
+    blocker.waitUntilRunning();
+
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(executor.submit("a", [&] { ran++; }));
+    }
+
+    // stop() waits for the running task, then forgets everything still queued
+    std::thread stopping([&] { executor.stop(); });
+    ASSERT_TRUE(eventually([&] { return !executor.submit("b", [&] { ran++; }); }));
+    blocker.release();
+    stopping.join();
+
+    EXPECT_EQ(ran, 0);
+    EXPECT_EQ(executor.getQueuedCount(), 0u);
+    EXPECT_EQ(executor.getInFlightCount(), 0u);
+    EXPECT_FALSE(executor.submit("a", [&] { ran++; }));
+    executor.complete("blocker");  // Late answers are harmless
+    executor.stop();
+}
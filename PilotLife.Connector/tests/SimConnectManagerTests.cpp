@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "SampleFlightData.h"
+#include "ScriptedSimMessageSource.h"
+#include "SimConnectManager.h"
+
+namespace {
+
+// Poll until the condition holds; the dispatch loop runs on its own thread
+template <typename Condition>
+bool eventually(Condition condition, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// A manager connected to a scripted source, with its dispatch loop running
+class SimConnectManagerTest : public ::testing::Test {
+protected:
+    ScriptedSimMessageSource* source = nullptr;
+    std::unique_ptr<SimConnectManager> manager;
+    std::atomic<int> samples{0};
+    SimConnectFlightData lastSample{};
+
+    void SetUp() override {
+        manager = std::make_unique<SimConnectManager>([this](const std::string&) {
+            auto scripted = std::make_unique<ScriptedSimMessageSource>();
+            source = scripted.get();
+            return std::unique_ptr<SimMessageSource>(std::move(scripted));
+        });
+        manager->setFlightDataCallback([this](const SimConnectFlightData& data, const std::string&) {
+            lastSample = data;
+            samples++;
+        });
+        ASSERT_TRUE(manager->connect());
+        manager->startDispatchLoop();
+    }
+
+    void TearDown() override {
+        manager->stopDispatchLoop();
+        manager->disconnect();
+    }
+};
+
+} // namespace
+
+TEST(SimConnectManagerConnectTests, FailsWithoutASource) {
+    SimConnectManager manager([](const std::string&) { return std::unique_ptr<SimMessageSource>(); });
+    EXPECT_FALSE(manager.connect());
+    EXPECT_FALSE(manager.isConnected());
+}
+
+TEST_F(SimConnectManagerTest, ConnectRequestsTheCurrentRate) {
+    EXPECT_TRUE(manager->isConnected());
+    ASSERT_EQ(source->rateRequests().size(), 1u);
+    EXPECT_EQ(source->rateRequests()[0], TelemetryRate::Idle);
+}
+
+TEST_F(SimConnectManagerTest, PublishesOnlyOnceEveryBlockHasArrived) {
+    SimConnectFlightData sample = makeSampleFlightData();
+
+    // Fast data before the change-tracked blocks would be a partial sample
+    source->pushBlock(REQUEST_FLIGHT_FAST, sample);
+    ASSERT_TRUE(eventually([&] { return source->backlog() == 0; }));
+    source->pushBlock(REQUEST_AIRCRAFT_STATIC, sample);
+    source->pushBlock(REQUEST_AIRCRAFT_SLOW, sample);
+    ASSERT_TRUE(eventually([&] { return source->backlog() == 0; }));
+    EXPECT_EQ(samples.load(), 0);
+
+    source->pushBlock(REQUEST_FLIGHT_FAST, sample);
+    ASSERT_TRUE(eventually([&] { return samples.load() == 1; }));
+    EXPECT_EQ(std::memcmp(lastSample.bytes, sample.bytes, sizeof(sample.bytes)), 0);
+}
+
+TEST_F(SimConnectManagerTest, IgnoresShortAndUnknownBlocks) {
+    SimConnectFlightData sample = makeSampleFlightData();
+    source->pushBlock(REQUEST_AIRCRAFT_STATIC, sample);
+    source->pushBlock(REQUEST_AIRCRAFT_SLOW, sample);
+
+    unsigned char shortBlock[8] = {};
+    source->pushData(REQUEST_FLIGHT_FAST, shortBlock, sizeof(shortBlock));
+    source->pushData(42, shortBlock, sizeof(shortBlock));
+    ASSERT_TRUE(eventually([&] { return source->backlog() == 0; }));
+    EXPECT_EQ(samples.load(), 0);
+}
+
+TEST_F(SimConnectManagerTest, DeliversEveryQueuedSample) {
+    SimConnectFlightData sample = makeSampleFlightData();
+    source->pushBlock(REQUEST_AIRCRAFT_STATIC, sample);
+    source->pushBlock(REQUEST_AIRCRAFT_SLOW, sample);
+    for (int i = 0; i < 100; i++) {
+        source->pushBlock(REQUEST_FLIGHT_FAST, sample);
+    }
+
+    EXPECT_TRUE(eventually([&] { return samples.load() == 100; }));
+}
+
+TEST_F(SimConnectManagerTest, IdleLoopDoesNotWakeUp) {
+    // Nothing queued: the loop should stay blocked, not poll
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(source->wakeups(), 0u);
+    EXPECT_EQ(source->timeouts(), 0u);
+}
+
+TEST_F(SimConnectManagerTest, RateSwitchReissuesTheRequestWithoutAllocating) {
+    SimConnectFlightData sample = makeSampleFlightData();
+    source->pushBlock(REQUEST_AIRCRAFT_STATIC, sample);
+    source->pushBlock(REQUEST_AIRCRAFT_SLOW, sample);
+
+    const TelemetryRate rates[] = { TelemetryRate::SimFrame, TelemetryRate::VisualFrame,
+                                    TelemetryRate::Cruise, TelemetryRate::Idle };
+    constexpr int SWITCHES = 200;
+    constexpr int SAMPLES_PER_SWITCH = 5;
+
+    // The first switch warms up whatever the dispatch thread allocates once
+    manager->setTelemetryRate(TelemetryRate::Cruise);
+    ASSERT_TRUE(eventually([&] { return source->rateRequests().size() == 2; }));
+    uint64_t warmAllocations = source->dispatchThreadAllocations();
+
+    int published = 0;
+    for (int i = 0; i < SWITCHES; i++) {
+        manager->setTelemetryRate(rates[i % 4]);
+        ASSERT_TRUE(eventually([&] { return source->rateRequests().size() == static_cast<size_t>(i + 3); }));
+
+        // Samples keep flowing at the new rate and none are left queued
+        for (int j = 0; j < SAMPLES_PER_SWITCH; j++) {
+            source->pushBlock(REQUEST_FLIGHT_FAST, sample);
+        }
+        published += SAMPLES_PER_SWITCH;
+        ASSERT_TRUE(eventually([&] { return samples.load() == published; }));
+        EXPECT_EQ(source->backlog(), 0u);
+    }
+
+    std::vector<TelemetryRate> requested = source->rateRequests();
+    for (int i = 0; i < SWITCHES; i++) {
+        EXPECT_EQ(requested[i + 2], rates[i % 4]);
+    }
+    EXPECT_EQ(manager->getTelemetryRate(), rates[(SWITCHES - 1) % 4]);
+    EXPECT_EQ(source->dispatchThreadAllocations(), warmAllocations);
+}
+
+TEST_F(SimConnectManagerTest, RateSwitchesCoalesceIntoTheLatestRate) {
+    // Switches made faster than the loop runs only re-issue the request the
+    // loop sees last; the latest rate always wins
+    manager->stopDispatchLoop();
+    manager->setTelemetryRate(TelemetryRate::SimFrame);
+    manager->setTelemetryRate(TelemetryRate::VisualFrame);
+    manager->startDispatchLoop();
+
+    ASSERT_TRUE(eventually([&] { return source->rateRequests().size() == 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(source->rateRequests().size(), 2u);
+    EXPECT_EQ(source->rateRequests()[1], TelemetryRate::VisualFrame);
+}
+
+TEST_F(SimConnectManagerTest, KeepsDispatchingAfterTheSimQuits) {
+    source->pushQuit();
+    ASSERT_TRUE(eventually([&] { return !manager->isConnected(); }));
+
+    // The loop is still alive on the installed source until it is stopped
+    manager->setTelemetryRate(TelemetryRate::Cruise);
+    ASSERT_TRUE(eventually([&] { return source->rateRequests().size() == 2; }));
+    EXPECT_EQ(source->rateRequests()[1], TelemetryRate::Cruise);
+}
+
+TEST_F(SimConnectManagerTest, ReconnectsAfterTheSimQuits) {
+    source->pushQuit();
+    ASSERT_TRUE(eventually([&] { return !manager->isConnected(); }));
+
+    ASSERT_TRUE(manager->connect());
+    manager->startDispatchLoop();
+    EXPECT_EQ(source->rateRequests().size(), 1u);
+
+    SimConnectFlightData sample = makeSampleFlightData();
+    source->pushBlock(REQUEST_AIRCRAFT_STATIC, sample);
+    source->pushBlock(REQUEST_AIRCRAFT_SLOW, sample);
+    source->pushBlock(REQUEST_FLIGHT_FAST, sample);
+    EXPECT_TRUE(eventually([&] { return samples.load() == 1; }));
+}
+
+TEST_F(SimConnectManagerTest, FailedWaitDisconnectsInsteadOfSpinning) {
+    source->failWaits();
+    ASSERT_TRUE(eventually([&] { return !manager->isConnected(); }));
+
+    // The loop has ended rather than retrying the failed wait
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(source->failures(), 1u);
+
+    // And the connector can reconnect with a fresh source
+    ASSERT_TRUE(manager->connect());
+    manager->startDispatchLoop();
+    EXPECT_TRUE(manager->isConnected());
+}
+
+TEST_F(SimConnectManagerTest, StopWakesTheBlockedLoop) {
+    auto start = std::chrono::steady_clock::now();
+    manager->stopDispatchLoop();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+}
+
+TEST(SimConnectManagerRateTests, ParsesAndNamesEveryRate) {
+    for (TelemetryRate rate : { TelemetryRate::Idle, TelemetryRate::Cruise,
+                                TelemetryRate::SimFrame, TelemetryRate::VisualFrame }) {
+        auto parsed = SimConnectManager::parseTelemetryRate(SimConnectManager::getTelemetryRateString(rate));
+        ASSERT_TRUE(parsed.has_value());
+        EXPECT_EQ(parsed.value(), rate);
+    }
+    EXPECT_FALSE(SimConnectManager::parseTelemetryRate("warp").has_value());
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SampleFlightData.h"
+#include "SpscRing.h"
+#include "TelemetryPublisher.h"
+
+namespace {
+
+// Every field carries the same sequence number, so a torn copy shows up as a mismatch
+struct Frame {
+    uint64_t values[32];
+
+    explicit Frame(uint64_t sequence = 0) {
+        for (auto& value : values) {
+            value = sequence;
+        }
+    }
+
+    bool consistent() const {
+        for (auto value : values) {
+            if (value != values[0]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// One producer pushes `count` frames as fast as it can while one consumer drains;
+// checks every popped frame is whole and newer than the last
+void stress(OverflowPolicy policy, uint64_t count) {
+    SpscRing<Frame> ring(8, policy);
+    std::atomic<bool> done{false};
+    uint64_t torn = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t received = 0;
+
+    std::thread consumer([&] {
+        Frame frame;
+        uint64_t last = 0;
+        bool any = false;
+        for (;;) {
+            bool finished = done.load();
+            if (!ring.pop(frame)) {
+                if (finished) {
+                    break;
+                }
+                continue;
+            }
+            received++;
+            if (!frame.consistent()) {
+                torn++;
+            }
+            if (any && frame.values[0] <= last) {
+                outOfOrder++;
+            }
+            last = frame.values[0];
+            any = true;
+        }
+    });
+
+    for (uint64_t i = 1; i <= count; i++) {
+        ring.push(Frame(i));
+    }
+    done = true;
+    consumer.join();
+
+    RingStats stats = ring.getStats();
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(outOfOrder, 0u);
+    EXPECT_EQ(stats.popped, received);
+    EXPECT_EQ(stats.depth, 0u);
+    // Every frame was either delivered, dropped or skipped
+    EXPECT_EQ(stats.popped + stats.dropped + stats.coalesced, count);
+}
+
+} // namespace
+
+TEST(SpscRingTests, DropOldestKeepsTheNewestItemsInOrder) {
+    SpscRing<int> ring(3, OverflowPolicy::DropOldest);
+    for (int i = 1; i <= 5; i++) {
+        EXPECT_TRUE(ring.push(i));
+    }
+
+    int item = 0;
+    std::vector<int> items;
+    while (ring.pop(item)) {
+        items.push_back(item);
+    }
+    EXPECT_EQ(items, (std::vector<int>{ 3, 4, 5 }));
+
+    RingStats stats = ring.getStats();
+    EXPECT_EQ(stats.pushed, 5u);
+    EXPECT_EQ(stats.popped, 3u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_EQ(stats.depth, 0u);
+    EXPECT_EQ(stats.maxDepth, 3u);
+}
+
+TEST(SpscRingTests, CoalesceLatestJumpsToTheNewestItem) {
+    SpscRing<int> ring(4, OverflowPolicy::CoalesceLatest);
+    for (int i = 1; i <= 3; i++) {
+        ring.push(i);
+    }
+
+    int item = 0;
+    ASSERT_TRUE(ring.pop(item));
+    EXPECT_EQ(item, 3);
+    EXPECT_FALSE(ring.pop(item));
+
+    RingStats stats = ring.getStats();
+    EXPECT_EQ(stats.popped, 1u);
+    EXPECT_EQ(stats.coalesced, 2u);
+    EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(SpscRingTests, EmptyRingPopsNothing) {
+    SpscRing<int> ring(2, OverflowPolicy::DropOldest);
+    int item = 7;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.pop(item));
+    EXPECT_EQ(item, 7);
+}
+
+TEST(SpscRingTests, DropOldestStressHasNoTornOrReorderedFrames) {
+    stress(OverflowPolicy::DropOldest, 200000);
+}
+
+TEST(SpscRingTests, CoalesceLatestStressHasNoTornOrReorderedFrames) {
+    stress(OverflowPolicy::CoalesceLatest, 200000);
+}
+
+TEST(TelemetryPublisherTests, PublishesFramesOnItsOwnThread) {
+    TelemetryPublisher publisher(64, OverflowPolicy::DropOldest);
+    std::mutex mutex;
+    std::vector<double> latitudes;
+    std::thread::id publisherThread;
+    publisher.setPublishCallback([&](const SimConnectFlightData& data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        latitudes.push_back(data.number(simVarIndex("PLANE LATITUDE")));
+        publisherThread = std::this_thread::get_id();
+    });
+    publisher.start();
+
+    SimConnectFlightData frame = makeSampleFlightData();
+    for (int i = 0; i < 10; i++) {
+        frame.setNumber(simVarIndex("PLANE LATITUDE"), i);
+        publisher.enqueue(frame);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (latitudes.size() == 10 || std::chrono::steady_clock::now() > deadline) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    publisher.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(latitudes.size(), 10u);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(latitudes[i], i);
+    }
+    EXPECT_NE(publisherThread, std::this_thread::get_id());
+    EXPECT_EQ(publisher.getStats().dropped, 0u);
+}
+
+TEST(TelemetryPublisherTests, ParsesOverflowPolicyNames) {
+    for (OverflowPolicy policy : { OverflowPolicy::DropOldest, OverflowPolicy::CoalesceLatest }) {
+        auto parsed = TelemetryPublisher::parseOverflowPolicy(TelemetryPublisher::getOverflowPolicyString(policy));
+        ASSERT_TRUE(parsed.has_value());
+        EXPECT_EQ(parsed.value(), policy);
+    }
+    EXPECT_FALSE(TelemetryPublisher::parseOverflowPolicy("block").has_value());
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "JsonWriter.h"
+#include "SampleFlightData.h"
+#include "TelemetryBinary.h"
+
+namespace {
+
+uint64_t readLittleEndian(const std::string& frame, size_t offset, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(frame[offset + i])) << (8 * i);
+    }
+    return value;
+}
+
+// Numbers and strings the decoder should produce for a sample, in schema order
+void expectedValues(const SimConnectFlightData& data, std::string_view simVersion,
+                    std::vector<double>& numbers, std::vector<std::string>& strings) {
+    for (const auto& field : FlightDataEncoder::getFields()) {
+        if (field.kind == FieldKind::Text) {
+            strings.emplace_back(field.text(data));
+        } else {
+            numbers.push_back(field.number(data));
+        }
+    }
+    strings.emplace_back(simVersion);
+}
+
+} // namespace
+
+TEST(TelemetryBinaryTests, RoundTripsEveryField) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    TelemetryBinaryDecoder decoder;
+    std::string stringTable;
+    std::string frame;
+
+    ASSERT_TRUE(encoder.writeFrames(data, "MSFS2024", stringTable, frame));
+    DecodedFlightData decoded;
+    EXPECT_FALSE(decoder.decode(stringTable, decoded));
+    ASSERT_TRUE(decoder.decode(frame, decoded));
+
+    std::vector<double> numbers;
+    std::vector<std::string> strings;
+    expectedValues(data, "MSFS2024", numbers, strings);
+    EXPECT_EQ(decoded.numbers, numbers);
+    EXPECT_EQ(decoded.strings, strings);
+    EXPECT_GT(decoded.timestampMs, 0u);
+}
+
+TEST(TelemetryBinaryTests, WritesTheDocumentedHeader) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    std::string stringTable;
+    std::string frame;
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+
+    ASSERT_GE(stringTable.size(), TelemetryBinary::HEADER_SIZE);
+    EXPECT_EQ(std::memcmp(stringTable.data(), "PLTB", 4), 0);
+    EXPECT_EQ(readLittleEndian(stringTable, 4, 2), TelemetryBinary::VERSION);
+    EXPECT_EQ(static_cast<uint8_t>(stringTable[6]), TelemetryBinary::FRAME_STRING_TABLE);
+    EXPECT_EQ(static_cast<uint8_t>(stringTable[7]), TelemetryBinary::FLAG_RESET_STRINGS);
+
+    ASSERT_GE(frame.size(), TelemetryBinary::HEADER_SIZE);
+    EXPECT_EQ(static_cast<uint8_t>(frame[6]), TelemetryBinary::FRAME_FLIGHT_DATA);
+    // Sequence numbers count frames of either type
+    EXPECT_EQ(readLittleEndian(frame, 8, 8), readLittleEndian(stringTable, 8, 8) + 1);
+}
+
+TEST(TelemetryBinaryTests, SendsStringsOnlyWhenTheyChange) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    TelemetryBinaryDecoder decoder;
+    std::string stringTable;
+    std::string frame;
+    DecodedFlightData decoded;
+
+    ASSERT_TRUE(encoder.writeFrames(data, "MSFS2024", stringTable, frame));
+    decoder.decode(stringTable, decoded);
+
+    data.setNumber(simVarIndex("PLANE LATITUDE"), 48.0);
+    EXPECT_FALSE(encoder.writeFrames(data, "MSFS2024", stringTable, frame));
+    ASSERT_TRUE(decoder.decode(frame, decoded));
+
+    // A new ATC ID adds exactly one string, without resetting the table
+    data.setText(simVarIndex("ATC ID"), "D-AIPL");
+    ASSERT_TRUE(encoder.writeFrames(data, "MSFS2024", stringTable, frame));
+    EXPECT_EQ(static_cast<uint8_t>(stringTable[7]), 0);
+    EXPECT_EQ(readLittleEndian(stringTable, TelemetryBinary::HEADER_SIZE, 2), 1u);
+    decoder.decode(stringTable, decoded);
+    ASSERT_TRUE(decoder.decode(frame, decoded));
+
+    std::vector<double> numbers;
+    std::vector<std::string> strings;
+    expectedValues(data, "MSFS2024", numbers, strings);
+    EXPECT_EQ(decoded.strings, strings);
+}
+
+TEST(TelemetryBinaryTests, DecoderAsksForResyncOnUnknownStrings) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    std::string stringTable;
+    std::string frame;
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+
+    // A client that joined after the table was sent
+    TelemetryBinaryDecoder late;
+    DecodedFlightData decoded;
+    EXPECT_FALSE(late.decode(frame, decoded));
+    EXPECT_TRUE(late.needsResync());
+
+    encoder.requestFullStringTable();
+    ASSERT_TRUE(encoder.writeFrames(data, "MSFS2024", stringTable, frame));
+    EXPECT_EQ(static_cast<uint8_t>(stringTable[7]), TelemetryBinary::FLAG_RESET_STRINGS);
+    late.decode(stringTable, decoded);
+    EXPECT_TRUE(late.decode(frame, decoded));
+    EXPECT_FALSE(late.needsResync());
+}
+
+TEST(TelemetryBinaryTests, RejectsTruncatedAndForeignFrames) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    std::string stringTable;
+    std::string frame;
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+
+    TelemetryBinaryDecoder decoder;
+    DecodedFlightData decoded;
+    decoder.decode(stringTable, decoded);
+    for (size_t length = 0; length < frame.size(); length++) {
+        EXPECT_FALSE(decoder.decode(std::string_view(frame.data(), length), decoded)) << length;
+    }
+
+    std::string foreign = frame;
+    foreign[0] = 'X';
+    EXPECT_FALSE(decoder.decode(foreign, decoded));
+
+    std::string future = frame;
+    future[4] = static_cast<char>(TelemetryBinary::VERSION + 1);
+    EXPECT_FALSE(decoder.decode(future, decoded));
+
+    EXPECT_TRUE(decoder.decode(frame, decoded));
+}
+
+TEST(TelemetryBinaryTests, SchemaListsEveryFieldInFrameOrder) {
+    std::string schema;
+    JsonWriter writer(schema);
+    TelemetryBinaryEncoder::writeSchema(writer);
+
+    std::string expected = "\"strings\":[";
+    bool first = true;
+    for (const auto& field : FlightDataEncoder::getFields()) {
+        if (field.kind == FieldKind::Text) {
+            expected += first ? "" : ",";
+            expected += "\"" + std::string(field.key) + "\"";
+            first = false;
+        }
+    }
+    expected += ",\"simulatorVersion\"]";
+    EXPECT_NE(schema.find(expected), std::string::npos) << schema;
+    EXPECT_NE(schema.find("\"magic\":\"PLTB\""), std::string::npos);
+}
+
+TEST(TelemetryBinaryTests, SteadyFramesDoNotAllocate) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    std::string stringTable;
+    std::string frame;
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+
+    uint64_t allocations = threadAllocationCount();
+    for (int i = 0; i < 100; i++) {
+        data.setNumber(simVarIndex("PLANE LATITUDE"), 47.0 + i * 0.001);
+        encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+    }
+    EXPECT_EQ(threadAllocationCount() - allocations, 0u);
+}
+
+TEST(TelemetryBinaryTests, DropsFramesFromBeforeAStringTableReset) {
+    SimConnectFlightData data = makeSampleFlightData();
+    TelemetryBinaryEncoder encoder;
+    TelemetryBinaryDecoder decoder;
+    std::string stringTable;
+    std::string frame;
+    DecodedFlightData decoded;
+
+    data.setText(simVarIndex("TITLE"), "Title 0");
+    encoder.writeFrames(data, "MSFS2024", stringTable, frame);
+    decoder.decode(stringTable, decoded);
+    ASSERT_TRUE(decoder.decode(frame, decoded));
+    std::string staleFrame = frame;
+
+    // A new title per sample until the table is full and the encoder starts over
+    bool reset = false;
+    for (int i = 1; i < 10000 && !reset; i++) {
+        data.setText(simVarIndex("TITLE"), "Title " + std::to_string(i));
+        if (encoder.writeFrames(data, "MSFS2024", stringTable, frame)) {
+            reset = static_cast<uint8_t>(stringTable[7]) == TelemetryBinary::FLAG_RESET_STRINGS;
+            decoder.decode(stringTable, decoded);
+        }
+        if (!reset) {
+            ASSERT_TRUE(decoder.decode(frame, decoded)) << i;
+        }
+    }
+    ASSERT_TRUE(reset);
+
+    // The frame still pending from before the reset names "Title 0" by an ID the
+    // reset table gave to the new title; it must not decode as that title
+    EXPECT_FALSE(decoder.decode(staleFrame, decoded));
+
+    ASSERT_TRUE(decoder.decode(frame, decoded));
+    std::vector<double> numbers;
+    std::vector<std::string> strings;
+    expectedValues(data, "MSFS2024", numbers, strings);
+    EXPECT_EQ(decoded.strings, strings);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <set>
+#include <string>
+#include "JsonReader.h"
+#include "SampleFlightData.h"
+#include "TelemetryDelta.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// The parts of a keyframe or delta the tests look at
+struct DeltaMessage : JsonReader::Handler {
+    std::string type;
+    std::map<std::string, int64_t> header;  // seq, keyframeSeq
+    std::set<std::string> dataKeys;
+
+    int depth = 0;
+    std::string currentKey;
+
+    bool beginObject() override { depth++; return true; }
+    bool endObject() override { depth--; return true; }
+    bool key(std::string_view name) override {
+        currentKey = name;
+        if (depth == 2) dataKeys.insert(currentKey);
+        return true;
+    }
+    bool string(std::string_view value) override {
+        if (depth == 1 && currentKey == "type") type = value;
+        return true;
+    }
+    bool number(std::string_view value) override {
+        if (depth == 1) header[currentKey] = std::stoll(std::string(value));
+        return true;
+    }
+};
+
+DeltaMessage read(const std::string& json) {
+    DeltaMessage message;
+    EXPECT_TRUE(JsonReader::parse(json, message)) << json;
+    return message;
+}
+
+// One 1 Hz tick of the sample cruise: position, altitudes and speeds move, the rest holds
+SimConnectFlightData nextCruiseTick(SimConnectFlightData data) {
+    auto nudge = [&](const char* name, double by) {
+        data.setNumber(simVarIndex(name), data.number(simVarIndex(name)) + by);
+    };
+    nudge("PLANE LATITUDE", -0.000354);
+    nudge("PLANE LONGITUDE", 0.002027);
+    nudge("INDICATED ALTITUDE", 1.2);
+    nudge("PLANE ALTITUDE", 1.1);
+    nudge("PLANE ALT ABOVE GROUND", 3.6);
+    nudge("AIRSPEED INDICATED", 0.3);
+    nudge("AIRSPEED TRUE", 0.4);
+    nudge("GROUND VELOCITY", -0.6);
+    return data;
+}
+
+} // namespace
+
+TEST(TelemetryDeltaTests, StartsWithAKeyframe) {
+    TelemetryDeltaEncoder encoder(5s);
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+
+    EXPECT_TRUE(encoder.writeMessage(data, "MSFS2024", buffer));
+    DeltaMessage keyframe = read(buffer);
+    EXPECT_EQ(keyframe.type, "flightDataKeyframe");
+    EXPECT_EQ(keyframe.header["seq"], 1);
+    EXPECT_EQ(keyframe.header.count("keyframeSeq"), 0u);
+    EXPECT_TRUE(keyframe.dataKeys.count("aircraftTitle"));
+    EXPECT_TRUE(keyframe.dataKeys.count("simulatorVersion"));
+
+    EXPECT_FALSE(encoder.writeMessage(data, "MSFS2024", buffer));
+    EXPECT_EQ(read(buffer).type, "flightDataDelta");
+}
+
+TEST(TelemetryDeltaTests, SendsAKeyframeWhenRequested) {
+    TelemetryDeltaEncoder encoder(5s);
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+
+    encoder.writeMessage(data, "MSFS2024", buffer);
+    EXPECT_FALSE(encoder.writeMessage(data, "MSFS2024", buffer));
+    encoder.requestKeyframe();
+    EXPECT_TRUE(encoder.writeMessage(data, "MSFS2024", buffer));
+    EXPECT_EQ(read(buffer).type, "flightDataKeyframe");
+    EXPECT_FALSE(encoder.writeMessage(data, "MSFS2024", buffer));
+}
+
+TEST(TelemetryDeltaTests, SendsAKeyframeEveryInterval) {
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+
+    // A zero interval has always elapsed, a long one never does within the test
+    TelemetryDeltaEncoder everySample(0s);
+    TelemetryDeltaEncoder never(1h);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(everySample.writeMessage(data, "MSFS2024", buffer));
+        EXPECT_EQ(never.writeMessage(data, "MSFS2024", buffer), i == 0);
+    }
+}
+
+TEST(TelemetryDeltaTests, NumbersMessagesAndPointsDeltasAtTheirKeyframe) {
+    TelemetryDeltaEncoder encoder(5s);
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+
+    encoder.writeMessage(data, "MSFS2024", buffer);
+    for (int64_t seq = 2; seq <= 3; seq++) {
+        encoder.writeMessage(data, "MSFS2024", buffer);
+        DeltaMessage delta = read(buffer);
+        EXPECT_EQ(delta.header["seq"], seq);
+        EXPECT_EQ(delta.header["keyframeSeq"], 1);
+    }
+
+    encoder.requestKeyframe();
+    encoder.writeMessage(data, "MSFS2024", buffer);
+    EXPECT_EQ(read(buffer).header["seq"], 4);
+
+    encoder.writeMessage(data, "MSFS2024", buffer);
+    DeltaMessage delta = read(buffer);
+    EXPECT_EQ(delta.header["seq"], 5);
+    EXPECT_EQ(delta.header["keyframeSeq"], 4);
+}
+
+TEST(TelemetryDeltaTests, SkipsChangesBelowTheFieldEpsilon) {
+    TelemetryDeltaEncoder encoder(5s);
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string buffer;
+    encoder.writeMessage(data, "MSFS2024", buffer);
+
+    // Unchanged: only the timestamp
+    encoder.writeMessage(data, "MSFS2024", buffer);
+    EXPECT_EQ(read(buffer).dataKeys, std::set<std::string>{ "timestamp" });
+
+    // Altitude epsilon is 0.5 ft, airspeed 0.1 kt, COM frequency 500 Hz
+    SimConnectFlightData moved = data;
+    moved.setNumber(simVarIndex("INDICATED ALTITUDE"), data.number(simVarIndex("INDICATED ALTITUDE")) + 0.4);
+    moved.setNumber(simVarIndex("AIRSPEED INDICATED"), data.number(simVarIndex("AIRSPEED INDICATED")) + 0.2);
+    moved.setNumber(simVarIndex("COM ACTIVE FREQUENCY:1"), 118705000.0);
+    encoder.writeMessage(moved, "MSFS2024", buffer);
+    EXPECT_EQ(read(buffer).dataKeys, (std::set<std::string>{ "airspeedIndicated", "com1Frequency", "timestamp" }));
+
+    // Deltas are against the keyframe, so small steps add up until they cross the epsilon
+    moved.setNumber(simVarIndex("INDICATED ALTITUDE"), data.number(simVarIndex("INDICATED ALTITUDE")) + 0.8);
+    encoder.writeMessage(moved, "MSFS2024", buffer);
+    EXPECT_TRUE(read(buffer).dataKeys.count("altitudeIndicated"));
+}
+
+TEST(TelemetryDeltaTests, CruiseDeltaIsAFractionOfTheKeyframe) {
+    TelemetryDeltaEncoder encoder(5s);
+    SimConnectFlightData data = makeSampleFlightData();
+    std::string keyframe;
+    std::string delta;
+
+    encoder.writeMessage(data, "MSFS2024", keyframe);
+    encoder.writeMessage(nextCruiseTick(data), "MSFS2024", delta);
+
+    // Eight moving fields plus the timestamp: 283 bytes against a 929-byte keyframe
+    EXPECT_EQ(read(delta).dataKeys.size(), 9u);
+    EXPECT_LT(delta.size() * 3, keyframe.size()) << delta.size() << " vs " << keyframe.size();
+}
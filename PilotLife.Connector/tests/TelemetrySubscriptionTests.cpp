@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include "SampleFlightData.h"
+#include "TelemetrySubscription.h"
+
+namespace {
+
+// Clients by channel; records what the publisher hands over instead of sending it
+class RecordingTelemetrySink : public TelemetrySink {
+public:
+    std::map<std::string, std::string> clientChannels;  // Client id -> channel
+
+    struct Published {
+        std::string channel;
+        Payload payload;
+        DeliveryPolicy policy;
+    };
+    std::vector<Published> published;
+
+    void publish(const std::string& channel, const Payload& payload, DeliveryPolicy policy, PayloadFormat) override {
+        published.push_back({ channel, payload, policy });
+    }
+
+    void getActiveTelemetryChannels(std::vector<std::string>& channels) const override {
+        channels.clear();
+        for (const auto& [client, channel] : clientChannels) {
+            if (std::find(channels.begin(), channels.end(), channel) == channels.end()) {
+                channels.push_back(channel);
+            }
+        }
+    }
+};
+
+TelemetrySubscription subscribe(const std::vector<std::string>& groups, int maxRateHz) {
+    std::string error;
+    auto subscription = TelemetrySubscription::fromRequest(groups, maxRateHz, error);
+    EXPECT_TRUE(subscription.has_value()) << error;
+    return subscription.value_or(TelemetrySubscription{});
+}
+
+} // namespace
+
+TEST(TelemetrySubscriptionTests, EqualSubscriptionsShareAChannel) {
+    std::string a = subscribe({ "position", "heading" }, 10).channelName();
+    std::string b = subscribe({ "heading", "position", "heading" }, 10).channelName();
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, "fields:a@10");
+
+    EXPECT_NE(subscribe({ "position", "heading" }, 5).channelName(), a);
+    EXPECT_NE(subscribe({ "position" }, 10).channelName(), a);
+}
+
+TEST(TelemetrySubscriptionTests, ChannelNamesRoundTrip) {
+    TelemetrySubscription subscription = subscribe({ "metadata", "radios" }, 0);
+    auto parsed = TelemetrySubscription::fromChannel(subscription.channelName());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->groups, subscription.groups);
+    EXPECT_EQ(parsed->maxRateHz, 0);
+
+    // Wire format channels and malformed names are not subscriptions
+    EXPECT_FALSE(TelemetrySubscription::fromChannel("json").has_value());
+    EXPECT_FALSE(TelemetrySubscription::fromChannel("fields:a").has_value());
+    EXPECT_FALSE(TelemetrySubscription::fromChannel("fields:zz@10").has_value());
+    EXPECT_FALSE(TelemetrySubscription::fromChannel("fields:a@-1").has_value());
+}
+
+TEST(TelemetrySubscriptionTests, RejectsUnknownGroupsAndRates) {
+    EXPECT_EQ(FlightDataEncoder::parseFieldGroup("position"), FIELD_GROUP_POSITION);
+    EXPECT_FALSE(FlightDataEncoder::parseFieldGroup("engines").has_value());
+    EXPECT_FALSE(FlightDataEncoder::parseFieldGroup("Position").has_value());
+    EXPECT_FALSE(FlightDataEncoder::parseFieldGroup("").has_value());
+
+    std::string error;
+    EXPECT_FALSE(TelemetrySubscription::fromRequest({ "position", "engines" }, 10, error).has_value());
+    EXPECT_EQ(error, "Unknown field group: engines");
+    EXPECT_FALSE(TelemetrySubscription::fromRequest({}, 10, error).has_value());
+    EXPECT_EQ(error, "No field groups given");
+    EXPECT_FALSE(TelemetrySubscription::fromRequest({ "position" }, -1, error).has_value());
+    EXPECT_EQ(error, "maxRate out of range");
+    EXPECT_FALSE(TelemetrySubscription::fromRequest({ "position" }, TelemetrySubscription::MAX_RATE_HZ + 1, error)
+                     .has_value());
+}
+
+TEST(TelemetrySubscriptionTests, SerializesOncePerChannel) {
+    RecordingTelemetrySink sink;
+    std::string position = subscribe({ "position" }, 0).channelName();
+    std::string radios = subscribe({ "radios" }, 0).channelName();
+    sink.clientChannels = {
+        { "a", position }, { "b", position }, { "c", position },
+        { "d", radios },
+        { "e", "json" }  // Published by the wire format encoders, not by subscriptions
+    };
+
+    TelemetrySubscriptionPublisher publisher;
+    publisher.publish(makeSampleFlightData(), "MSFS2024", sink);
+
+    ASSERT_EQ(sink.published.size(), 2u);
+    std::map<std::string, std::string> payloads;
+    for (const auto& published : sink.published) {
+        EXPECT_EQ(published.policy, DeliveryPolicy::LatestWins);
+        payloads[published.channel] = *published.payload;
+    }
+    ASSERT_EQ(payloads.count(position), 1u);
+    ASSERT_EQ(payloads.count(radios), 1u);
+
+    // Each channel gets only its groups
+    EXPECT_NE(payloads[position].find("\"latitude\""), std::string::npos);
+    EXPECT_EQ(payloads[position].find("\"com1Frequency\""), std::string::npos);
+    EXPECT_NE(payloads[radios].find("\"com1Frequency\""), std::string::npos);
+    EXPECT_EQ(payloads[radios].find("\"latitude\""), std::string::npos);
+}
+
+TEST(TelemetrySubscriptionTests, ThrottlesToTheMaximumRate) {
+    RecordingTelemetrySink sink;
+    std::string throttled = subscribe({ "position" }, 20).channelName();
+    std::string unthrottled = subscribe({ "position" }, 0).channelName();
+    sink.clientChannels = { { "a", throttled }, { "b", unthrottled } };
+
+    TelemetrySubscriptionPublisher publisher;
+    SimConnectFlightData data = makeSampleFlightData();
+    auto countFor = [&](const std::string& channel) {
+        return std::count_if(sink.published.begin(), sink.published.end(),
+                             [&](const auto& published) { return published.channel == channel; });
+    };
+
+    // Back-to-back samples: 20 Hz allows one per 50 ms
+    for (int i = 0; i < 5; i++) {
+        publisher.publish(data, "MSFS2024", sink);
+    }
+    EXPECT_EQ(countFor(throttled), 1);
+    EXPECT_EQ(countFor(unthrottled), 5);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    publisher.publish(data, "MSFS2024", sink);
+    EXPECT_EQ(countFor(throttled), 2);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "AircraftIndexer.h"
+#include "AllocationCounter.h"
+#include "SampleTitles.h"
+#include "TitleIndex.h"
+
+TEST(TitleIndexTests, NormalizesCaseAndSpaces) {
+    EXPECT_EQ(TitleIndex::normalize("Airbus  A320   Neo"), "airbus a320 neo");
+    EXPECT_EQ(TitleIndex::normalize("  Leading"), " leading");
+    EXPECT_EQ(TitleIndex::normalize("Caf\xc3\xa9 ATR"), "caf\xc3\xa9 atr");
+    EXPECT_EQ(TitleIndex::normalize(""), "");
+}
+
+TEST(TitleIndexTests, LaterInsertReplacesTheAircraft) {
+    std::vector<IndexedAircraft> records(2);
+    TitleIndex index;
+    index.insert("cessna 172", &records[0]);
+    index.insert("cessna 172", &records[1]);
+
+    EXPECT_EQ(index.size(), 1u);
+    EXPECT_EQ(index.find("Cessna  172"), &records[1]);
+    EXPECT_EQ(index.find("cessna 152"), nullptr);
+    EXPECT_EQ(TitleIndex().find("cessna 172"), nullptr);
+}
+
+TEST(TitleIndexTests, AgreesWithAMapForEveryHitAndMiss) {
+    SampleTitles sample = loadSampleTitles();
+    if (sample.titles.empty()) {
+        GTEST_SKIP() << "aircraft.csv not found";
+    }
+
+    std::vector<IndexedAircraft> records(sample.titles.size());
+    TitleIndex index;
+    std::map<std::string, const IndexedAircraft*> reference;
+    for (size_t i = 0; i < sample.titles.size(); i++) {
+        index.insert(TitleIndex::normalize(sample.titles[i]), &records[i]);
+        reference[TitleIndex::normalize(sample.titles[i])] = &records[i];
+    }
+    ASSERT_EQ(index.size(), reference.size());
+
+    for (size_t id = 0; id < index.size(); id++) {
+        EXPECT_EQ(index.find(index.key(id)), index.aircraft(id));
+    }
+    for (const auto& title : sample.titles) {
+        for (const std::string& query : { title, title + " x", "the " + title }) {
+            auto it = reference.find(TitleIndex::normalize(query));
+            EXPECT_EQ(index.find(query), it == reference.end() ? nullptr : it->second) << query;
+        }
+    }
+}
+
+TEST(TitleIndexTests, LookupsDoNotAllocate) {
+    std::vector<IndexedAircraft> records(1);
+    TitleIndex index;
+    index.insert("airbus a320 neo flybywire house livery", &records[0]);
+
+    uint64_t allocations = threadAllocationCount();
+    EXPECT_EQ(index.find("Airbus A320 Neo FlyByWire House Livery"), &records[0]);
+    EXPECT_EQ(index.find("Airbus A321 Neo"), nullptr);
+    EXPECT_EQ(threadAllocationCount() - allocations, 0u);
+}
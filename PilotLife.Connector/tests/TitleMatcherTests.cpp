@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "SampleTitles.h"
+#include "TitleIndex.h"
+#include "TitleMatcher.h"
+
+namespace {
+
+// The ways a requested title drifts from the installed one
+std::string withSuffix(const std::string& title) {
+    return title + " v2";
+}
+
+std::string withTypo(const std::string& title) {
+    // One letter of the longest word replaced
+    std::istringstream words(title);
+    std::string word;
+    std::string longest;
+    while (words >> word) {
+        if (word.size() > longest.size()) longest = word;
+    }
+    std::string result = title;
+    size_t at = title.find(longest) + longest.size() / 2;
+    result[at] = result[at] == 'x' ? 'q' : 'x';
+    return result;
+}
+
+std::string withFirstWordLast(const std::string& title) {
+    size_t space = title.find(' ');
+    return title.substr(space + 1) + " " + title.substr(0, space);
+}
+
+class TitleMatcherLabelledTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sample = loadSampleTitles();
+        if (sample.titles.empty()) {
+            GTEST_SKIP() << "aircraft.csv not found";
+        }
+        for (const auto& title : sample.titles) {
+            matcher.add(TitleIndex::normalize(title));
+        }
+    }
+
+    // Share of titles whose top match satisfies 'correct' for the query built from them
+    double accuracy(const std::function<std::string(size_t)>& query,
+                    const std::function<bool(size_t expected, uint32_t found)>& correct) const {
+        size_t hits = 0;
+        for (size_t i = 0; i < sample.titles.size(); i++) {
+            auto matches = matcher.find(TitleIndex::normalize(query(i)), 1, nullptr);
+            if (!matches.empty() && correct(i, matches[0].id)) {
+                hits++;
+            }
+        }
+        return static_cast<double>(hits) / static_cast<double>(sample.titles.size());
+    }
+
+    double accuracy(const std::function<std::string(const std::string&)>& drift) const {
+        return accuracy([&](size_t i) { return drift(sample.titles[i]); },
+                        [](size_t expected, uint32_t found) { return found == expected; });
+    }
+
+    SampleTitles sample;
+    TitleMatcher matcher;
+};
+
+} // namespace
+
+TEST(TitleMatcherTests, ExactTitleScoresOne) {
+    TitleMatcher matcher;
+    matcher.add("cessna 172 skyhawk");
+    matcher.add("cessna 152");
+
+    auto matches = matcher.find("cessna 172 skyhawk", 2, nullptr);
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].id, 0u);
+    EXPECT_DOUBLE_EQ(matches[0].score, 1.0);
+    EXPECT_LT(matches[1].score, 1.0);
+}
+
+TEST(TitleMatcherTests, IgnoresPunctuationAndCase) {
+    TitleMatcher matcher;
+    matcher.add("cessna 172 skyhawk");
+    auto matches = matcher.find("CESSNA-172   (Skyhawk)", 1, nullptr);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_DOUBLE_EQ(matches[0].score, 1.0);
+}
+
+TEST(TitleMatcherTests, TieBreakDecidesBetweenEqualScores) {
+    TitleMatcher matcher;
+    matcher.add("airbus a320 neo livery one");
+    matcher.add("airbus a320 neo livery two");
+
+    EXPECT_EQ(matcher.find("airbus a320 neo", 1, nullptr)[0].id, 0u);
+    auto preferSecond = [](uint32_t id) { return id == 1 ? 1 : 0; };
+    EXPECT_EQ(matcher.find("airbus a320 neo", 1, preferSecond)[0].id, 1u);
+}
+
+TEST(TitleMatcherTests, NothingInCommonFindsNothing) {
+    TitleMatcher matcher;
+    matcher.add("boeing 747");
+    EXPECT_TRUE(matcher.find("zzz", 5, nullptr).empty());
+    EXPECT_TRUE(matcher.find("", 5, nullptr).empty());
+    EXPECT_TRUE(TitleMatcher().find("boeing 747", 5, nullptr).empty());
+}
+
+TEST_F(TitleMatcherLabelledTest, SuffixAdded) {
+    EXPECT_EQ(accuracy(withSuffix), 1.0);
+}
+
+TEST_F(TitleMatcherLabelledTest, LiveryDropped) {
+    // Any livery of the right aircraft is a correct answer
+    double result = accuracy([&](size_t i) { return sample.bases[sample.baseOf[i]]; },
+                             [&](size_t expected, uint32_t found) { return sample.baseOf[found] == sample.baseOf[expected]; });
+    EXPECT_EQ(result, 1.0);
+}
+
+TEST_F(TitleMatcherLabelledTest, OneTypo) {
+    EXPECT_EQ(accuracy(withTypo), 1.0);
+}
+
+TEST_F(TitleMatcherLabelledTest, WordsReordered) {
+    EXPECT_EQ(accuracy(withFirstWordLast), 1.0);
+}
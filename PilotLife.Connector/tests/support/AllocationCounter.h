@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocations made so far by the calling thread. Linking AllocationCounter.cpp
+// replaces the global operator new, so tests and benchmarks can check that a code
+// path does not allocate by comparing two readings.
+uint64_t threadAllocationCount();
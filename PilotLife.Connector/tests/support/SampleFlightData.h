@@ -0,0 +1,41 @@
+#pragma once
+
+#include "FlightData.h"
+
+// A cruising airliner with every SimVar set, for tests and benchmarks that need
+// realistic telemetry without a simulator
+inline SimConnectFlightData makeSampleFlightData() {
+    SimConnectFlightData data{};
+    data.setText(simVarIndex("TITLE"), "Airbus A320 Neo FlyByWire \"House\" Livery");
+    data.setText(simVarIndex("ATC TYPE"), "AIRBUS");
+    data.setText(simVarIndex("ATC MODEL"), "A20N");
+    data.setText(simVarIndex("ATC ID"), "N320FB");
+    data.setText(simVarIndex("ATC AIRLINE"), "FlyByWire");
+    data.setText(simVarIndex("ATC FLIGHT NUMBER"), "320");
+    data.setText(simVarIndex("CATEGORY"), "Airplane");
+    data.setNumber(simVarIndex("ENGINE TYPE"), 1);
+    data.setNumber(simVarIndex("NUMBER OF ENGINES"), 2);
+    data.setNumber(simVarIndex("MAX GROSS WEIGHT"), 174165.0);
+    data.setNumber(simVarIndex("DESIGN CRUISE ALT"), 447.0);
+    data.setNumber(simVarIndex("EMPTY WEIGHT"), 90389.0);
+    data.setNumber(simVarIndex("PLANE LATITUDE"), 47.4502497);
+    data.setNumber(simVarIndex("PLANE LONGITUDE"), -122.3088165);
+    data.setNumber(simVarIndex("INDICATED ALTITUDE"), 35012.4);
+    data.setNumber(simVarIndex("PLANE ALTITUDE"), 35120.8);
+    data.setNumber(simVarIndex("PLANE ALT ABOVE GROUND"), 34710.2);
+    data.setNumber(simVarIndex("AIRSPEED INDICATED"), 271.3);
+    data.setNumber(simVarIndex("AIRSPEED TRUE"), 447.9);
+    data.setNumber(simVarIndex("GROUND VELOCITY"), 462.1);
+    data.setNumber(simVarIndex("AIRSPEED MACH"), 0.781);
+    data.setNumber(simVarIndex("HEADING INDICATOR"), 92.4);
+    data.setNumber(simVarIndex("PLANE HEADING DEGREES TRUE"), 107.9);
+    data.setNumber(simVarIndex("GPS GROUND TRUE TRACK"), 108.6);
+    data.setNumber(simVarIndex("FUEL TOTAL QUANTITY"), 4200.0);
+    data.setNumber(simVarIndex("FUEL WEIGHT PER GALLON"), 6.7);
+    data.setNumber(simVarIndex("TOTAL WEIGHT"), 141529.0);
+    data.setNumber(simVarIndex("COM ACTIVE FREQUENCY:1"), 118700000.0);
+    data.setNumber(simVarIndex("COM ACTIVE FREQUENCY:2"), 121500000.0);
+    data.setNumber(simVarIndex("NAV ACTIVE FREQUENCY:1"), 110300000.0);
+    data.setNumber(simVarIndex("NAV ACTIVE FREQUENCY:2"), 113800000.0);
+    return data;
+}
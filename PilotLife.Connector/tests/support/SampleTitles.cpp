@@ -0,0 +1,87 @@
+#include "SampleTitles.h"
+#include <fstream>
+
+// Fields of one CSV line (double-quoted fields may contain commas)
+static std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (char c : line) {
+        if (c == '"') {
+            quoted = !quoted;
+        } else if (c == ',' && !quoted) {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+// "L2J" -> "Twin Jet Landplane"
+static std::string describeType(const std::string& type) {
+    if (type.size() != 3) {
+        return "Aircraft";
+    }
+
+    std::string engines;
+    switch (type[1]) {
+        case '1': engines = "Single"; break;
+        case '2': engines = "Twin"; break;
+        case '3': engines = "Three Engine"; break;
+        case '4': engines = "Four Engine"; break;
+        default: engines = std::string(1, type[1]) + " Engine"; break;
+    }
+
+    std::string kind;
+    switch (type[2]) {
+        case 'J': kind = "Jet"; break;
+        case 'T': kind = "Turboprop"; break;
+        case 'P': kind = "Piston"; break;
+        case 'E': kind = "Electric"; break;
+        default: kind = "Engine"; break;
+    }
+
+    std::string category;
+    switch (type[0]) {
+        case 'L': category = "Landplane"; break;
+        case 'H': category = "Helicopter"; break;
+        case 'A': category = "Amphibian"; break;
+        case 'S': category = "Seaplane"; break;
+        default: category = "Aircraft"; break;
+    }
+    return engines + " " + kind + " " + category;
+}
+
+SampleTitles loadSampleTitles() {
+    static const char* const LIVERIES[SampleTitles::LIVERIES_PER_BASE] = {
+        "House Livery", "Delta Air Lines", "Lufthansa Retro", "Air New Zealand", "Private N172SP",
+    };
+
+    SampleTitles result;
+    std::ifstream file(PILOTLIFE_AIRCRAFT_CSV);
+    std::string line;
+    if (!std::getline(file, line)) {
+        return result;
+    }
+
+    std::vector<std::string> header = splitCsvLine(line);
+    size_t icaoColumn = 0;
+    size_t typeColumn = 0;
+    for (size_t i = 0; i < header.size(); i++) {
+        if (header[i] == "icao") icaoColumn = i;
+        if (header[i] == "type") typeColumn = i;
+    }
+
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields = splitCsvLine(line);
+        if (fields.size() <= std::max(icaoColumn, typeColumn) || fields[icaoColumn].empty()) {
+            continue;
+        }
+        result.bases.push_back(fields[icaoColumn] + " " + describeType(fields[typeColumn]));
+        for (const char* livery : LIVERIES) {
+            result.titles.push_back(result.bases.back() + " " + livery);
+            result.baseOf.push_back(result.bases.size() - 1);
+        }
+    }
+    return result;
+}
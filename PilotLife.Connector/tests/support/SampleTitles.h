@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Realistic aircraft titles for matching tests and benchmarks, built from the ICAO
+// type list in aircraft.csv at the repository root. Its name columns are empty, so
+// each type becomes "<ICAO> <engine count> <engine kind> <class>", e.g.
+// "A320 Twin Jet Landplane", and is installed with five liveries.
+struct SampleTitles {
+    std::vector<std::string> bases;     // One per ICAO type
+    std::vector<std::string> titles;    // "<base> <livery>", LIVERIES_PER_BASE per base
+    std::vector<size_t> baseOf;         // Index into bases for each title
+
+    static constexpr size_t LIVERIES_PER_BASE = 5;
+};
+
+// Empty if aircraft.csv cannot be read
+SampleTitles loadSampleTitles();
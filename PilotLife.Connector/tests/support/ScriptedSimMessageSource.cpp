@@ -0,0 +1,139 @@
+#include "ScriptedSimMessageSource.h"
+#include "AllocationCounter.h"
+
+// Recording a rate must not allocate on the dispatch thread, or the allocation
+// checks would measure the double instead of the manager
+constexpr size_t MAX_RECORDED_RATE_REQUESTS = 4096;
+
+ScriptedSimMessageSource::ScriptedSimMessageSource() {
+    m_rateRequests.reserve(MAX_RECORDED_RATE_REQUESTS);
+}
+
+void ScriptedSimMessageSource::pushOpen(const std::string& applicationName) {
+    ScriptedMessage scripted;
+    scripted.message.type = SimMessageType::Open;
+    scripted.applicationName = applicationName;
+    push(std::move(scripted));
+}
+
+void ScriptedSimMessageSource::pushQuit() {
+    ScriptedMessage scripted;
+    scripted.message.type = SimMessageType::Quit;
+    push(std::move(scripted));
+}
+
+void ScriptedSimMessageSource::pushData(uint32_t requestId, const void* data, size_t size) {
+    ScriptedMessage scripted;
+    scripted.message.type = SimMessageType::SimObjectData;
+    scripted.message.requestId = requestId;
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    scripted.data.assign(bytes, bytes + size);
+    push(std::move(scripted));
+}
+
+void ScriptedSimMessageSource::pushException(uint32_t exception) {
+    ScriptedMessage scripted;
+    scripted.message.type = SimMessageType::Exception;
+    scripted.message.exception = exception;
+    push(std::move(scripted));
+}
+
+void ScriptedSimMessageSource::pushBlock(uint32_t requestId, const SimConnectFlightData& snapshot) {
+    const SimVarBlock& block = SIM_VAR_BLOCKS[requestId];
+    pushData(requestId, snapshot.bytes + block.offset, block.size);
+}
+
+void ScriptedSimMessageSource::failWaits() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_failWaits = true;
+    }
+    m_signal.notify_one();
+}
+
+void ScriptedSimMessageSource::push(ScriptedMessage message) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(message));
+    }
+    m_signal.notify_one();
+}
+
+std::vector<TelemetryRate> ScriptedSimMessageSource::rateRequests() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rateRequests;
+}
+
+uint64_t ScriptedSimMessageSource::wakeups() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_wakeups;
+}
+
+uint64_t ScriptedSimMessageSource::timeouts() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_timeouts;
+}
+
+uint64_t ScriptedSimMessageSource::failures() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failures;
+}
+
+uint64_t ScriptedSimMessageSource::dispatchThreadAllocations() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dispatchThreadAllocations;
+}
+
+size_t ScriptedSimMessageSource::backlog() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+SimWaitResult ScriptedSimMessageSource::waitForMessages(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool signalled = m_signal.wait_for(lock, timeout,
+        [this] { return m_woken || m_failWaits || !m_queue.empty(); });
+    m_woken = false;
+    if (m_failWaits) {
+        m_failures++;
+        return SimWaitResult::Failed;
+    }
+    if (!signalled) {
+        m_timeouts++;
+        return SimWaitResult::Timeout;
+    }
+    m_wakeups++;
+    return SimWaitResult::Messages;
+}
+
+bool ScriptedSimMessageSource::nextMessage(SimMessage* message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_queue.empty()) {
+        return false;
+    }
+
+    m_current = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    *message = m_current.message;
+    message->applicationName = m_current.applicationName.c_str();
+    message->data = m_current.data.data();
+    message->size = m_current.data.size();
+    return true;
+}
+
+void ScriptedSimMessageSource::requestTelemetryRate(TelemetryRate rate) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_rateRequests.size() < MAX_RECORDED_RATE_REQUESTS) {
+        m_rateRequests.push_back(rate);
+    }
+    m_dispatchThreadAllocations = threadAllocationCount();
+}
+
+void ScriptedSimMessageSource::wake() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_woken = true;
+    }
+    m_signal.notify_one();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "FlightData.h"
+#include "SimMessageSource.h"
+
+// Stand-in for a SimConnect connection: messages are queued by the test and
+// handed to the dispatch loop the way SimConnect_GetNextDispatch would, and
+// rate requests are recorded instead of sent.
+class ScriptedSimMessageSource : public SimMessageSource {
+public:
+    ScriptedSimMessageSource();
+
+    // Queue messages and signal the waiting dispatch thread
+    void pushOpen(const std::string& applicationName);
+    void pushQuit();
+    void pushData(uint32_t requestId, const void* data, size_t size);
+    void pushException(uint32_t exception);
+
+    // Queue the data block one request returns, cut from a full snapshot
+    void pushBlock(uint32_t requestId, const SimConnectFlightData& snapshot);
+
+    // Make every later waitForMessages() fail, as a broken event handle would
+    void failWaits();
+
+    // Telemetry rates requested so far, oldest first
+    std::vector<TelemetryRate> rateRequests() const;
+
+    // Number of waitForMessages() calls that reported messages / timed out / failed
+    uint64_t wakeups() const;
+    uint64_t timeouts() const;
+    uint64_t failures() const;
+
+    // Heap allocations the dispatch thread had made when it last requested a rate
+    uint64_t dispatchThreadAllocations() const;
+
+    // Messages queued but not yet fetched by the dispatch loop
+    size_t backlog() const;
+
+    SimWaitResult waitForMessages(std::chrono::milliseconds timeout) override;
+    bool nextMessage(SimMessage* message) override;
+    void requestTelemetryRate(TelemetryRate rate) override;
+    void wake() override;
+
+private:
+    struct ScriptedMessage {
+        SimMessage message;
+        std::string applicationName;
+        std::vector<unsigned char> data;
+    };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_signal;
+    bool m_woken = false;
+    bool m_failWaits = false;
+    std::deque<ScriptedMessage> m_queue;
+    ScriptedMessage m_current;  // Backs the SimMessage last returned by nextMessage()
+
+    std::vector<TelemetryRate> m_rateRequests;
+    uint64_t m_wakeups = 0;
+    uint64_t m_timeouts = 0;
+    uint64_t m_failures = 0;
+    uint64_t m_dispatchThreadAllocations = 0;
+
+    void push(ScriptedMessage message);
+};
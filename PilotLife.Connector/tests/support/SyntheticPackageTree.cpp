@@ -0,0 +1,118 @@
+#include "SyntheticPackageTree.h"
+#include <fstream>
+#include <random>
+#include <sstream>
+
+static std::string packageName(size_t package) {
+    return "synthetic-aircraft-" + std::to_string(package);
+}
+
+static std::string folderName(size_t package) {
+    return "Synthetic_" + std::to_string(package);
+}
+
+SyntheticPackageTree::SyntheticPackageTree(const SyntheticTreeOptions& options) : m_options(options) {
+    std::random_device random;
+    m_root = std::filesystem::temp_directory_path() / ("pilotlife-tree-" + std::to_string(random()));
+    std::filesystem::create_directories(m_root / "Community");
+    std::filesystem::create_directories(m_root / "cache");
+    for (size_t package = 0; package < m_options.packages; package++) {
+        writePackage(package);
+    }
+}
+
+SyntheticPackageTree::~SyntheticPackageTree() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_root, ec);
+}
+
+std::filesystem::path SyntheticPackageTree::packagePath(size_t package) const {
+    return m_root / "Community" / packageName(package);
+}
+
+std::filesystem::path SyntheticPackageTree::cfgPath(size_t package) const {
+    return packagePath(package) / "SimObjects" / "Airplanes" / folderName(package) / "aircraft.cfg";
+}
+
+std::string SyntheticPackageTree::title(size_t package, size_t variation) const {
+    if (m_options.sharedTitleEvery && package > 0 && package % m_options.sharedTitleEvery == 0 && variation == 0) {
+        return title(0, 0);
+    }
+    return "Synthetic Jet " + std::to_string(package) + " Livery " + std::to_string(variation);
+}
+
+std::vector<std::string> SyntheticPackageTree::titles() const {
+    std::vector<std::string> result;
+    for (size_t package = 0; package < m_options.packages; package++) {
+        for (size_t variation = 0; variation < m_options.variationsPerPackage; variation++) {
+            if (package == 0 || title(package, variation) != title(0, 0)) {
+                result.push_back(title(package, variation));
+            }
+        }
+    }
+    return result;
+}
+
+void SyntheticPackageTree::writePackage(size_t package, size_t revision, bool renamed) {
+    bool livery = m_options.liveryEvery && package > 0 && package % m_options.liveryEvery == 0;
+    std::filesystem::create_directories(cfgPath(package).parent_path());
+
+    std::ostringstream manifest;
+    manifest << "{\n"
+             << "  \"dependencies\": [],\n"
+             << "  \"content_type\": \"" << (livery ? "LIVERY" : "AIRCRAFT") << "\",\n"
+             << "  \"title\": \"Synthetic Package " << package << "\",\n"
+             << "  \"manufacturer\": \"PilotLife\",\n"
+             << "  \"creator\": \"PilotLife Tests\",\n"
+             << "  \"package_version\": \"1.0." << revision << "\",\n"
+             << "  \"minimum_game_version\": \"1.37.19\",\n"
+             << "  \"release_notes\": { \"neutral\": { \"LastUpdate\": \"\", \"OlderHistory\": \"\" } },\n"
+             << "  \"total_package_size\": \"00000000000001048576\",\n"
+             << "  \"content_id\": \"" << packageName(package) << "\"\n"
+             << "}\n";
+
+    std::ostringstream cfg;
+    cfg << "; Revision " << revision << "\n";
+    if (livery) {
+        cfg << "[VARIATION]\nbase_container = \"..\\" << folderName(package - 1) << "\"\n\n";
+    } else {
+        cfg << "[VERSION]\nmajor = 1\nminor = 0\n\n"
+            << "[GENERAL]\natc_type = \"SYNTHETIC\"\natc_model = \"SY" << package % 100 << "\"\n"
+            << "editable = 1\nperformance = \"Cruise 450 kts\"\ncategory = \"airplane\"\n\n";
+    }
+    for (size_t variation = 0; variation < m_options.variationsPerPackage; variation++) {
+        cfg << "[FLTSIM." << variation << "]\n"
+            << "title = \"" << title(package, variation) << (renamed ? " Renamed" : "") << "\"\n"
+            << "texture = \"livery" << variation << "\"\n"
+            << "atc_id = \"N" << package << "SY" << variation << "\"\n"
+            << "atc_airline = \"Synthetic Air\"\n"
+            << "ui_variation = \"Livery " << variation << "\"\n"
+            << "icao_airline = \"SYN\"\n";
+        if (!livery) {
+            cfg << "model = \"\"\npanel = \"\"\nsound = \"\"\n"
+                << "ui_manufacturer = \"PilotLife\"\nui_type = \"Synthetic Jet\"\n";
+        }
+        cfg << "\n";
+    }
+    for (size_t written = 0; written < m_options.cfgPaddingBytes; written += 64) {
+        cfg << "; ------------------------------------------------------------ \n";
+    }
+
+    writeFile(packagePath(package) / "manifest.json", manifest.str());
+    writeFile(cfgPath(package), cfg.str());
+}
+
+void SyntheticPackageTree::writeFile(const std::filesystem::path& filePath, const std::string& content) const {
+    // Binary, so line endings are exactly what the options ask for on every platform
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    for (char c : content) {
+        if (c == '\n' && m_options.crlf) {
+            file << '\r';
+        }
+        file << c;
+    }
+}
+
+void SyntheticPackageTree::removePackage(size_t package) {
+    std::filesystem::remove_all(packagePath(package));
+}
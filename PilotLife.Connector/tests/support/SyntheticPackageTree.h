@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Shape of a generated Community folder
+struct SyntheticTreeOptions {
+    size_t packages = 600;
+    size_t variationsPerPackage = 8;    // [FLTSIM.x] sections per aircraft.cfg
+    size_t cfgPaddingBytes = 0;         // Comment lines appended to each aircraft.cfg (real ones run to tens of KB)
+    size_t liveryEvery = 0;             // Every Nth package is a livery of the package before it (0 = none)
+    size_t sharedTitleEvery = 0;        // Every Nth package repeats package 0's first title (0 = none)
+    bool crlf = false;                  // Windows line endings, as shipped by most packages
+};
+
+// A throwaway Community folder of aircraft packages (manifest.json plus
+// SimObjects/Airplanes/<folder>/aircraft.cfg) in the system temp directory,
+// for tests and benchmarks of AircraftIndexer. Removed again on destruction.
+class SyntheticPackageTree {
+public:
+    explicit SyntheticPackageTree(const SyntheticTreeOptions& options = {});
+    ~SyntheticPackageTree();
+
+    SyntheticPackageTree(const SyntheticPackageTree&) = delete;
+    SyntheticPackageTree& operator=(const SyntheticPackageTree&) = delete;
+
+    // The folder to index (a search path)
+    std::string communityPath() const { return (m_root / "Community").string(); }
+
+    // An empty folder next to it for the index cache
+    std::string cacheDirectory() const { return (m_root / "cache").string(); }
+
+    std::filesystem::path packagePath(size_t package) const;
+    std::filesystem::path cfgPath(size_t package) const;
+
+    // Title of one [FLTSIM.x] section as written
+    std::string title(size_t package, size_t variation) const;
+
+    // Every distinct title written, in package order
+    std::vector<std::string> titles() const;
+
+    // (Re)write a package's manifest.json and aircraft.cfg; 'revision' changes the cfg
+    // contents (and so its size) without changing the titles unless renamed is set
+    void writePackage(size_t package, size_t revision = 0, bool renamed = false);
+
+    void removePackage(size_t package);
+
+    const SyntheticTreeOptions& options() const { return m_options; }
+
+private:
+    void writeFile(const std::filesystem::path& filePath, const std::string& content) const;
+
+    SyntheticTreeOptions m_options;
+    std::filesystem::path m_root;
+};
@@ -90,8 +90,17 @@ export interface AircraftFileData {
         editable: string;
         performance: string;
         category: string;
+        // [VARIATION] base_container of a livery, and where the aircraft.cfg lives (e.g. "Rotorcraft/Asobo_H135")
+        baseContainer: string;
+        simObject: string;
         rawContent: string;
     };
+    // How the title was matched; candidates are the closest indexed titles when it was not exact
+    match?: {
+        exact: boolean;
+        confidence: number;
+        candidates: { title: string; confidence: number }[];
+    };
 }
 
 export interface MSFSPathsInfo {
@@ -101,10 +110,22 @@ export interface MSFSPathsInfo {
     searchPaths: string[];
 }
 
+export interface AircraftIndexUpdate {
+    indexedAircraftCount: number;
+    added: string[];
+    removed: string[];
+    updated: string[];
+}
+
+export type TelemetryRate = 'idle' | 'cruise' | 'simFrame' | 'visualFrame';
+
+export type TelemetryFieldGroup = 'metadata' | 'position' | 'speed' | 'heading' | 'weight' | 'radios';
+
 type FlightDataHandler = (data: FlightData) => void;
 type StatusHandler = (status: SimulatorStatus) => void;
 type ConnectionHandler = (connected: boolean) => void;
 type MSFSPathsHandler = (paths: MSFSPathsInfo) => void;
+type AircraftIndexUpdateHandler = (update: AircraftIndexUpdate) => void;
 
 type AircraftDataResponseHandler = (data: AircraftFileData) => void;
 
@@ -115,6 +136,7 @@ class ConnectorService {
     private statusHandlers: StatusHandler[] = [];
     private connectionHandlers: ConnectionHandler[] = [];
     private msfsPathsHandlers: MSFSPathsHandler[] = [];
+    private aircraftIndexUpdateHandlers: AircraftIndexUpdateHandler[] = [];
     private reconnectTimeout: ReturnType<typeof setTimeout> | null = null;
     private isStarted = false;
     private pendingAircraftDataRequests: Map<string, AircraftDataResponseHandler> = new Map();
@@ -217,6 +239,18 @@ class ConnectorService {
         };
     }
 
+    /**
+     * Subscribe to live aircraft index changes (packages installed, updated or removed)
+     * @returns Unsubscribe function
+     */
+    onAircraftIndexUpdated(handler: AircraftIndexUpdateHandler): () => void {
+        this.aircraftIndexUpdateHandlers.push(handler);
+        return () => {
+            const idx = this.aircraftIndexUpdateHandlers.indexOf(handler);
+            if (idx > -1) this.aircraftIndexUpdateHandlers.splice(idx, 1);
+        };
+    }
+
     /**
      * Subscribe to MSFS paths info updates
      * @returns Unsubscribe function
@@ -274,6 +308,46 @@ class ConnectorService {
         });
     }
 
+    /**
+     * Change how often the connector requests flight data from the simulator
+     * @param rate 'idle' (5 s), 'cruise' (1 Hz), 'simFrame' or 'visualFrame'
+     */
+    setTelemetryRate(rate: TelemetryRate): void {
+        if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
+            console.warn('Cannot set telemetry rate: WebSocket not connected');
+            return;
+        }
+
+        const request = {
+            type: 'setTelemetryRate',
+            requestId: crypto.randomUUID(),
+            rate
+        };
+
+        this.ws.send(JSON.stringify(request));
+    }
+
+    /**
+     * Receive only the given field groups in flightData messages
+     * @param groups Field groups to include
+     * @param maxRate Maximum messages per second (0 = every sample)
+     */
+    subscribeTelemetry(groups: TelemetryFieldGroup[], maxRate = 0): void {
+        if (!this.ws || this.ws.readyState !== WebSocket.OPEN) {
+            console.warn('Cannot subscribe to telemetry: WebSocket not connected');
+            return;
+        }
+
+        const request = {
+            type: 'subscribeTelemetry',
+            requestId: crypto.randomUUID(),
+            groups,
+            maxRate
+        };
+
+        this.ws.send(JSON.stringify(request));
+    }
+
     private notifyConnectionStatus(connected: boolean): void {
         this.connectionHandlers.forEach(h => h(connected));
     }
@@ -318,6 +392,20 @@ class ConnectorService {
                     };
                     this.currentMSFSPaths = pathsInfo;
                     this.msfsPathsHandlers.forEach(h => h(pathsInfo));
+                } else if (message.type === 'aircraftIndexUpdated') {
+                    const update: AircraftIndexUpdate = {
+                        indexedAircraftCount: message.data?.indexedAircraftCount || 0,
+                        added: message.data?.added || [],
+                        removed: message.data?.removed || [],
+                        updated: message.data?.updated || []
+                    };
+                    if (this.currentMSFSPaths) {
+                        this.currentMSFSPaths = { ...this.currentMSFSPaths, indexedAircraftCount: update.indexedAircraftCount };
+                    }
+                    this.aircraftIndexUpdateHandlers.forEach(h => h(update));
+                } else if (message.type === 'errorResponse') {
+                    // The connector could not run a request (malformed, unknown type or bad fields)
+                    console.warn(`Connector rejected ${message.data?.command || 'request'}: ${message.data?.error}`);
                 } else if (message.type === 'aircraftDataResponse') {
                     // Handle aircraft file data response
                     const requestId = message.requestId as string;
@@ -358,7 +446,14 @@ class ConnectorService {
                                 editable: message.data.config.editable || '',
                                 performance: message.data.config.performance || '',
                                 category: message.data.config.category || '',
+                                baseContainer: message.data.config.baseContainer || '',
+                                simObject: message.data.config.simObject || '',
                                 rawContent: message.data.config.raw || ''
+                            } : undefined,
+                            match: message.match ? {
+                                exact: message.match.exact ?? false,
+                                confidence: message.match.confidence ?? 0,
+                                candidates: message.match.candidates || []
                             } : undefined
                         };
                         handler(data);